@@ -0,0 +1,10 @@
+# Workload distribution for --experiment
+# Values: 7 (constant), 2..9 (uniform, inclusive) or exp:10 (exponential, mean 10)
+
+processes = 5..20        # Processes per workload
+interarrival = exp:20    # Ticks between consecutive arrivals
+priority = 1..10
+bursts = 1..4            # CALC bursts per process
+calc = exp:10            # CALC burst length
+io = 1..10               # I/O between bursts
+io_probability = 0.7     # Chance of an I/O between two CALC bursts
@@ -1,4 +1,5 @@
 #include "basic_sched.h"
+#include "sim_metrics.h"
 
 void add_tail(process_queue* p, process_t process) {
     node_t *tmp = malloc(sizeof(node_t));
@@ -29,8 +30,219 @@ void remove_head(process_queue *p) {
     free(tmp);
 }
 void append_descriptor(process_descriptor_t **descriptor, process_descriptor_t unit_descriptor, int *size){
-  *descriptor = realloc(*descriptor, (*size +1)*sizeof(process_descriptor_t));
+  // Capacity 16, doubled whenever size reaches a power of two (arrays only grow through here)
+  if (*size == 0 || (*size >= 16 && (*size & (*size - 1)) == 0)) {
+    int capacity = *size ? *size * 2 : 16;
+    *descriptor = realloc(*descriptor, capacity * sizeof(process_descriptor_t));
+  }
   (*descriptor)[*size] = unit_descriptor ;
   (*size)++;
 
 }
+
+void sim_emit(sim_run_t *run, process_descriptor_t **descriptor, int *size, process_descriptor_t record) {
+    if (run) {
+        int transition = run->metrics ? sim_metrics_record(run->metrics, &record) : 1;
+        if (run->trace_level == trace_none) return;
+        if (run->trace_level == trace_transitions && !transition) return;
+    }
+    if (run && run->sink) {
+        if (!run->cancelled && !run->sink(run->sink_ctx, &record)) run->cancelled = 1;
+        return;
+    }
+    append_descriptor(descriptor, record, size);
+}
+
+void sim_run_init(sim_run_t *run, sim_time_t horizon) {
+    run->horizon = horizon;
+    run->sink = NULL;
+    run->sink_ctx = NULL;
+    run->trace_level = trace_full;
+    run->metrics = NULL;
+    run->resume = NULL;
+    run->checkpoint = NULL;
+    run->cancelled = 0;
+    run->status = sim_completed;
+    run->end_time = 0;
+    run->finished = 0;
+    run->total = 0;
+}
+
+typedef struct arrival_key_t {
+    sim_time_t arrival;
+    int idx;
+} arrival_key_t;
+
+static int compare_arrival(const void *a, const void *b) {
+    const arrival_key_t *ka = a;
+    const arrival_key_t *kb = b;
+    if (ka->arrival != kb->arrival) return (ka->arrival < kb->arrival) ? -1 : 1;
+    return ka->idx - kb->idx;
+}
+
+int sim_active_init(sim_active_t *set, const process_queue *queue) {
+    int n = queue->size;
+    int cap = (n > 0) ? n : 1;
+    set->n = n;
+    set->procs = malloc(cap * sizeof(const process_t *));
+    set->arrivals = malloc(cap * sizeof(int));
+    set->active = malloc(cap * sizeof(int));
+    set->active_pos = malloc(cap * sizeof(int));
+    set->completed = malloc(cap * sizeof(int));
+    set->io_next = malloc(cap * sizeof(int));
+    arrival_key_t *keys = malloc(cap * sizeof(arrival_key_t));
+    if (!set->procs || !set->arrivals || !set->active || !set->active_pos ||
+        !set->completed || !set->io_next || !keys) {
+        free(keys);
+        sim_active_free(set);
+        return 0;
+    }
+
+    int idx = 0;
+    for (const node_t *node = queue->head; node != NULL; node = node->next, idx++) {
+        set->procs[idx] = &node->proc;
+        keys[idx].arrival = node->proc.arrival_time_p;
+        keys[idx].idx = idx;
+        set->io_next[idx] = -1;
+    }
+    qsort(keys, n, sizeof(arrival_key_t), compare_arrival);
+    for (int k = 0; k < n; k++) set->arrivals[k] = keys[k].idx;
+    free(keys);
+
+    set->next_arrival = 0;
+    set->count = 0;
+    set->completed_count = 0;
+    set->finished = 0;
+    set->io_head = set->io_tail = -1;
+    return 1;
+}
+
+void sim_active_free(sim_active_t *set) {
+    free(set->procs);
+    free(set->arrivals);
+    free(set->active);
+    free(set->active_pos);
+    free(set->completed);
+    free(set->io_next);
+    set->procs = NULL;
+    set->arrivals = set->active = set->active_pos = set->completed = set->io_next = NULL;
+}
+
+int sim_active_admit(sim_active_t *set, sim_time_t now) {
+    if (set->next_arrival >= set->n) return -1;
+    int idx = set->arrivals[set->next_arrival];
+    if (set->procs[idx]->arrival_time_p > now) return -1;
+    set->next_arrival++;
+    set->active_pos[idx] = set->count;
+    set->active[set->count++] = idx;
+    return idx;
+}
+
+void sim_active_io_push(sim_active_t *set, int idx) {
+    set->io_next[idx] = -1;
+    if (set->io_tail >= 0) set->io_next[set->io_tail] = idx;
+    else set->io_head = idx;
+    set->io_tail = idx;
+}
+
+int sim_active_io_pop(sim_active_t *set) {
+    int idx = set->io_head;
+    set->io_head = set->io_next[idx];
+    if (set->io_head < 0) set->io_tail = -1;
+    return idx;
+}
+
+sim_op_result_t sim_active_run_op(sim_active_t *set, sim_run_t *run, process_descriptor_t **descriptor,
+                                  int *size, int idx, process_operation_t op, int *op_idx,
+                                  sim_time_t *op_remaining, sim_time_t now) {
+    const process_t *proc = set->procs[idx];
+    process_descriptor_t entry;
+    entry.process_name = proc->process_name;
+    entry.date = now;
+    entry.state = running_p;
+    entry.operation = op;
+    sim_emit(run, descriptor, size, entry);
+
+    if (--*op_remaining > 0) return sim_op_continues;
+    (*op_idx)++;
+    if (*op_idx < proc->operations_count) {
+        *op_remaining = proc->descriptor_p[*op_idx].duration_op;
+        return sim_op_next;
+    }
+    set->completed[set->completed_count++] = idx;
+    return sim_op_last;
+}
+
+int sim_active_end_tick(sim_active_t *set, sim_run_t *run, process_descriptor_t **descriptor,
+                        int *size, int cpu, int io, sim_time_t *now, sim_status_t *status) {
+    // Mark other processes as waiting
+    for (int k = 0; k < set->count; k++) {
+        int idx = set->active[k];
+        if (idx == cpu || idx == io) continue;
+
+        process_descriptor_t entry;
+        entry.process_name = set->procs[idx]->process_name;
+        entry.date = *now;
+        entry.state = waiting_p;
+        entry.operation = none;
+        sim_emit(run, descriptor, size, entry);
+    }
+
+    // Terminate processes that completed their last operation
+    int terminated_now = set->completed_count;
+    for (int k = 0; k < set->completed_count; k++) {
+        int idx = set->completed[k];
+        int last = set->active[--set->count];
+        set->active[set->active_pos[idx]] = last;
+        set->active_pos[last] = set->active_pos[idx];
+        set->finished++;
+
+        process_descriptor_t entry;
+        entry.process_name = set->procs[idx]->process_name;
+        entry.date = *now + 1;
+        entry.state = terminated_p;
+        entry.operation = none;
+        sim_emit(run, descriptor, size, entry);
+    }
+    set->completed_count = 0;
+
+    // Nothing ran or terminated: skip idle gaps (up to the horizon), detect permanent stalls
+    if (cpu < 0 && io < 0 && terminated_now == 0) {
+        if (set->next_arrival >= set->n) {
+            *status = sim_stalled;
+            (*now)++;
+            return 0;
+        }
+        if (set->count == 0) {
+            sim_time_t next = set->procs[set->arrivals[set->next_arrival]]->arrival_time_p;
+            sim_time_t horizon = run ? run->horizon : 0;
+            *now = (horizon > 0 && next > horizon) ? horizon : next;
+            return 1;
+        }
+    }
+
+    (*now)++;
+    return 1;
+}
+
+void sim_rng_seed(sim_rng_t *rng, uint64_t seed) {
+    rng->state = seed;
+}
+
+uint64_t sim_rng_next(sim_rng_t *rng) {
+    uint64_t z = (rng->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform value in [0, bound) without modulo bias
+uint64_t sim_rng_below(sim_rng_t *rng, uint64_t bound) {
+    if (bound == 0) return 0;
+    uint64_t threshold = (0 - bound) % bound;
+    uint64_t r;
+    do {
+        r = sim_rng_next(rng);
+    } while (r < threshold);
+    return r % bound;
+}
@@ -2,6 +2,10 @@
 #define BASIC_SCHED_H
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+
+// Simulated time is 64-bit so long workload replays never wrap around
+typedef int64_t sim_time_t;
 
 typedef enum process_state {
   waiting_p,
@@ -19,16 +23,24 @@ typedef enum {
 
 typedef struct operation_t {
   process_operation_t operation_p;
-  int duration_op;
+  sim_time_t duration_op;
 } operation_t;
 
+// Accepted priorities: the multi-level schedulers keep a round-robin cursor per level
+#define SIM_PRIORITY_MIN 0
+#define SIM_PRIORITY_MAX 99
+
 typedef struct process_t {
   char *process_name;
-  int begining_date;
+  sim_time_t begining_date;
   operation_t *descriptor_p;
-  int arrival_time_p;
+  sim_time_t arrival_time_p;
   int operations_count;
   int priority_p;
+  int tickets;          // Lottery/stride tickets (0 = derived from priority_p)
+  sim_time_t deadline;  // Relative deadline from arrival (0 = none)
+  sim_time_t period;    // Release period of a periodic task (0 = aperiodic)
+  int job;              // Job number within a periodic task (0 = first)
 } process_t;
 
 typedef struct node_t {
@@ -44,11 +56,112 @@ typedef struct process_queue {
 
 typedef struct process_descriptor_t {
   char* process_name ;
-  int date ;
+  sim_time_t date ;
   process_state state;
   process_operation_t operation;
 }process_descriptor_t;
 
+// How a simulation run ended
+typedef enum sim_status_t {
+  sim_completed,        // Every process terminated
+  sim_horizon_reached,  // Stopped at the configured time horizon
+  sim_stalled,          // No process can ever make progress again
+  sim_cancelled,        // The trace sink asked the run to stop
+  sim_resume_rejected   // run->resume does not fit the policy or workload: nothing ran
+} sim_status_t;
+
+// Optional trace consumer: receives every record instead of the descriptor array.
+// Returns 0 to cancel the run.
+typedef int (*sim_sink_t)(void *ctx, const process_descriptor_t *record);
+
+// Which records a run keeps (in the descriptor array or through the sink)
+typedef enum sim_trace_level_t {
+  trace_full,           // One record per process per tick
+  trace_transitions,    // Only records that change a process's state (needs metrics)
+  trace_none            // No records at all: only the metrics accumulator is fed
+} sim_trace_level_t;
+
+struct sim_metrics_t;
+struct sim_checkpoint_t;
+
+// Per-run limits (inputs) and outcome (outputs) shared by all schedulers
+typedef struct sim_run_t {
+  sim_time_t horizon;    // Stop at this time, 0 = unbounded
+  sim_sink_t sink;       // NULL = append records to the descriptor array
+  void *sink_ctx;
+  sim_trace_level_t trace_level;
+  struct sim_metrics_t *metrics;   // Optional accumulator fed with every record
+  const struct sim_checkpoint_t *resume;   // Continue from this snapshot instead of time 0
+  struct sim_checkpoint_t *checkpoint;     // Filled when the run stops at the horizon or is cancelled
+  int cancelled;         // Set once the sink returned 0
+  sim_status_t status;
+  sim_time_t end_time;   // Simulated time at which the run stopped
+  int finished;          // Number of terminated processes
+  int total;             // Number of processes in the workload
+} sim_run_t;
+
+void sim_run_init(sim_run_t *run, sim_time_t horizon);
+
+// Feed the run's metrics, then hand the record (if the trace level keeps it) to the
+// run's sink, or append it to the descriptor array
+void sim_emit(sim_run_t *run, process_descriptor_t **descriptor, int *size, process_descriptor_t record);
+
+// Bookkeeping shared by the heap- and tree-based schedulers (CFS, lottery/stride, EDF,
+// MLFQ). Processes are workload indices: they are admitted in arrival order, the active
+// set holds those that arrived and did not terminate, and the I/O device serves a FIFO.
+typedef struct sim_active_t {
+  const process_t **procs;   // Workload order
+  int n;
+  int *arrivals;             // Indices sorted by (arrival, index)
+  int next_arrival;
+  int *active;               // Arrived and not terminated (swap-removed on termination)
+  int *active_pos;           // Slot of each process in active
+  int count;
+  int *completed;            // Processes whose last operation ended during this tick
+  int completed_count;
+  int finished;
+  int *io_next;              // I/O FIFO links (-1 = end)
+  int io_head;               // -1 when no process waits for the device
+  int io_tail;
+} sim_active_t;
+
+// How one tick of an operation left the process
+typedef enum sim_op_result_t {
+  sim_op_continues,    // Ticks left in the operation
+  sim_op_next,         // Operation ended, the next one is loaded
+  sim_op_last          // Last operation ended, the process is marked completed
+} sim_op_result_t;
+
+int sim_active_init(sim_active_t *set, const process_queue *queue);   // 0 when out of memory
+void sim_active_free(sim_active_t *set);
+
+// Next process arrived by now (it joins the active set), -1 when there is none
+int sim_active_admit(sim_active_t *set, sim_time_t now);
+
+void sim_active_io_push(sim_active_t *set, int idx);
+int sim_active_io_pop(sim_active_t *set);
+
+// One tick of process idx's current operation op: emits the running record and
+// advances op_idx / op_remaining
+sim_op_result_t sim_active_run_op(sim_active_t *set, sim_run_t *run, process_descriptor_t **descriptor,
+                                  int *size, int idx, process_operation_t op, int *op_idx,
+                                  sim_time_t *op_remaining, sim_time_t now);
+
+// Close the tick in which cpu and io ran (-1 = idle): waiting records for the other
+// active processes, termination records, then the next tick (idle gaps are skipped).
+// Returns 0 when no process can ever progress again (status becomes sim_stalled).
+int sim_active_end_tick(sim_active_t *set, sim_run_t *run, process_descriptor_t **descriptor,
+                        int *size, int cpu, int io, sim_time_t *now, sim_status_t *status);
+
+// Small seeded generator (splitmix64) so randomized policies are reproducible
+typedef struct sim_rng_t {
+  uint64_t state;
+} sim_rng_t;
+
+void sim_rng_seed(sim_rng_t *rng, uint64_t seed);
+uint64_t sim_rng_next(sim_rng_t *rng);
+uint64_t sim_rng_below(sim_rng_t *rng, uint64_t bound);
+
 void add_tail(process_queue* p, process_t process);
 
 void append_descriptor(process_descriptor_t** descriptor ,process_descriptor_t unit_descriptor, int *size);
@@ -56,14 +169,40 @@ void append_descriptor(process_descriptor_t** descriptor ,process_descriptor_t u
 void remove_head(process_queue *p);
 
 
-typedef void (*sched_func_t)(process_queue*, process_descriptor_t**, int*);
-typedef void (*sched_func_quantum_t)(process_queue*, process_descriptor_t**, int*, int);
+// Completely Fair Scheduler tuning (times in ticks, <= 0 selects the default)
+typedef struct cfs_params_t {
+  sim_time_t target_latency;   // Period in which every runnable process runs once
+  sim_time_t min_granularity;  // Minimum slice before a process can be preempted
+} cfs_params_t;
+
+// Multi-level + aging tuning
+typedef struct aging_params_t {
+  int threshold;   // Waiting ticks before a process is promoted (<= 0 selects 5)
+} aging_params_t;
+
+// Multilevel feedback queue tuning
+#define MLFQ_MAX_LEVELS 16
+
+typedef struct mlfq_params_t {
+  int levels;                           // Number of queues (<= 0 selects 3)
+  sim_time_t quanta[MLFQ_MAX_LEVELS];   // Allotment per level (<= 0 doubles the level above, top = 2)
+  sim_time_t boost_period;              // Priority boost period (0 = 50, < 0 = never)
+} mlfq_params_t;
+
+typedef void (*sched_func_t)(process_queue*, process_descriptor_t**, int*, sim_run_t*);
+typedef void (*sched_func_quantum_t)(process_queue*, process_descriptor_t**, int*, int, sim_run_t*);
 
 
-void fifo_sched(process_queue* p, process_descriptor_t** descriptor, int *size) __attribute__((weak));
-void round_robin_sched(process_queue* p, process_descriptor_t** descriptor, int *size, int quantum) __attribute__((weak));
-void priority_sched(process_queue* p,  process_descriptor_t** descriptor, int *size) __attribute__((weak));
-void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, int *size) __attribute__((weak));
-void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descriptor, int *size) __attribute__((weak));
+// Every scheduler accepts an optional sim_run_t (NULL = unbounded, no report)
+void fifo_sched(process_queue* p, process_descriptor_t** descriptor, int *size, sim_run_t *run) __attribute__((weak));
+void round_robin_sched(process_queue* p, process_descriptor_t** descriptor, int *size, int quantum, sim_run_t *run) __attribute__((weak));
+void priority_sched(process_queue* p,  process_descriptor_t** descriptor, int *size, sim_run_t *run) __attribute__((weak));
+void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, int *size, sim_run_t *run) __attribute__((weak));
+void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descriptor, int *size, const aging_params_t *params, sim_run_t *run) __attribute__((weak));
+void cfs_sched(process_queue* p, process_descriptor_t** descriptor, int *size, const cfs_params_t *params, sim_run_t *run) __attribute__((weak));
+void lottery_sched(process_queue* p, process_descriptor_t** descriptor, int *size, int quantum, uint64_t seed, sim_run_t *run) __attribute__((weak));
+void stride_sched(process_queue* p, process_descriptor_t** descriptor, int *size, int quantum, sim_run_t *run) __attribute__((weak));
+void edf_sched(process_queue* p, process_descriptor_t** descriptor, int *size, sim_run_t *run) __attribute__((weak));
+void mlfq_sched(process_queue* p, process_descriptor_t** descriptor, int *size, const mlfq_params_t *params, sim_run_t *run) __attribute__((weak));
 
 #endif 
@@ -0,0 +1,468 @@
+#include "batch_lanes.h"
+#include <limits.h>
+#include <string.h>
+
+#define LANE_OPS_DONE 3   // Operation kind once a process has run all its operations
+#define BATCH_WORKLOADS (BATCH_LANES * 16)   // Workloads sharing one lane layout
+
+// State of one batch. Per-process arrays hold slots * lanes entries, slot-major
+// (entry k * lanes + l is process slot k of lane l), so the lanes of one slot are
+// contiguous. Lanes with fewer processes are padded with terminated slots.
+typedef struct lane_batch_t {
+    int lanes;
+    int slots;                 // Processes of the largest workload in the batch
+
+    // Per lane
+    int* n;                    // Processes of the workload
+    sim_time_t* now;
+    int* finished;
+    int* active;               // 0 once the lane's run has ended
+    int* rr;                   // Round-robin position
+    int* owner;                // Workload (result index) in the lane
+    sim_time_t* cpu_ticks;
+    sim_time_t* io_ticks;
+    int* last_cpu;             // Slot of the latest CPU tick (-1 = none yet)
+    sim_time_t* switches;      // Context switches
+
+    // Per process slot
+    const operation_t** ops;
+    int* op_count;
+    int* op_idx;
+    int* kind;                 // Operation of op_idx (LANE_OPS_DONE past the last one)
+    sim_time_t* remaining;
+    sim_time_t* io_until;      // -1 when not doing I/O
+    sim_time_t* arrival;
+    int* used;                 // Quantum used by the current CALC operation
+    int* term;
+    int* seen;                 // Has emitted a record (counts in the metrics)
+    sim_time_t* start;
+    sim_time_t* end;
+    sim_time_t* wait;
+    sim_time_t* first_run;     // First CPU tick (-1 = none yet)
+
+    const process_t** order;   // Scratch for lane_load()
+    sim_time_t* responses;     // Scratch for lane_finish()
+} lane_batch_t;
+
+static void lane_batch_free(lane_batch_t* b) {
+    free(b->n); free(b->now); free(b->finished); free(b->active); free(b->rr);
+    free(b->owner); free(b->cpu_ticks); free(b->io_ticks); free(b->last_cpu); free(b->switches);
+    free(b->ops); free(b->op_count); free(b->op_idx); free(b->kind);
+    free(b->remaining); free(b->io_until); free(b->arrival); free(b->used);
+    free(b->term); free(b->seen); free(b->start); free(b->end); free(b->wait); free(b->first_run);
+    free(b->order); free(b->responses);
+}
+
+static int lane_batch_alloc(lane_batch_t* b, int lanes, int slots) {
+    memset(b, 0, sizeof(*b));
+    b->lanes = lanes;
+    b->slots = slots;
+    size_t m = (size_t)lanes * (size_t)slots;
+    b->n = calloc(lanes, sizeof(int));
+    b->now = calloc(lanes, sizeof(sim_time_t));
+    b->finished = calloc(lanes, sizeof(int));
+    b->active = calloc(lanes, sizeof(int));
+    b->rr = calloc(lanes, sizeof(int));
+    b->owner = calloc(lanes, sizeof(int));
+    b->cpu_ticks = calloc(lanes, sizeof(sim_time_t));
+    b->io_ticks = calloc(lanes, sizeof(sim_time_t));
+    b->last_cpu = calloc(lanes, sizeof(int));
+    b->switches = calloc(lanes, sizeof(sim_time_t));
+    b->ops = calloc(m, sizeof(const operation_t*));
+    b->op_count = calloc(m, sizeof(int));
+    b->op_idx = calloc(m, sizeof(int));
+    b->kind = calloc(m, sizeof(int));
+    b->remaining = calloc(m, sizeof(sim_time_t));
+    b->io_until = calloc(m, sizeof(sim_time_t));
+    b->arrival = calloc(m, sizeof(sim_time_t));
+    b->used = calloc(m, sizeof(int));
+    b->term = calloc(m, sizeof(int));
+    b->seen = calloc(m, sizeof(int));
+    b->start = calloc(m, sizeof(sim_time_t));
+    b->end = calloc(m, sizeof(sim_time_t));
+    b->wait = calloc(m, sizeof(sim_time_t));
+    b->first_run = calloc(m, sizeof(sim_time_t));
+    b->order = calloc(slots, sizeof(const process_t*));
+    b->responses = calloc(slots, sizeof(sim_time_t));
+    if (!b->n || !b->now || !b->finished || !b->active || !b->rr || !b->owner || !b->cpu_ticks ||
+        !b->io_ticks || !b->last_cpu || !b->switches ||
+        !b->first_run || !b->order || !b->responses || !b->ops ||
+        !b->op_count || !b->op_idx || !b->kind || !b->remaining || !b->io_until ||
+        !b->arrival || !b->used || !b->term || !b->seen || !b->start || !b->end ||
+        !b->wait) {
+        lane_batch_free(b);
+        return 0;
+    }
+    return 1;
+}
+
+// Put a workload (at most b->slots processes) into lane l, in the order the policy scans it
+static void lane_load(lane_batch_t* b, int l, const process_queue* queue, lane_policy_t policy) {
+    int n = queue->size;
+    const process_t** order = b->order;
+    int idx = 0;
+    for (node_t* node = queue->head; node != NULL && idx < n; node = node->next) {
+        order[idx++] = &node->proc;
+    }
+    if (policy == lane_fifo) {
+        // Stable by arrival time, like fifo_sched()
+        for (int i = 1; i < n; i++) {
+            const process_t* p = order[i];
+            int j = i - 1;
+            while (j >= 0 && order[j]->arrival_time_p > p->arrival_time_p) {
+                order[j + 1] = order[j];
+                j--;
+            }
+            order[j + 1] = p;
+        }
+    }
+
+    b->n[l] = n;
+    b->now[l] = 0;
+    b->finished[l] = 0;
+    b->rr[l] = 0;
+    b->cpu_ticks[l] = 0;
+    b->io_ticks[l] = 0;
+    b->last_cpu[l] = -1;
+    b->switches[l] = 0;
+    for (int k = 0; k < b->slots; k++) {
+        int i = k * b->lanes + l;
+        b->used[i] = 0;
+        b->seen[i] = 0;
+        b->start[i] = b->end[i] = 0;
+        b->wait[i] = 0;
+        b->first_run[i] = -1;
+        b->io_until[i] = -1;
+        b->term[i] = (k >= n);
+        if (k >= n) continue;
+        const process_t* proc = order[k];
+        b->ops[i] = proc->descriptor_p;
+        b->op_count[i] = proc->operations_count;
+        b->op_idx[i] = 0;
+        b->kind[i] = (proc->operations_count > 0) ? (int)proc->descriptor_p[0].operation_p : LANE_OPS_DONE;
+        b->remaining[i] = (proc->operations_count > 0) ? proc->descriptor_p[0].duration_op : 0;
+        b->arrival[i] = proc->arrival_time_p;
+    }
+}
+
+static void lane_next_op(lane_batch_t* b, int i) {
+    b->op_idx[i]++;
+    if (b->op_idx[i] < b->op_count[i]) {
+        b->kind[i] = (int)b->ops[i][b->op_idx[i]].operation_p;
+        b->remaining[i] = b->ops[i][b->op_idx[i]].duration_op;
+    } else {
+        b->kind[i] = LANE_OPS_DONE;
+    }
+}
+
+static void lane_finish(lane_batch_t* b, int l, sim_status_t status, lane_result_t* result) {
+    b->active[l] = 0;
+    result->status = status;
+    result->end_time = b->now[l];
+    result->finished = b->finished[l];
+    result->total = b->n[l];
+
+    sim_metrics_summary_t* s = &result->summary;
+    memset(s, 0, sizeof(*s));
+    double turnaround = 0, waiting = 0;
+    for (int k = 0; k < b->n[l]; k++) {
+        int i = k * b->lanes + l;
+        if (!b->seen[i]) continue;
+        sim_time_t span = b->end[i] - b->start[i];
+        s->processes++;
+        if (b->term[i]) s->terminated++;
+        turnaround += (double)span;
+        waiting += (double)b->wait[i];
+        if (span > s->max_turnaround) s->max_turnaround = span;
+        if (b->end[i] > s->makespan) s->makespan = b->end[i];
+    }
+    if (s->processes > 0) {
+        s->mean_turnaround = turnaround / s->processes;
+        s->mean_waiting = waiting / s->processes;
+    }
+    // The responses scratch first holds the waiting and turnaround times
+    int seen = 0;
+    for (int k = 0; k < b->n[l]; k++) {
+        int i = k * b->lanes + l;
+        if (b->seen[i]) b->responses[seen++] = b->wait[i];
+    }
+    s->p99_waiting = sim_percentile99(b->responses, seen);
+    seen = 0;
+    for (int k = 0; k < b->n[l]; k++) {
+        int i = k * b->lanes + l;
+        if (b->seen[i]) b->responses[seen++] = b->end[i] - b->start[i];
+    }
+    s->p99_turnaround = sim_percentile99(b->responses, seen);
+
+    int responded = 0;
+    for (int k = 0; k < b->n[l]; k++) {
+        int i = k * b->lanes + l;
+        if (b->seen[i] && b->first_run[i] >= 0) b->responses[responded++] = b->first_run[i] - b->start[i];
+    }
+    s->cpu_ticks = b->cpu_ticks[l];
+    s->io_ticks = b->io_ticks[l];
+    s->context_switches = b->switches[l];
+    sim_summary_finish(s, b->now[l], b->responses, responded);
+}
+
+// Selection over process slot k of every lane: the first ready CALC process in scan
+// order (from the RR position), the process doing I/O, the first one waiting for the
+// device. Branch-free over the lanes, so the compiler can vectorize it.
+static void lane_select(int k, int K, const int* restrict active, const int* restrict n,
+                        const int* restrict rr, const sim_time_t* restrict now,
+                        const int* restrict term, const int* restrict kind,
+                        const sim_time_t* restrict arrival, const sim_time_t* restrict io_until,
+                        int* restrict cpu, int* restrict cpu_key, int* restrict io_busy,
+                        int* restrict io_next, int* restrict ready, sim_time_t* restrict next_arrival) {
+    for (int l = 0; l < K; l++) {
+        int present = active[l] & !term[l] & (arrival[l] <= now[l]);
+        int idle = io_until[l] < 0;
+        int key = k - rr[l];
+        key += (key < 0) ? n[l] : 0;
+        int calc = present & idle & (kind[l] == calc_p);
+        ready[l] += calc;
+        int take_cpu = calc & (key < cpu_key[l]);
+        cpu[l] = take_cpu ? k : cpu[l];
+        cpu_key[l] = take_cpu ? key : cpu_key[l];
+        int take_busy = present & (io_until[l] > now[l]) & (io_busy[l] < 0);
+        io_busy[l] = take_busy ? k : io_busy[l];
+        int take_next = present & idle & (kind[l] == IO_p) & (io_next[l] < 0);
+        io_next[l] = take_next ? k : io_next[l];
+        int later = active[l] & !term[l] & (arrival[l] > now[l]) &
+                    ((next_arrival[l] < 0) | (arrival[l] < next_arrival[l]));
+        next_arrival[l] = later ? arrival[l] : next_arrival[l];
+    }
+}
+
+// Bookkeeping over process slot k of every lane for a span of ticks: the records the
+// schedulers would emit (running, waiting, terminated), folded straight into the metrics
+static void lane_account(int k, int K, const int* restrict active, const sim_time_t* restrict now,
+                         const sim_time_t* restrict span,
+                         const int* restrict cpu, const int* restrict io, const int* restrict kind,
+                         const sim_time_t* restrict arrival, const sim_time_t* restrict io_until,
+                         int* restrict term, int* restrict seen, sim_time_t* restrict start,
+                         sim_time_t* restrict end, sim_time_t* restrict wait,
+                         int* restrict finished, int* restrict ended) {
+    for (int l = 0; l < K; l++) {
+        int present = active[l] & !term[l] & (arrival[l] <= now[l]);
+        int assigned = (k == cpu[l]) | (k == io[l]);
+        int done = present & (kind[l] == LANE_OPS_DONE) & (io_until[l] < 0);
+        wait[l] += (present & !assigned) ? span[l] : 0;
+        start[l] = (present & !seen[l]) ? now[l] : start[l];
+        end[l] = present ? now[l] + span[l] - 1 + done : end[l];
+        seen[l] |= present;
+        term[l] |= done;
+        finished[l] += done;
+        ended[l] += done;
+    }
+}
+
+// Hand lane l the next pending workload; 0 when none is left. Workloads the
+// schedulers would return on without running are completed right away.
+static int lane_start(lane_batch_t* b, int l, process_queue* const* workloads, const int* pending,
+                      int pending_count, int* next, lane_policy_t policy, int quantum,
+                      lane_result_t* results) {
+    while (*next < pending_count) {
+        int w = pending[(*next)++];
+        b->owner[l] = w;
+        if (workloads[w]->size == 0 || (policy == lane_round_robin && quantum <= 0)) {
+            b->n[l] = 0;
+            b->cpu_ticks[l] = 0;
+            b->io_ticks[l] = 0;
+            b->switches[l] = 0;
+            lane_finish(b, l, sim_completed, &results[w]);
+            continue;
+        }
+        lane_load(b, l, workloads[w], policy);
+        b->active[l] = 1;
+        return 1;
+    }
+    b->active[l] = 0;
+    return 0;
+}
+
+// Run the pending workloads through the lanes of one batch. A lane whose run ends
+// takes the next workload, so the lanes stay busy until the last ones drain.
+static void lane_batch_run(lane_batch_t* b, process_queue* const* workloads, const int* pending,
+                           int pending_count, lane_policy_t policy, int quantum,
+                           sim_time_t horizon, lane_result_t* results) {
+    int K = b->lanes;
+    int cpu[BATCH_LANES], cpu_key[BATCH_LANES], io_busy[BATCH_LANES], io_next[BATCH_LANES];
+    int io[BATCH_LANES], ended[BATCH_LANES];
+    int ready[BATCH_LANES];
+    sim_time_t next_arrival[BATCH_LANES], span[BATCH_LANES];
+
+    int next = 0, live = 0;
+    for (int l = 0; l < K; l++) {
+        live += lane_start(b, l, workloads, pending, pending_count, &next, policy, quantum, results);
+    }
+
+    while (live > 0) {
+        for (int l = 0; l < K; l++) {
+            if (!b->active[l]) continue;
+            sim_status_t status;
+            if (b->finished[l] >= b->n[l]) status = sim_completed;
+            else if (horizon > 0 && b->now[l] >= horizon) status = sim_horizon_reached;
+            else continue;
+            lane_finish(b, l, status, &results[b->owner[l]]);
+            live -= !lane_start(b, l, workloads, pending, pending_count, &next, policy, quantum, results);
+        }
+        if (live == 0) break;
+
+        // Selection: first ready CALC process in scan order (from the RR position),
+        // the process already doing I/O, else the first one waiting for the device
+        for (int l = 0; l < K; l++) {
+            cpu[l] = -1;
+            cpu_key[l] = INT_MAX;
+            io_busy[l] = -1;
+            io_next[l] = -1;
+            ready[l] = 0;
+            next_arrival[l] = -1;
+        }
+        for (int k = 0; k < b->slots; k++) {
+            lane_select(k, K, b->active, b->n, b->rr, b->now, b->term + k * K, b->kind + k * K,
+                        b->arrival + k * K, b->io_until + k * K, cpu, cpu_key, io_busy, io_next,
+                        ready, next_arrival);
+        }
+
+        // Execution. The selection cannot change before the running CALC operation or
+        // quantum ends, the I/O completes, a process arrives or the horizon is reached,
+        // so the lane runs that many ticks (its span) in one step.
+        for (int l = 0; l < K; l++) {
+            io[l] = -1;
+            ended[l] = 0;
+            span[l] = 1;
+            if (!b->active[l]) continue;
+            if (io_busy[l] >= 0) {
+                io[l] = io_busy[l];
+            } else if (io_next[l] >= 0) {
+                io[l] = io_next[l];
+                int i = io[l] * K + l;
+                b->io_until[i] = b->now[l] + b->remaining[i];
+            }
+            if (cpu[l] < 0 && io[l] < 0) continue;
+
+            sim_time_t d = INT64_MAX;
+            if (cpu[l] >= 0) {
+                int i = cpu[l] * K + l;
+                d = b->remaining[i];
+                // A lone ready process gets the CPU back at every quantum expiry
+                if (policy == lane_round_robin && ready[l] > 1 && quantum - b->used[i] < d) {
+                    d = quantum - b->used[i];
+                }
+            }
+            if (io[l] >= 0) {
+                int i = io[l] * K + l;
+                if (b->io_until[i] - b->now[l] < d) d = b->io_until[i] - b->now[l];
+            }
+            if (next_arrival[l] >= 0 && next_arrival[l] - b->now[l] < d) d = next_arrival[l] - b->now[l];
+            if (horizon > 0 && horizon - b->now[l] < d) d = horizon - b->now[l];
+            if (d < 1) d = 1;
+            span[l] = d;
+
+            if (cpu[l] >= 0) {
+                int i = cpu[l] * K + l;
+                b->remaining[i] -= d;
+                b->cpu_ticks[l] += d;
+                if (b->first_run[i] < 0) b->first_run[i] = b->now[l];
+                b->switches[l] += (b->last_cpu[l] >= 0) & (b->last_cpu[l] != cpu[l]);
+                b->last_cpu[l] = cpu[l];
+                if (b->remaining[i] == 0) {
+                    lane_next_op(b, i);
+                    b->used[i] = 0;
+                    if (policy == lane_round_robin) b->rr[l] = (cpu[l] + 1) % b->n[l];
+                } else if (policy == lane_round_robin && b->used[i] + d >= quantum) {
+                    b->used[i] = (int)((b->used[i] + d) % quantum);
+                    b->rr[l] = (cpu[l] + 1) % b->n[l];
+                } else if (policy == lane_round_robin) {
+                    b->used[i] += (int)d;
+                }
+            }
+
+            if (io[l] >= 0) {
+                int i = io[l] * K + l;
+                b->io_ticks[l] += d;
+                if (b->io_until[i] <= b->now[l] + d) {
+                    lane_next_op(b, i);
+                    b->io_until[i] = -1;
+                }
+            }
+        }
+
+        // Bookkeeping: the records the schedulers would emit, folded into the metrics
+        for (int k = 0; k < b->slots; k++) {
+            lane_account(k, K, b->active, b->now, span, cpu, io, b->kind + k * K, b->arrival + k * K,
+                         b->io_until + k * K, b->term + k * K, b->seen + k * K, b->start + k * K,
+                         b->end + k * K, b->wait + k * K, b->finished, ended);
+        }
+
+        // Clock: skip idle gaps (up to the horizon), detect permanent stalls
+        for (int l = 0; l < K; l++) {
+            if (!b->active[l]) continue;
+            if (cpu[l] < 0 && io[l] < 0 && !ended[l]) {
+                int busy = 0;
+                for (int k = 0; k < b->n[l]; k++) {
+                    int i = k * K + l;
+                    busy |= !b->term[i] & (b->arrival[i] <= b->now[l]);
+                }
+                if (next_arrival[l] < 0) {
+                    b->now[l]++;
+                    lane_finish(b, l, sim_stalled, &results[b->owner[l]]);
+                    live -= !lane_start(b, l, workloads, pending, pending_count, &next, policy,
+                                        quantum, results);
+                    continue;
+                }
+                if (!busy) {
+                    b->now[l] = (horizon > 0 && next_arrival[l] > horizon) ? horizon : next_arrival[l];
+                    continue;
+                }
+            }
+            b->now[l] += span[l];
+        }
+    }
+}
+
+static int compare_size(const void* a, const void* b) {
+    const int* x = a;
+    const int* y = b;
+    if (x[0] != y[0]) return (x[0] < y[0]) ? -1 : 1;
+    return (x[1] < y[1]) ? -1 : (x[1] > y[1]);
+}
+
+int batch_lanes_run(process_queue* const* workloads, int count, lane_policy_t policy,
+                    int quantum, sim_time_t horizon, lane_result_t* results) {
+    if (count <= 0) return 1;
+
+    // Workloads by size, so a batch pads its lanes to a similar process count
+    int* by_size = malloc((size_t)count * 2 * sizeof(int));
+    int* pending = malloc((size_t)count * sizeof(int));
+    if (!by_size || !pending) {
+        free(by_size);
+        free(pending);
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        by_size[2 * i] = workloads[i]->size;
+        by_size[2 * i + 1] = i;
+    }
+    qsort(by_size, count, 2 * sizeof(int), compare_size);
+    for (int i = 0; i < count; i++) pending[i] = by_size[2 * i + 1];
+    free(by_size);
+
+    int rc = 1;
+    for (int first = 0; first < count; first += BATCH_WORKLOADS) {
+        int chunk = (count - first < BATCH_WORKLOADS) ? count - first : BATCH_WORKLOADS;
+        int lanes = (chunk < BATCH_LANES) ? chunk : BATCH_LANES;
+        int slots = workloads[pending[first + chunk - 1]]->size;
+
+        lane_batch_t batch;
+        if (!lane_batch_alloc(&batch, lanes, slots > 0 ? slots : 1)) {
+            rc = 0;
+            break;
+        }
+        lane_batch_run(&batch, workloads, pending + first, chunk, policy, quantum, horizon, results);
+        lane_batch_free(&batch);
+    }
+    free(pending);
+    return rc;
+}
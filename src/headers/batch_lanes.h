@@ -0,0 +1,34 @@
+#ifndef BATCH_LANES_H
+#define BATCH_LANES_H
+
+#include "basic_sched.h"
+#include "sim_metrics.h"
+
+// Lockstep simulation of many small workloads: up to BATCH_LANES workloads (lanes)
+// advance together, with every per-process field stored as an array of
+// [process slot][lane]. Selection and bookkeeping are loops over the lanes of one
+// slot, with no trace records and no per-record calls. A lane moves by as many ticks
+// as its scheduling decision stays the same. Results are those of fifo_sched() /
+// round_robin_sched() run with trace_none and a sim_metrics_t.
+
+#define BATCH_LANES 32
+
+typedef enum lane_policy_t {
+    lane_fifo,
+    lane_round_robin
+} lane_policy_t;
+
+// Outcome of one workload
+typedef struct lane_result_t {
+    sim_status_t status;
+    sim_time_t end_time;
+    int finished;
+    int total;
+    sim_metrics_summary_t summary;
+} lane_result_t;
+
+// Simulate count workloads; results[i] belongs to workloads[i]. Returns 0 when out of memory.
+int batch_lanes_run(process_queue* const* workloads, int count, lane_policy_t policy,
+                    int quantum, sim_time_t horizon, lane_result_t* results);
+
+#endif
@@ -0,0 +1,81 @@
+#include "buffered_writer.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+int writer_open(buffered_writer_t* w, const char* path, const char* mode) {
+    w->file = fopen(path, mode);
+    w->buffer = malloc(BUFFERED_WRITER_SIZE);
+    w->used = 0;
+    w->capacity = BUFFERED_WRITER_SIZE;
+    w->error = 0;
+
+    if (!w->file || !w->buffer) {
+        if (w->file) fclose(w->file);
+        free(w->buffer);
+        w->file = NULL;
+        w->buffer = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+void writer_flush(buffered_writer_t* w) {
+    if (w->used > 0 && !w->error) {
+        if (fwrite(w->buffer, 1, w->used, w->file) != w->used) w->error = 1;
+    }
+    w->used = 0;
+}
+
+int writer_close(buffered_writer_t* w) {
+    if (!w->file) return 0;
+    writer_flush(w);
+    if (fclose(w->file) != 0) w->error = 1;
+    free(w->buffer);
+    w->file = NULL;
+    w->buffer = NULL;
+    return !w->error;
+}
+
+void writer_write(buffered_writer_t* w, const void* data, size_t len) {
+    if (w->used + len > w->capacity) {
+        writer_flush(w);
+        // Larger than the whole buffer: write through
+        if (len > w->capacity) {
+            if (!w->error && fwrite(data, 1, len, w->file) != len) w->error = 1;
+            return;
+        }
+    }
+    memcpy(w->buffer + w->used, data, len);
+    w->used += len;
+}
+
+void writer_puts(buffered_writer_t* w, const char* text) {
+    writer_write(w, text, strlen(text));
+}
+
+void writer_printf(buffered_writer_t* w, const char* format, ...) {
+    va_list args;
+
+    // Format straight into the buffer; flush and retry once when it does not fit
+    for (int attempt = 0; attempt < 2; attempt++) {
+        size_t room = w->capacity - w->used;
+        va_start(args, format);
+        int len = vsnprintf(w->buffer + w->used, room, format, args);
+        va_end(args);
+        if (len < 0) {
+            w->error = 1;
+            return;
+        }
+        if ((size_t)len < room) {
+            w->used += len;
+            return;
+        }
+        writer_flush(w);
+    }
+
+    // Longer than the buffer itself
+    va_start(args, format);
+    if (!w->error && vfprintf(w->file, format, args) < 0) w->error = 1;
+    va_end(args);
+}
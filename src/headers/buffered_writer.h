@@ -0,0 +1,27 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define BUFFERED_WRITER_SIZE (1 << 20)   // Flush in 1 MB writes
+
+// Large output buffer in front of a FILE, for exporters that stream traces
+typedef struct buffered_writer_t {
+    FILE* file;
+    char* buffer;
+    size_t used;
+    size_t capacity;
+    int error;                 // Sticky: set on the first failed allocation or write
+} buffered_writer_t;
+
+int writer_open(buffered_writer_t* w, const char* path, const char* mode);
+int writer_close(buffered_writer_t* w);          // Flushes; 0 when any write failed
+
+void writer_flush(buffered_writer_t* w);
+void writer_write(buffered_writer_t* w, const void* data, size_t len);
+void writer_puts(buffered_writer_t* w, const char* text);
+void writer_printf(buffered_writer_t* w, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+#endif
@@ -0,0 +1,416 @@
+#include "basic_sched.h"
+#include <stdlib.h>
+
+#define CFS_DEFAULT_LATENCY 20         // Default target latency (ticks)
+#define CFS_DEFAULT_MIN_GRANULARITY 2  // Default minimum granularity (ticks)
+#define CFS_DEFAULT_PRIORITY 5         // priority_p that maps to nice 0
+#define CFS_NICE_0_WEIGHT 1024
+#define CFS_VRUNTIME_SCALE 1024        // vruntime units per tick at nice 0
+
+// Linux sched_prio_to_weight[]: nice -20 .. 19, one nice level is ~1.25x CPU share
+static const int cfs_nice_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15
+};
+
+// Per-process scheduling entity, also a node of the runnable red-black tree
+typedef struct cfs_entity_t {
+    struct cfs_entity_t *left;
+    struct cfs_entity_t *right;
+    struct cfs_entity_t *parent;
+    int red;
+
+    process_t proc;
+    int idx;                      // Position in the workload (tie-breaker)
+    int weight;                   // Load weight derived from priority_p
+    sim_time_t vruntime;          // Weighted CPU time received
+    sim_time_t slice_used;        // Ticks run since last picked
+    int op_idx;                   // Current operation index
+    sim_time_t op_remaining;      // Remaining time for current operation
+} cfs_entity_t;
+
+// Red-black tree of runnable entities ordered by (vruntime, idx)
+typedef struct {
+    cfs_entity_t *root;
+    cfs_entity_t *leftmost;       // Cached minimum, NULL when empty
+    cfs_entity_t nil;             // Sentinel (always black)
+    int count;
+    long long total_weight;
+} cfs_tree_t;
+
+static int cfs_weight(int priority) {
+    int nice = CFS_DEFAULT_PRIORITY - priority;
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    return cfs_nice_to_weight[nice + 20];
+}
+
+static int entity_less(const cfs_entity_t *a, const cfs_entity_t *b) {
+    if (a->vruntime != b->vruntime) return a->vruntime < b->vruntime;
+    return a->idx < b->idx;
+}
+
+static void rb_init(cfs_tree_t *t) {
+    t->nil.left = t->nil.right = t->nil.parent = &t->nil;
+    t->nil.red = 0;
+    t->root = &t->nil;
+    t->leftmost = NULL;
+    t->count = 0;
+    t->total_weight = 0;
+}
+
+static void rb_rotate_left(cfs_tree_t *t, cfs_entity_t *x) {
+    cfs_entity_t *y = x->right;
+    x->right = y->left;
+    if (y->left != &t->nil) y->left->parent = x;
+    y->parent = x->parent;
+    if (x->parent == &t->nil) t->root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+static void rb_rotate_right(cfs_tree_t *t, cfs_entity_t *x) {
+    cfs_entity_t *y = x->left;
+    x->left = y->right;
+    if (y->right != &t->nil) y->right->parent = x;
+    y->parent = x->parent;
+    if (x->parent == &t->nil) t->root = y;
+    else if (x == x->parent->right) x->parent->right = y;
+    else x->parent->left = y;
+    y->right = x;
+    x->parent = y;
+}
+
+static cfs_entity_t *rb_minimum(cfs_tree_t *t, cfs_entity_t *x) {
+    while (x->left != &t->nil) x = x->left;
+    return x;
+}
+
+static cfs_entity_t *rb_next(cfs_tree_t *t, cfs_entity_t *x) {
+    if (x->right != &t->nil) return rb_minimum(t, x->right);
+    cfs_entity_t *y = x->parent;
+    while (y != &t->nil && x == y->right) {
+        x = y;
+        y = y->parent;
+    }
+    return y;
+}
+
+static void rb_insert(cfs_tree_t *t, cfs_entity_t *z) {
+    cfs_entity_t *y = &t->nil;
+    cfs_entity_t *x = t->root;
+    int is_leftmost = 1;
+
+    while (x != &t->nil) {
+        y = x;
+        if (entity_less(z, x)) {
+            x = x->left;
+        } else {
+            x = x->right;
+            is_leftmost = 0;
+        }
+    }
+    z->parent = y;
+    if (y == &t->nil) t->root = z;
+    else if (entity_less(z, y)) y->left = z;
+    else y->right = z;
+    z->left = z->right = &t->nil;
+    z->red = 1;
+    if (is_leftmost) t->leftmost = z;
+    t->count++;
+    t->total_weight += z->weight;
+
+    while (z->parent->red) {
+        cfs_entity_t *g = z->parent->parent;
+        if (z->parent == g->left) {
+            y = g->right;
+            if (y->red) {
+                z->parent->red = 0;
+                y->red = 0;
+                g->red = 1;
+                z = g;
+            } else {
+                if (z == z->parent->right) {
+                    z = z->parent;
+                    rb_rotate_left(t, z);
+                }
+                z->parent->red = 0;
+                z->parent->parent->red = 1;
+                rb_rotate_right(t, z->parent->parent);
+            }
+        } else {
+            y = g->left;
+            if (y->red) {
+                z->parent->red = 0;
+                y->red = 0;
+                g->red = 1;
+                z = g;
+            } else {
+                if (z == z->parent->left) {
+                    z = z->parent;
+                    rb_rotate_right(t, z);
+                }
+                z->parent->red = 0;
+                z->parent->parent->red = 1;
+                rb_rotate_left(t, z->parent->parent);
+            }
+        }
+    }
+    t->root->red = 0;
+}
+
+static void rb_transplant(cfs_tree_t *t, cfs_entity_t *u, cfs_entity_t *v) {
+    if (u->parent == &t->nil) t->root = v;
+    else if (u == u->parent->left) u->parent->left = v;
+    else u->parent->right = v;
+    v->parent = u->parent;
+}
+
+static void rb_erase_fixup(cfs_tree_t *t, cfs_entity_t *x) {
+    while (x != t->root && !x->red) {
+        if (x == x->parent->left) {
+            cfs_entity_t *w = x->parent->right;
+            if (w->red) {
+                w->red = 0;
+                x->parent->red = 1;
+                rb_rotate_left(t, x->parent);
+                w = x->parent->right;
+            }
+            if (!w->left->red && !w->right->red) {
+                w->red = 1;
+                x = x->parent;
+            } else {
+                if (!w->right->red) {
+                    w->left->red = 0;
+                    w->red = 1;
+                    rb_rotate_right(t, w);
+                    w = x->parent->right;
+                }
+                w->red = x->parent->red;
+                x->parent->red = 0;
+                w->right->red = 0;
+                rb_rotate_left(t, x->parent);
+                x = t->root;
+            }
+        } else {
+            cfs_entity_t *w = x->parent->left;
+            if (w->red) {
+                w->red = 0;
+                x->parent->red = 1;
+                rb_rotate_right(t, x->parent);
+                w = x->parent->left;
+            }
+            if (!w->right->red && !w->left->red) {
+                w->red = 1;
+                x = x->parent;
+            } else {
+                if (!w->left->red) {
+                    w->right->red = 0;
+                    w->red = 1;
+                    rb_rotate_left(t, w);
+                    w = x->parent->left;
+                }
+                w->red = x->parent->red;
+                x->parent->red = 0;
+                w->left->red = 0;
+                rb_rotate_right(t, x->parent);
+                x = t->root;
+            }
+        }
+    }
+    x->red = 0;
+}
+
+static void rb_erase(cfs_tree_t *t, cfs_entity_t *z) {
+    if (t->leftmost == z) {
+        cfs_entity_t *next = rb_next(t, z);
+        t->leftmost = (next == &t->nil) ? NULL : next;
+    }
+
+    cfs_entity_t *y = z;
+    cfs_entity_t *x;
+    int y_was_red = y->red;
+
+    if (z->left == &t->nil) {
+        x = z->right;
+        rb_transplant(t, z, z->right);
+    } else if (z->right == &t->nil) {
+        x = z->left;
+        rb_transplant(t, z, z->left);
+    } else {
+        y = rb_minimum(t, z->right);
+        y_was_red = y->red;
+        x = y->right;
+        if (y->parent == z) {
+            x->parent = y;
+        } else {
+            rb_transplant(t, y, y->right);
+            y->right = z->right;
+            y->right->parent = y;
+        }
+        rb_transplant(t, z, y);
+        y->left = z->left;
+        y->left->parent = y;
+        y->red = z->red;
+    }
+    if (!y_was_red) rb_erase_fixup(t, x);
+
+    t->count--;
+    t->total_weight -= z->weight;
+}
+
+// Ideal slice of an entity: its weighted share of the scheduling period
+static sim_time_t cfs_slice(const cfs_entity_t *e, const cfs_tree_t *t,
+                            sim_time_t latency, sim_time_t min_gran) {
+    long long nr = t->count + 1;
+    sim_time_t period = latency;
+    if (nr * min_gran > latency) period = nr * min_gran;
+
+    sim_time_t slice = period * e->weight / (t->total_weight + e->weight);
+    if (slice < min_gran) slice = min_gran;
+    return slice;
+}
+
+// Put an entity where its current operation can be served (no-op when stuck or done)
+static void cfs_make_ready(cfs_entity_t *e, cfs_tree_t *tree, sim_active_t *set) {
+    if (e->op_idx >= e->proc.operations_count) return;
+
+    process_operation_t op = e->proc.descriptor_p[e->op_idx].operation_p;
+    if (op == calc_p) rb_insert(tree, e);
+    else if (op == IO_p) sim_active_io_push(set, e->idx);
+}
+
+void cfs_sched(process_queue *p, process_descriptor_t **descriptor, int *size,
+               const cfs_params_t *params, sim_run_t *run) {
+    if (!p || p->size == 0) return;
+
+    sim_time_t latency = (params && params->target_latency > 0)
+                             ? params->target_latency : CFS_DEFAULT_LATENCY;
+    sim_time_t min_gran = (params && params->min_granularity > 0)
+                              ? params->min_granularity : CFS_DEFAULT_MIN_GRANULARITY;
+    if (min_gran > latency) min_gran = latency;
+
+    int n = p->size;
+    cfs_entity_t *ents = calloc(n, sizeof(cfs_entity_t));
+    sim_active_t set;
+    if (!ents || !sim_active_init(&set, p)) {
+        free(ents);
+        return;
+    }
+
+    int idx = 0;
+    for (node_t *node = p->head; node != NULL; node = node->next, idx++) {
+        cfs_entity_t *e = &ents[idx];
+        e->proc = node->proc;
+        e->idx = idx;
+        e->weight = cfs_weight(node->proc.priority_p);
+        e->op_idx = 0;
+        e->op_remaining = (node->proc.operations_count > 0) ?
+                              node->proc.descriptor_p[0].duration_op : 0;
+    }
+
+    cfs_tree_t tree;
+    rb_init(&tree);
+
+    cfs_entity_t *curr = NULL;        // Process holding the CPU
+    sim_time_t min_vruntime = 0;      // Monotonic floor for new/woken entities
+
+    sim_time_t current_time = 0;
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
+
+    while (set.finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
+
+        // Admit arrivals: new entities start at the current minimum vruntime
+        for (int a; (a = sim_active_admit(&set, current_time)) >= 0;) {
+            ents[a].vruntime = min_vruntime;
+            cfs_make_ready(&ents[a], &tree, &set);
+        }
+
+        // Preempt the current process once it used its slice or fell too far behind
+        if (curr && tree.leftmost) {
+            sim_time_t ideal = cfs_slice(curr, &tree, latency, min_gran);
+            if (curr->slice_used >= ideal ||
+                (curr->slice_used >= min_gran &&
+                 curr->vruntime - tree.leftmost->vruntime > ideal * CFS_VRUNTIME_SCALE)) {
+                rb_insert(&tree, curr);
+                curr = NULL;
+            }
+        }
+
+        // Pick the runnable entity with the smallest vruntime
+        if (!curr && tree.leftmost) {
+            curr = tree.leftmost;
+            rb_erase(&tree, curr);
+            curr->slice_used = 0;
+        }
+
+        cfs_entity_t *cpu_ran = curr;
+        cfs_entity_t *io_ran = (set.io_head >= 0) ? &ents[set.io_head] : NULL;
+
+        // Execute CPU operation
+        if (cpu_ran) {
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, cpu_ran->idx, calc_p,
+                                                  &cpu_ran->op_idx, &cpu_ran->op_remaining, current_time);
+            cpu_ran->slice_used++;
+            cpu_ran->vruntime += (sim_time_t)CFS_VRUNTIME_SCALE * CFS_NICE_0_WEIGHT / cpu_ran->weight;
+
+            // Operation completed: leave the CPU
+            if (r != sim_op_continues) curr = NULL;
+            if (r == sim_op_next) cfs_make_ready(cpu_ran, &tree, &set);
+        }
+
+        // Execute I/O operation (one device, served in FIFO order)
+        if (io_ran) {
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, io_ran->idx, IO_p,
+                                                  &io_ran->op_idx, &io_ran->op_remaining, current_time);
+
+            // I/O completed: wake up with a bounded sleeper credit
+            if (r != sim_op_continues) sim_active_io_pop(&set);
+            if (r == sim_op_next) {
+                sim_time_t floor = min_vruntime - latency * CFS_VRUNTIME_SCALE / 2;
+                if (io_ran->vruntime < floor) io_ran->vruntime = floor;
+                cfs_make_ready(io_ran, &tree, &set);
+            }
+        }
+
+        // Advance min_vruntime (never backwards)
+        if (curr || tree.leftmost) {
+            sim_time_t candidate = curr ? curr->vruntime : tree.leftmost->vruntime;
+            if (tree.leftmost && tree.leftmost->vruntime < candidate)
+                candidate = tree.leftmost->vruntime;
+            if (candidate > min_vruntime) min_vruntime = candidate;
+        }
+
+        if (!sim_active_end_tick(&set, run, descriptor, size, cpu_ran ? cpu_ran->idx : -1,
+                                 io_ran ? io_ran->idx : -1, &current_time, &status)) {
+            break;
+        }
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = set.finished;
+        run->total = n;
+    }
+
+    free(ents);
+    sim_active_free(&set);
+}
@@ -0,0 +1,403 @@
+#define _POSIX_C_SOURCE 200809L
+#include "checkpoint.h"
+#include "name_table.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PROC_RECORD_SIZE 41
+#define METRICS_RECORD_SIZE 53
+
+void checkpoint_init(sim_checkpoint_t* cp) {
+    memset(cp, 0, sizeof(*cp));
+    cp->last_cpu = -1;
+}
+
+void checkpoint_free(sim_checkpoint_t* cp) {
+    free(cp->procs);
+    free(cp->cursors);
+    free(cp->metrics_proc);
+    free(cp->stats);
+    free(cp->last_time);
+    free(cp->last_code);
+    free(cp->first_run);
+    checkpoint_init(cp);
+}
+
+static uint64_t fnv(uint64_t h, const void* data, size_t length) {
+    const unsigned char* p = data;
+    for (size_t i = 0; i < length; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static uint64_t fnv_i64(uint64_t h, int64_t v) {
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = (unsigned char)((uint64_t)v >> (8 * i));
+    return fnv(h, bytes, sizeof(bytes));
+}
+
+uint64_t checkpoint_fingerprint(const process_queue* queue) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (const node_t* node = queue->head; node; node = node->next) {
+        const process_t* proc = &node->proc;
+        h = fnv(h, proc->process_name, strlen(proc->process_name) + 1);
+        h = fnv_i64(h, proc->arrival_time_p);
+        h = fnv_i64(h, proc->priority_p);
+        h = fnv_i64(h, proc->tickets);
+        h = fnv_i64(h, proc->deadline);
+        for (int i = 0; i < proc->operations_count; i++) {
+            h = fnv_i64(h, proc->descriptor_p[i].operation_p);
+            h = fnv_i64(h, proc->descriptor_p[i].duration_op);
+        }
+    }
+    return h;
+}
+
+// Process states and round-robin positions within the workload's bounds, so a
+// damaged snapshot cannot send a scheduler out of its arrays or into an endless run
+static int checkpoint_in_range(const sim_checkpoint_t* cp, const process_queue* queue) {
+    if (cp->time < 0) return 0;
+    int i = 0, terminated = 0;
+    for (const node_t* node = queue->head; node; node = node->next, i++) {
+        const checkpoint_proc_t* ps = &cp->procs[i];
+        if (ps->op_idx < 0 || ps->op_idx > node->proc.operations_count) return 0;
+        if (ps->op_idx < node->proc.operations_count &&
+            (ps->op_remaining <= 0 || ps->op_remaining > node->proc.descriptor_p[ps->op_idx].duration_op)) {
+            return 0;
+        }
+        if (ps->io_until >= 0 && (ps->op_idx == node->proc.operations_count ||
+                                  ps->io_until > cp->time + node->proc.descriptor_p[ps->op_idx].duration_op)) {
+            return 0;
+        }
+        if (ps->io_until < -1 || ps->slice_used < 0 || ps->waited < 0) return 0;
+        if (ps->terminated) terminated++;
+    }
+    if (terminated != cp->finished) return 0;
+    for (int p = 0; cp->has_metrics && p < cp->metrics_count; p++) {
+        const trace_proc_stats_t* st = &cp->stats[p];
+        if (cp->metrics_proc[p] < 0 || cp->metrics_proc[p] >= queue->size ||
+            st->start_time < 0 || st->start_time > st->end_time || st->end_time > cp->time ||
+            cp->last_time[p] < st->start_time || cp->last_time[p] > st->end_time ||
+            cp->first_run[p] < -1 || cp->first_run[p] > st->end_time ||
+            st->total_wait < 0 || st->total_wait > cp->time ||
+            st->total_run < 0 || st->total_run > cp->time) {
+            return 0;
+        }
+    }
+    if (cp->records < 0 || cp->cpu_ticks < 0 || cp->io_ticks < 0 || cp->context_switches < 0 ||
+        cp->last_cpu < -1 || cp->last_cpu >= cp->metrics_count) {
+        return 0;
+    }
+    for (int k = 0; k < cp->cursor_count; k++) {
+        if (cp->cursors[k] < -1 || cp->cursors[k] >= queue->size) return 0;
+    }
+    return 1;
+}
+
+int checkpoint_compatible(const sim_checkpoint_t* cp, int policy, const process_queue* queue) {
+    if (cp->policy != policy) {
+        fprintf(stderr, "Error: the checkpoint was taken by policy %d, not %d\n", cp->policy, policy);
+        return 0;
+    }
+    if (cp->count != queue->size || cp->fingerprint != checkpoint_fingerprint(queue)) {
+        fprintf(stderr, "Error: the checkpoint was taken on a different workload\n");
+        return 0;
+    }
+    if (!checkpoint_in_range(cp, queue)) {
+        fprintf(stderr, "Error: the checkpoint's state does not fit the workload\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Workload index of every process name (names are compared by pointer)
+static int index_workload(name_table_t* table, const process_queue* queue) {
+    name_table_init(table);
+    for (const node_t* node = queue->head; node; node = node->next) {
+        int added = 0;
+        if (name_table_id(table, node->proc.process_name, &added) < 0) return 0;
+    }
+    return 1;
+}
+
+static int save_metrics(sim_checkpoint_t* cp, const sim_metrics_t* metrics, const process_queue* queue) {
+    int n = metrics->procs.count;
+    cp->metrics_proc = malloc((n > 0 ? n : 1) * sizeof(int));
+    cp->stats = malloc((n > 0 ? n : 1) * sizeof(trace_proc_stats_t));
+    cp->last_time = malloc((n > 0 ? n : 1) * sizeof(sim_time_t));
+    cp->last_code = malloc(n > 0 ? n : 1);
+    cp->first_run = malloc((n > 0 ? n : 1) * sizeof(sim_time_t));
+    name_table_t workload;
+    int ok = (cp->metrics_proc && cp->stats && cp->last_time && cp->last_code && cp->first_run &&
+              index_workload(&workload, queue));
+    for (int p = 0; ok && p < n; p++) {
+        int added = 0;
+        int index = name_table_id(&workload, metrics->procs.names[p], &added);
+        if (index < 0 || added) ok = 0;   // Not a process of this workload
+        cp->metrics_proc[p] = index;
+    }
+    if (ok) {
+        memcpy(cp->stats, metrics->stats, n * sizeof(trace_proc_stats_t));
+        memcpy(cp->last_time, metrics->last_time, n * sizeof(sim_time_t));
+        memcpy(cp->last_code, metrics->last_code, n);
+        memcpy(cp->first_run, metrics->first_run, n * sizeof(sim_time_t));
+        cp->metrics_count = n;
+        cp->records = metrics->records;
+        cp->cpu_ticks = metrics->cpu_ticks;
+        cp->io_ticks = metrics->io_ticks;
+        cp->last_cpu = metrics->last_cpu;
+        cp->context_switches = metrics->context_switches;
+        cp->has_metrics = 1;
+    }
+    name_table_free(&workload);
+    return ok;
+}
+
+static void load_metrics(const sim_checkpoint_t* cp, sim_metrics_t* metrics, const process_queue* queue) {
+    const char** names = malloc((queue->size > 0 ? queue->size : 1) * sizeof(char*));
+    int n = cp->metrics_count;
+    if (!names || (n > 0 && !sim_metrics_reserve(metrics, n - 1))) {
+        free(names);
+        metrics->error = 1;
+        return;
+    }
+    int i = 0;
+    for (const node_t* node = queue->head; node; node = node->next) names[i++] = node->proc.process_name;
+
+    for (int p = 0; p < n; p++) {
+        int added = 0;
+        if (name_table_id(&metrics->procs, names[cp->metrics_proc[p]], &added) != p || !added) {
+            metrics->error = 1;
+            break;
+        }
+    }
+    free(names);
+    if (metrics->error) return;
+    memcpy(metrics->stats, cp->stats, n * sizeof(trace_proc_stats_t));
+    memcpy(metrics->last_time, cp->last_time, n * sizeof(sim_time_t));
+    memcpy(metrics->last_code, cp->last_code, n);
+    memcpy(metrics->first_run, cp->first_run, n * sizeof(sim_time_t));
+    metrics->records = cp->records;
+    metrics->cpu_ticks = cp->cpu_ticks;
+    metrics->io_ticks = cp->io_ticks;
+    metrics->last_cpu = cp->last_cpu;
+    metrics->context_switches = cp->context_switches;
+}
+
+const sim_checkpoint_t* checkpoint_resume(sim_run_t* run, int policy, const process_queue* queue,
+                                          int cursor_count) {
+    if (!run || !run->resume) return NULL;
+    const sim_checkpoint_t* cp = run->resume;
+    if (cp->policy != policy || cp->count != queue->size || cp->cursor_count != cursor_count ||
+        !checkpoint_in_range(cp, queue)) {
+        run->status = sim_resume_rejected;
+        run->end_time = 0;
+        run->finished = 0;
+        run->total = queue->size;
+        return NULL;
+    }
+    if (run->metrics && cp->has_metrics) load_metrics(cp, run->metrics, queue);
+    return cp;
+}
+
+sim_checkpoint_t* checkpoint_begin(sim_run_t* run, int policy, const process_queue* queue,
+                                   sim_time_t time, int finished, int cursor_count) {
+    if (!run || !run->checkpoint) return NULL;
+    sim_checkpoint_t* cp = run->checkpoint;
+    checkpoint_free(cp);
+    cp->count = queue->size;
+    cp->procs = calloc(cp->count > 0 ? cp->count : 1, sizeof(checkpoint_proc_t));
+    cp->cursors = calloc(cursor_count > 0 ? cursor_count : 1, sizeof(int64_t));
+    if (!cp->procs || !cp->cursors ||
+        (run->metrics && !run->metrics->error && !save_metrics(cp, run->metrics, queue))) {
+        checkpoint_free(cp);
+        return NULL;
+    }
+    cp->policy = policy;
+    cp->time = time;
+    cp->finished = finished;
+    cp->fingerprint = checkpoint_fingerprint(queue);
+    cp->cursor_count = cursor_count;
+    return cp;
+}
+
+static void put_bytes(FILE* fp, uint64_t v, int n, int* ok) {
+    unsigned char bytes[8];
+    for (int i = 0; i < n; i++) bytes[i] = (unsigned char)(v >> (8 * i));
+    if (fwrite(bytes, 1, n, fp) != (size_t)n) *ok = 0;
+}
+
+// Written to path.tmp, synced and renamed over path, so a crash or a full disk never
+// leaves a truncated snapshot behind
+int checkpoint_write(const sim_checkpoint_t* cp, const char* path) {
+    size_t length = strlen(path);
+    char* tmp = malloc(length + 5);
+    if (!tmp) return 0;
+    memcpy(tmp, path, length);
+    memcpy(tmp + length, ".tmp", 5);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) {
+        free(tmp);
+        return 0;
+    }
+    int ok = (fwrite(CHECKPOINT_MAGIC, 1, 8, fp) == 8);
+    put_bytes(fp, (uint32_t)cp->policy, 4, &ok);
+    put_bytes(fp, (uint32_t)cp->count, 4, &ok);
+    put_bytes(fp, (uint32_t)cp->cursor_count, 4, &ok);
+    put_bytes(fp, cp->has_metrics ? CHECKPOINT_HAS_METRICS : 0, 4, &ok);
+    put_bytes(fp, (uint64_t)cp->time, 8, &ok);
+    put_bytes(fp, (uint32_t)cp->finished, 4, &ok);
+    put_bytes(fp, cp->fingerprint, 8, &ok);
+    for (int i = 0; i < cp->count; i++) {
+        const checkpoint_proc_t* ps = &cp->procs[i];
+        put_bytes(fp, (uint32_t)ps->op_idx, 4, &ok);
+        put_bytes(fp, (uint64_t)ps->op_remaining, 8, &ok);
+        put_bytes(fp, (uint64_t)ps->io_until, 8, &ok);
+        put_bytes(fp, (uint64_t)(ps->terminated != 0), 1, &ok);
+        put_bytes(fp, (uint32_t)ps->priority, 4, &ok);
+        put_bytes(fp, (uint64_t)ps->slice_used, 8, &ok);
+        put_bytes(fp, (uint64_t)ps->waited, 8, &ok);
+    }
+    for (int i = 0; i < cp->cursor_count; i++) put_bytes(fp, (uint64_t)cp->cursors[i], 8, &ok);
+    if (cp->has_metrics) {
+        put_bytes(fp, (uint32_t)cp->metrics_count, 4, &ok);
+        put_bytes(fp, (uint64_t)cp->records, 8, &ok);
+        put_bytes(fp, (uint64_t)cp->cpu_ticks, 8, &ok);
+        put_bytes(fp, (uint64_t)cp->io_ticks, 8, &ok);
+        put_bytes(fp, (uint32_t)cp->last_cpu, 4, &ok);
+        put_bytes(fp, (uint64_t)cp->context_switches, 8, &ok);
+        for (int p = 0; p < cp->metrics_count; p++) {
+            put_bytes(fp, (uint32_t)cp->metrics_proc[p], 4, &ok);
+            put_bytes(fp, (uint64_t)cp->stats[p].start_time, 8, &ok);
+            put_bytes(fp, (uint64_t)cp->stats[p].end_time, 8, &ok);
+            put_bytes(fp, (uint64_t)cp->stats[p].total_wait, 8, &ok);
+            put_bytes(fp, (uint64_t)cp->stats[p].total_run, 8, &ok);
+            put_bytes(fp, (uint64_t)cp->last_time[p], 8, &ok);
+            put_bytes(fp, cp->last_code[p], 1, &ok);
+            put_bytes(fp, (uint64_t)cp->first_run[p], 8, &ok);
+        }
+    }
+    if (fflush(fp) != 0 || fsync(fileno(fp)) != 0) ok = 0;
+    if (fclose(fp) != 0) ok = 0;
+    if (ok && rename(tmp, path) != 0) ok = 0;
+    if (!ok) remove(tmp);
+    free(tmp);
+    return ok;
+}
+
+// Bounds-checked input; error is sticky and reads past the end return 0
+typedef struct cursor_t {
+    const unsigned char* pos;
+    const unsigned char* end;
+    int error;
+} cursor_t;
+
+static uint64_t get_bytes(cursor_t* c, int n) {
+    if (c->error || c->end - c->pos < n) {
+        c->error = 1;
+        return 0;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++) v |= (uint64_t)c->pos[i] << (8 * i);
+    c->pos += n;
+    return v;
+}
+
+static int read_file(const char* path, unsigned char** data, long* size) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+    int ok = (fseek(fp, 0, SEEK_END) == 0 && (*size = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0);
+    *data = ok ? malloc(*size > 0 ? *size : 1) : NULL;
+    ok = ok && *data && fread(*data, 1, *size, fp) == (size_t)*size;
+    fclose(fp);
+    if (!ok) {
+        free(*data);
+        *data = NULL;
+    }
+    return ok;
+}
+
+int checkpoint_read(sim_checkpoint_t* cp, const char* path) {
+    checkpoint_init(cp);
+    unsigned char* data = NULL;
+    long size = 0;
+    if (!read_file(path, &data, &size)) {
+        fprintf(stderr, "Error: cannot read checkpoint '%s'\n", path);
+        return 0;
+    }
+    cursor_t c = {data, data + size, 0};
+    if (size < 8 || memcmp(data, CHECKPOINT_MAGIC, 8) != 0) c.error = 1;
+    c.pos += 8;
+    cp->policy = (int)get_bytes(&c, 4);
+    uint32_t count = (uint32_t)get_bytes(&c, 4);
+    uint32_t cursors = (uint32_t)get_bytes(&c, 4);
+    uint32_t flags = (uint32_t)get_bytes(&c, 4);
+    cp->time = (sim_time_t)get_bytes(&c, 8);
+    cp->finished = (int)get_bytes(&c, 4);
+    cp->fingerprint = get_bytes(&c, 8);
+
+    // Sizes must fit the file before anything is allocated
+    if ((uint64_t)count * PROC_RECORD_SIZE + (uint64_t)cursors * 8 > (uint64_t)(c.end - c.pos)) c.error = 1;
+    if (!c.error) {
+        cp->count = (int)count;
+        cp->cursor_count = (int)cursors;
+        cp->procs = calloc(count > 0 ? count : 1, sizeof(checkpoint_proc_t));
+        cp->cursors = calloc(cursors > 0 ? cursors : 1, sizeof(int64_t));
+        if (!cp->procs || !cp->cursors) c.error = 1;
+    }
+    for (uint32_t i = 0; !c.error && i < count; i++) {
+        checkpoint_proc_t* ps = &cp->procs[i];
+        ps->op_idx = (int32_t)get_bytes(&c, 4);
+        ps->op_remaining = (sim_time_t)get_bytes(&c, 8);
+        ps->io_until = (sim_time_t)get_bytes(&c, 8);
+        ps->terminated = (int)get_bytes(&c, 1);
+        ps->priority = (int32_t)get_bytes(&c, 4);
+        ps->slice_used = (sim_time_t)get_bytes(&c, 8);
+        ps->waited = (sim_time_t)get_bytes(&c, 8);
+        if (ps->op_idx < 0) c.error = 1;
+    }
+    for (uint32_t i = 0; !c.error && i < cursors; i++) cp->cursors[i] = (int64_t)get_bytes(&c, 8);
+
+    if (!c.error && (flags & CHECKPOINT_HAS_METRICS)) {
+        uint32_t n = (uint32_t)get_bytes(&c, 4);
+        cp->records = (int64_t)get_bytes(&c, 8);
+        cp->cpu_ticks = (int64_t)get_bytes(&c, 8);
+        cp->io_ticks = (int64_t)get_bytes(&c, 8);
+        cp->last_cpu = (int32_t)get_bytes(&c, 4);
+        cp->context_switches = (int64_t)get_bytes(&c, 8);
+        if (n > count || (uint64_t)n * METRICS_RECORD_SIZE > (uint64_t)(c.end - c.pos)) c.error = 1;
+        if (!c.error) {
+            cp->metrics_proc = malloc((n > 0 ? n : 1) * sizeof(int));
+            cp->stats = malloc((n > 0 ? n : 1) * sizeof(trace_proc_stats_t));
+            cp->last_time = malloc((n > 0 ? n : 1) * sizeof(sim_time_t));
+            cp->last_code = malloc(n > 0 ? n : 1);
+            cp->first_run = malloc((n > 0 ? n : 1) * sizeof(sim_time_t));
+            if (!cp->metrics_proc || !cp->stats || !cp->last_time || !cp->last_code || !cp->first_run) c.error = 1;
+        }
+        for (uint32_t p = 0; !c.error && p < n; p++) {
+            cp->metrics_proc[p] = (int)get_bytes(&c, 4);
+            cp->stats[p].start_time = (sim_time_t)get_bytes(&c, 8);
+            cp->stats[p].end_time = (sim_time_t)get_bytes(&c, 8);
+            cp->stats[p].total_wait = (sim_time_t)get_bytes(&c, 8);
+            cp->stats[p].total_run = (sim_time_t)get_bytes(&c, 8);
+            cp->last_time[p] = (sim_time_t)get_bytes(&c, 8);
+            cp->last_code[p] = (unsigned char)get_bytes(&c, 1);
+            cp->first_run[p] = (sim_time_t)get_bytes(&c, 8);
+            if ((uint32_t)cp->metrics_proc[p] >= count) c.error = 1;
+        }
+        if (!c.error) {
+            cp->metrics_count = (int)n;
+            cp->has_metrics = 1;
+        }
+    }
+    free(data);
+    if (c.error || c.pos != c.end) {
+        fprintf(stderr, "Error: '%s' is not a valid checkpoint\n", path);
+        checkpoint_free(cp);
+        return 0;
+    }
+    return 1;
+}
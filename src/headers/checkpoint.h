@@ -0,0 +1,101 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "basic_sched.h"
+#include "sim_metrics.h"
+
+// Snapshots of a scheduler's state, taken when a run stops at its horizon or is
+// cancelled. A run given the snapshot as run->resume continues from that time instead
+// of time 0. The trace records and metrics of the continuation are exactly those the
+// uninterrupted run would have produced from there on. A snapshot is only read on
+// resume, so many continuations (with other parameters, e.g. another quantum) can
+// branch from one warmed-up prefix.
+//
+// Supported by the array-based schedulers: FIFO, Round-Robin, Priority Preemptive,
+// Multi-level and Multi-level + Aging.
+//
+// File format (little-endian):
+//   header   "PSCHKPT1", u32 policy, u32 processes, u32 cursors, u32 flags,
+//            i64 time, u32 finished, u64 workload fingerprint
+//   process  i32 op index, i64 remaining, i64 I/O end, u8 terminated, i32 priority,
+//            i64 slice used, i64 waited   (one per process, in workload order)
+//   cursors  i64 each
+//   metrics  (flag 1) u32 processes, i64 records, i64 CPU ticks, i64 I/O ticks,
+//            i32 last CPU process, i64 context switches, then per process in order of
+//            first appearance: u32 workload index, i64 start, i64 end, i64 waiting,
+//            i64 running, i64 last time, u8 last code, i64 first CPU tick
+
+#define CHECKPOINT_MAGIC "PSCHKPT1"
+#define CHECKPOINT_HAS_METRICS 1
+
+// Policies that take snapshots, by menu number
+typedef enum checkpoint_policy_t {
+    checkpoint_fifo = 1,
+    checkpoint_round_robin = 2,
+    checkpoint_priority = 3,
+    checkpoint_multilevel = 4,
+    checkpoint_aging = 5
+} checkpoint_policy_t;
+
+// Scheduler state of one process
+typedef struct checkpoint_proc_t {
+    int op_idx;                // Current operation
+    sim_time_t op_remaining;   // Ticks left in it
+    sim_time_t io_until;       // End of the I/O in progress (-1 = none)
+    int terminated;
+    int priority;              // Current priority (aging promotes processes)
+    sim_time_t slice_used;     // CPU ticks of the current quantum (Round-Robin)
+    sim_time_t waited;         // Ticks waited since the last CPU tick (aging)
+} checkpoint_proc_t;
+
+typedef struct sim_checkpoint_t {
+    int policy;                // Menu number of the scheduler that wrote it
+    int count;                 // Processes, in workload order
+    sim_time_t time;           // The run continues from this tick
+    int finished;
+    uint64_t fingerprint;      // checkpoint_fingerprint() of the workload
+    checkpoint_proc_t* procs;
+    int64_t* cursors;          // Round-robin positions (one per priority level, or one)
+    int cursor_count;
+    int has_metrics;           // The run's metrics accumulator up to time
+    int metrics_count;
+    int64_t records;
+    int64_t cpu_ticks;
+    int64_t io_ticks;
+    int last_cpu;
+    int64_t context_switches;
+    int* metrics_proc;         // Workload index of each metrics process
+    trace_proc_stats_t* stats;
+    sim_time_t* last_time;
+    unsigned char* last_code;
+    sim_time_t* first_run;
+} sim_checkpoint_t;
+
+void checkpoint_init(sim_checkpoint_t* cp);
+void checkpoint_free(sim_checkpoint_t* cp);
+
+// Hash of the workload's names, arrivals, priorities and operations
+uint64_t checkpoint_fingerprint(const process_queue* queue);
+
+// 1 when a run of policy (menu number) on queue can resume from cp; otherwise a
+// message goes to stderr
+int checkpoint_compatible(const sim_checkpoint_t* cp, int policy, const process_queue* queue);
+
+int checkpoint_write(const sim_checkpoint_t* cp, const char* path);   // 0 on error
+int checkpoint_read(sim_checkpoint_t* cp, const char* path);          // 0 (with a message) on error
+
+// For schedulers. checkpoint_resume() returns run->resume when it was written by
+// policy for this many processes and cursors, after loading its metrics into
+// run->metrics (which must be freshly initialized); NULL otherwise. A snapshot that
+// does not fit sets run->status to sim_resume_rejected, and the scheduler then
+// returns without simulating.
+const sim_checkpoint_t* checkpoint_resume(sim_run_t* run, int policy, const process_queue* queue,
+                                          int cursor_count);
+
+// Start the snapshot of a run that stops before completing: returns run->checkpoint
+// with the common fields and metrics filled and room for the processes and cursors,
+// or NULL when the run wants no snapshot (or memory ran out, setting policy to 0)
+sim_checkpoint_t* checkpoint_begin(sim_run_t* run, int policy, const process_queue* queue,
+                                   sim_time_t time, int finished, int cursor_count);
+
+#endif
@@ -0,0 +1,157 @@
+#include "chrome_trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CHROME_PID_PROCS 1
+#define CHROME_PID_DEVICES 2
+#define CHROME_TID_CPU 1
+#define CHROME_TID_IO 2
+
+// Slice names of the process tracks (compared by pointer when merging)
+static const char STATE_CALC[] = "CALC";
+static const char STATE_IO[] = "I/O";
+static const char STATE_WAIT[] = "Wait";
+
+static void begin_event(chrome_trace_t* trace) {
+    writer_puts(&trace->out, trace->events++ ? ",\n" : "\n");
+}
+
+// JSON string body (quotes and control characters escaped)
+static void write_json_string(buffered_writer_t* out, const char* text) {
+    writer_puts(out, "\"");
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            char escaped[2] = { '\\', (char)*c };
+            writer_write(out, escaped, 2);
+        } else if (*c < 0x20) {
+            writer_printf(out, "\\u%04x", *c);
+        } else {
+            writer_write(out, c, 1);
+        }
+    }
+    writer_puts(out, "\"");
+}
+
+static void write_metadata(chrome_trace_t* trace, const char* kind, int pid, int tid, const char* name) {
+    begin_event(trace);
+    writer_printf(&trace->out, "{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+                  kind, pid, tid);
+    write_json_string(&trace->out, name);
+    writer_puts(&trace->out, "}}");
+}
+
+static void close_slice(chrome_trace_t* trace, chrome_slice_t* slice, int pid, int tid) {
+    if (!slice->name) return;
+    begin_event(trace);
+    writer_puts(&trace->out, "{\"name\":");
+    write_json_string(&trace->out, slice->name);
+    writer_printf(&trace->out, ",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%lld,\"dur\":%lld}",
+                  pid, tid, (long long)slice->start * CHROME_TICK_US,
+                  (long long)(slice->last - slice->start + 1) * CHROME_TICK_US);
+    slice->name = NULL;
+}
+
+// Extend the open slice when name continues at the next tick, otherwise start a new one
+static void extend_slice(chrome_trace_t* trace, chrome_slice_t* slice, int pid, int tid,
+                         const char* name, sim_time_t t) {
+    if (slice->name == name && t == slice->last + 1) {
+        slice->last = t;
+        return;
+    }
+    if (slice->name && t == slice->last) return;   // Duplicate tick
+    close_slice(trace, slice, pid, tid);
+    slice->name = name;
+    slice->start = slice->last = t;
+}
+
+static void write_counter(chrome_trace_t* trace, sim_time_t t, int value) {
+    begin_event(trace);
+    writer_printf(&trace->out, "{\"name\":\"waiting\",\"ph\":\"C\",\"pid\":%d,\"ts\":%lld,"
+                  "\"args\":{\"processes\":%d}}",
+                  CHROME_PID_DEVICES, (long long)t * CHROME_TICK_US, value);
+    trace->waiting_shown = value;
+}
+
+// Write the waiting count of the finished tick (and a drop to 0 across idle gaps)
+static void finish_tick(chrome_trace_t* trace, sim_time_t next) {
+    if (trace->waiting != trace->waiting_shown) write_counter(trace, trace->tick, trace->waiting);
+    if (next > trace->tick + 1 && trace->waiting_shown != 0) write_counter(trace, trace->tick + 1, 0);
+    trace->tick = next;
+    trace->waiting = 0;
+}
+
+int chrome_trace_open(chrome_trace_t* trace, const char* path) {
+    memset(trace, 0, sizeof(*trace));
+    if (!writer_open(&trace->out, path, "w")) return 0;
+    name_table_init(&trace->procs);
+
+    writer_puts(&trace->out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    write_metadata(trace, "process_name", CHROME_PID_PROCS, 0, "Processes");
+    write_metadata(trace, "process_name", CHROME_PID_DEVICES, 0, "Devices");
+    write_metadata(trace, "thread_name", CHROME_PID_DEVICES, CHROME_TID_CPU, "CPU");
+    write_metadata(trace, "thread_name", CHROME_PID_DEVICES, CHROME_TID_IO, "I/O");
+    return 1;
+}
+
+int chrome_trace_sink(void* ctx, const process_descriptor_t* record) {
+    chrome_trace_t* trace = ctx;
+    sim_time_t t = record->date;
+
+    if (t > trace->tick) finish_tick(trace, t);
+
+    int added;
+    int id = name_table_id(&trace->procs, record->process_name, &added);
+    if (id < 0) return 0;
+    if (added) {
+        if (id >= trace->slices_cap) {
+            int cap = trace->slices_cap ? trace->slices_cap * 2 : 64;
+            chrome_slice_t* slices = realloc(trace->proc_slices, cap * sizeof(chrome_slice_t));
+            if (!slices) return 0;
+            memset(slices + trace->slices_cap, 0, (cap - trace->slices_cap) * sizeof(chrome_slice_t));
+            trace->proc_slices = slices;
+            trace->slices_cap = cap;
+        }
+        write_metadata(trace, "thread_name", CHROME_PID_PROCS, id + 1, record->process_name);
+    }
+
+    chrome_slice_t* slice = &trace->proc_slices[id];
+    switch (record->state) {
+        case running_p:
+            if (record->operation == calc_p) {
+                extend_slice(trace, slice, CHROME_PID_PROCS, id + 1, STATE_CALC, t);
+                extend_slice(trace, &trace->cpu, CHROME_PID_DEVICES, CHROME_TID_CPU, record->process_name, t);
+            } else {
+                extend_slice(trace, slice, CHROME_PID_PROCS, id + 1, STATE_IO, t);
+                extend_slice(trace, &trace->io, CHROME_PID_DEVICES, CHROME_TID_IO, record->process_name, t);
+            }
+            break;
+        case waiting_p:
+            extend_slice(trace, slice, CHROME_PID_PROCS, id + 1, STATE_WAIT, t);
+            trace->waiting++;
+            break;
+        case terminated_p:
+            close_slice(trace, slice, CHROME_PID_PROCS, id + 1);
+            begin_event(trace);
+            writer_printf(&trace->out, "{\"name\":\"terminated\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,"
+                          "\"tid\":%d,\"ts\":%lld}",
+                          CHROME_PID_PROCS, id + 1, (long long)t * CHROME_TICK_US);
+            break;
+        default:
+            break;
+    }
+    return !trace->out.error;
+}
+
+int chrome_trace_close(chrome_trace_t* trace) {
+    finish_tick(trace, trace->tick + 1);
+    for (int id = 0; id < trace->procs.count; id++) {
+        close_slice(trace, &trace->proc_slices[id], CHROME_PID_PROCS, id + 1);
+    }
+    close_slice(trace, &trace->cpu, CHROME_PID_DEVICES, CHROME_TID_CPU);
+    close_slice(trace, &trace->io, CHROME_PID_DEVICES, CHROME_TID_IO);
+    writer_puts(&trace->out, "\n]}\n");
+
+    free(trace->proc_slices);
+    name_table_free(&trace->procs);
+    return writer_close(&trace->out);
+}
@@ -0,0 +1,40 @@
+#ifndef CHROME_TRACE_H
+#define CHROME_TRACE_H
+
+#include "basic_sched.h"
+#include "buffered_writer.h"
+#include "name_table.h"
+
+#define CHROME_TICK_US 1000   // One simulated tick is shown as 1 ms
+
+// Consecutive ticks of one track in the same state, not written yet
+typedef struct chrome_slice_t {
+    const char* name;          // NULL = no open slice
+    sim_time_t start;
+    sim_time_t last;
+} chrome_slice_t;
+
+// Streaming Chrome Trace Event (JSON) exporter, usable as a sim_sink_t.
+// Tracks: one per process (pid 1), the CPU and the I/O device (pid 2), plus a
+// counter of waiting processes. Slices are merged on the fly, so memory only
+// grows with the number of processes, never with the trace length.
+typedef struct chrome_trace_t {
+    buffered_writer_t out;
+    int events;                // Events written (comma placement)
+    name_table_t procs;
+    chrome_slice_t* proc_slices;
+    int slices_cap;
+    chrome_slice_t cpu;
+    chrome_slice_t io;
+    sim_time_t tick;           // Tick whose waiting count is being accumulated
+    int waiting;
+    int waiting_shown;         // Last counter value written
+} chrome_trace_t;
+
+int chrome_trace_open(chrome_trace_t* trace, const char* path);
+int chrome_trace_close(chrome_trace_t* trace);   // 0 when any write failed
+
+// sim_sink_t adapter (ctx = chrome_trace_t); returns 0 once the output failed
+int chrome_trace_sink(void* ctx, const process_descriptor_t* record);
+
+#endif
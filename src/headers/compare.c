@@ -0,0 +1,135 @@
+#define _POSIX_C_SOURCE 200809L
+#include "compare.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct compare_worker_t {
+    process_queue* queue;
+    sim_time_t horizon;
+    uint64_t seed;
+    experiment_policy_fn policy;
+    void* ctx;
+    compare_row_t* row;
+} compare_worker_t;
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* compare_worker_main(void* arg) {
+    compare_worker_t* w = arg;
+    sim_run_t run;
+    sim_run_init(&run, w->horizon);
+    sim_metrics_t metrics;
+    sim_metrics_init(&metrics);
+    run.trace_level = trace_none;
+    run.metrics = &metrics;
+
+    double start = wall_seconds();
+    w->policy(w->ctx, w->row->choice, w->queue, w->seed, &run);
+    w->row->wall_seconds = wall_seconds() - start;
+
+    w->row->status = run.status;
+    w->row->end_time = run.end_time;
+    w->row->finished = run.finished;
+    w->row->total = run.total;
+    w->row->error = metrics.error;
+    sim_metrics_summarize(&metrics, run.end_time, &w->row->summary);
+    sim_metrics_free(&metrics);
+    return NULL;
+}
+
+int compare_run(process_queue* queue, const int* choices, int count, sim_time_t horizon,
+                uint64_t seed, experiment_policy_fn policy, void* ctx, compare_row_t* rows) {
+    compare_worker_t* workers = calloc(count > 0 ? count : 1, sizeof(compare_worker_t));
+    pthread_t* ids = calloc(count > 0 ? count : 1, sizeof(pthread_t));
+    int* started = calloc(count > 0 ? count : 1, sizeof(int));
+    if (!workers || !ids || !started) {
+        free(workers);
+        free(ids);
+        free(started);
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        memset(&rows[i], 0, sizeof(rows[i]));
+        rows[i].choice = choices[i];
+        workers[i] = (compare_worker_t){queue, horizon, seed, policy, ctx, &rows[i]};
+        started[i] = (pthread_create(&ids[i], NULL, compare_worker_main, &workers[i]) == 0);
+        if (!started[i]) compare_worker_main(&workers[i]);   // Run it here instead
+    }
+    for (int i = 0; i < count; i++) {
+        if (started[i]) pthread_join(ids[i], NULL);
+    }
+    free(workers);
+    free(ids);
+    free(started);
+    return 1;
+}
+
+const char* compare_status_text(sim_status_t status) {
+    switch (status) {
+        case sim_horizon_reached: return "reached the horizon";
+        case sim_stalled: return "stalled";
+        case sim_cancelled: return "was cancelled";
+        case sim_resume_rejected: return "could not resume";
+        default: return "completed";
+    }
+}
+
+static const char* const column_names[COMPARE_COLUMNS] = {
+    "Avg wait", "P99 wait", "Avg turn", "P99 turn", "Avg resp", "P99 resp",
+    "CPU %", "I/O %", "Thru/1k", "Switches", "Wall ms"
+};
+
+const char* compare_column_name(int column) {
+    return (column >= 0 && column < COMPARE_COLUMNS) ? column_names[column] : "";
+}
+
+static double column_value(const compare_row_t* row, int column) {
+    const sim_metrics_summary_t* s = &row->summary;
+    switch (column) {
+        case 0: return s->mean_waiting;
+        case 1: return (double)s->p99_waiting;
+        case 2: return s->mean_turnaround;
+        case 3: return (double)s->p99_turnaround;
+        case 4: return s->mean_response;
+        case 5: return (double)s->p99_response;
+        case 6: return s->utilization * 100;
+        case 7: return s->io_utilization * 100;
+        case 8: return s->throughput * 1000;
+        case 9: return (double)s->context_switches;
+        default: return row->wall_seconds * 1000;
+    }
+}
+
+void compare_cell(const compare_row_t* row, int column, char* text, size_t size) {
+    double value = column_value(row, column);
+    switch (column) {
+        case 1:
+        case 3:
+        case 5:
+        case 9:
+            snprintf(text, size, "%.0f", value);
+            break;
+        case 10:
+            snprintf(text, size, "%.3f", value);
+            break;
+        default:
+            snprintf(text, size, "%.2f", value);
+            break;
+    }
+}
+
+int compare_is_best(const compare_row_t* rows, int count, int column, int row) {
+    int higher = (column == 6 || column == 7 || column == 8);
+    double value = column_value(&rows[row], column);
+    for (int i = 0; i < count; i++) {
+        double v = column_value(&rows[i], column);
+        if (higher ? v > value : v < value) return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,40 @@
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include "basic_sched.h"
+#include "sim_metrics.h"
+#include "experiment.h"
+
+// Side-by-side comparison: every policy runs on the same parsed workload at the same
+// time, one thread each, keeping no trace (trace_none and a metrics accumulator).
+// Schedulers only read the queue, so the threads share it.
+
+typedef struct compare_row_t {
+    int choice;                // Policy number as in the menu
+    const char* name;
+    sim_status_t status;
+    sim_time_t end_time;
+    int finished;
+    int total;
+    sim_metrics_summary_t summary;
+    double wall_seconds;       // Simulation time of this policy alone
+    int error;                 // Out of memory: the summary is incomplete
+} compare_row_t;
+
+// Run choices[i] into rows[i] (names are left to the caller); 0 when out of memory
+int compare_run(process_queue* queue, const int* choices, int count, sim_time_t horizon,
+                uint64_t seed, experiment_policy_fn policy, void* ctx, compare_row_t* rows);
+
+// Metric columns of the comparison table, shared by the text and ncurses views
+#define COMPARE_COLUMNS 11
+
+const char* compare_column_name(int column);
+void compare_cell(const compare_row_t* row, int column, char* text, size_t size);
+
+// How a run ended, for notes under the table ("stalled", ...)
+const char* compare_status_text(sim_status_t status);
+
+// No row has a better value in this column (lower, or higher for utilizations and throughput)
+int compare_is_best(const compare_row_t* rows, int count, int column, int row);
+
+#endif
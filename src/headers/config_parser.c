@@ -14,91 +14,202 @@ static char* trim(char* str) {
     return str;
 }
 
-int parse_config_file(const char* filename, process_queue* pqueue) {
-    FILE* fp = fopen(filename, "r");
-    if (!fp) {
-        fprintf(stderr, "Error: Cannot open configuration file '%s'\n", filename);
-        return -1;
+// Next blank-separated token of *cursor (strtok without its hidden state, so
+// threads can parse files at the same time); NULL at the end of the line
+static char* next_token(char** cursor) {
+    char* token = *cursor + strspn(*cursor, " \t");
+    if (*token == '\0') {
+        *cursor = token;
+        return NULL;
     }
+    char* end = token + strcspn(token, " \t");
+    *cursor = (*end != '\0') ? end + 1 : end;
+    *end = '\0';
+    return token;
+}
 
-    char line[MAX_LINE];
-    int line_num = 0;
-    int process_count = 0;
-
-    while (fgets(line, sizeof(line), fp)) {
-        line_num++;
-        char* trimmed = trim(line);
-        
-        
-        if (trimmed[0] == '\0' || trimmed[0] == '#') {
-            continue;
-        }
+// Processes of one configuration line (periodic tasks release several jobs);
+// -1 when the priority is out of range
+static int parse_line(char* line, int line_num, process_queue* pqueue) {
+    int count = 0;
+    char* trimmed = trim(line);
+    
+    
+    if (trimmed[0] == '\0' || trimmed[0] == '#') {
+        return 0;
+    }
 
-        
-        char name[64];
-        int arrival_time, priority;
-        
-        char* token = strtok(trimmed, " \t");
-        if (!token) continue;
-        strncpy(name, token, sizeof(name) - 1);
-        name[sizeof(name) - 1] = '\0';
-        
-        token = strtok(NULL, " \t");
-        if (!token) {
-            fprintf(stderr, "Warning: Line %d - Missing arrival time\n", line_num);
-            continue;
-        }
-        arrival_time = atoi(token);
-        
-        token = strtok(NULL, " \t");
-        if (!token) {
-            fprintf(stderr, "Warning: Line %d - Missing priority\n", line_num);
+    
+    char name[64];
+    sim_time_t arrival_time;
+    int priority;
+    
+    char* cursor = trimmed;
+    char* token = next_token(&cursor);
+    if (!token) return 0;
+    strncpy(name, token, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    
+    token = next_token(&cursor);
+    if (!token) {
+        fprintf(stderr, "Warning: Line %d - Missing arrival time\n", line_num);
+        return 0;
+    }
+    arrival_time = strtoll(token, NULL, 10);
+    if (arrival_time < 0) {
+        fprintf(stderr, "Warning: Line %d - Negative arrival time\n", line_num);
+        return 0;
+    }
+    
+    token = next_token(&cursor);
+    if (!token) {
+        fprintf(stderr, "Warning: Line %d - Missing priority\n", line_num);
+        return 0;
+    }
+    priority = atoi(token);
+    if (priority < SIM_PRIORITY_MIN || priority > SIM_PRIORITY_MAX) {
+        fprintf(stderr, "Warning: Line %d - Priority %d out of range (%d..%d)\n",
+                line_num, priority, SIM_PRIORITY_MIN, SIM_PRIORITY_MAX);
+        return -1;
+    }
+    
+    
+    operation_t ops[MAX_OPS];
+    int op_count = 0;
+    int tickets = 0;
+    sim_time_t deadline = 0;
+    sim_time_t period = 0;
+    int jobs = 1;
+    
+    while ((token = next_token(&cursor)) != NULL && op_count < MAX_OPS) {
+        // Optional key=value attributes may appear among the operations
+        char* eq = strchr(token, '=');
+        if (eq) {
+            *eq = '\0';
+            long long value = strtoll(eq + 1, NULL, 10);
+            if (strcmp(token, "tickets") == 0 && value > 0) {
+                tickets = (int)value;
+            } else if (strcmp(token, "deadline") == 0 && value > 0) {
+                deadline = value;
+            } else if (strcmp(token, "period") == 0 && value > 0) {
+                period = value;
+            } else if (strcmp(token, "jobs") == 0 && value > 0) {
+                jobs = (int)value;
+            } else {
+                fprintf(stderr, "Warning: Line %d - Ignoring attribute '%s=%s'\n",
+                        line_num, token, eq + 1);
+            }
             continue;
         }
-        priority = atoi(token);
-        
         
-        operation_t ops[MAX_OPS];
-        int op_count = 0;
+        char op_type[32];
+        long long duration;
         
-        while ((token = strtok(NULL, " \t")) != NULL && op_count < MAX_OPS) {
-            char op_type[32];
-            int duration;
-            
-            if (sscanf(token, "%[^:]:%d", op_type, &duration) == 2) {
-                if (strcmp(op_type, "calc") == 0) {
-                    ops[op_count].operation_p = calc_p;
-                } else if (strcmp(op_type, "io") == 0) {
-                    ops[op_count].operation_p = IO_p;
-                } else {
-                    ops[op_count].operation_p = none;
-                }
-                ops[op_count].duration_op = duration;
-                op_count++;
+        if (sscanf(token, "%31[^:]:%lld", op_type, &duration) == 2) {
+            if (duration <= 0) {
+                fprintf(stderr, "Warning: Line %d - Ignoring non-positive duration '%s'\n",
+                        line_num, token);
+                continue;
             }
+            if (strcmp(op_type, "calc") == 0) {
+                ops[op_count].operation_p = calc_p;
+            } else if (strcmp(op_type, "io") == 0) {
+                ops[op_count].operation_p = IO_p;
+            } else {
+                ops[op_count].operation_p = none;
+            }
+            ops[op_count].duration_op = duration;
+            op_count++;
         }
-        
-        if (op_count == 0) {
-            fprintf(stderr, "Warning: Line %d - No operations defined for process %s\n", line_num, name);
-            continue;
-        }
-        
-        
+    }
+    
+    if (op_count == 0) {
+        fprintf(stderr, "Warning: Line %d - No operations defined for process %s\n", line_num, name);
+        return 0;
+    }
+    
+    
+    // Periodic tasks release one job per period; deadlines default to the period
+    if (period == 0) jobs = 1;
+    if (period > 0 && deadline == 0) deadline = period;
+    
+    for (int job = 0; job < jobs; job++) {
         process_t proc;
-        proc.process_name = malloc(strlen(name) + 1);
-        strcpy(proc.process_name, name);
-        proc.arrival_time_p = arrival_time;
-        proc.begining_date = arrival_time;
+        if (period > 0) {
+            char job_name[96];
+            snprintf(job_name, sizeof(job_name), "%s#%d", name, job + 1);
+            proc.process_name = malloc(strlen(job_name) + 1);
+            strcpy(proc.process_name, job_name);
+        } else {
+            proc.process_name = malloc(strlen(name) + 1);
+            strcpy(proc.process_name, name);
+        }
+        proc.arrival_time_p = arrival_time + job * period;
+        proc.begining_date = proc.arrival_time_p;
         proc.priority_p = priority;
+        proc.tickets = tickets;
+        proc.deadline = deadline;
+        proc.period = period;
+        proc.job = job;
         proc.operations_count = op_count;
         proc.descriptor_p = malloc(op_count * sizeof(operation_t));
         memcpy(proc.descriptor_p, ops, op_count * sizeof(operation_t));
         
         add_tail(pqueue, proc);
-        process_count++;
+        count++;
+    }
+    return count;
+}
+
+static int parse_config(const char* filename, process_queue* pqueue, int verbose) {
+    FILE* fp = fopen(filename, "r");
+    if (!fp) {
+        fprintf(stderr, "Error: Cannot open configuration file '%s'\n", filename);
+        return -1;
+    }
+
+    char line[MAX_LINE];
+    int line_num = 0;
+    int process_count = 0;
+
+    while (fgets(line, sizeof(line), fp)) {
+        line_num++;
+        int added = parse_line(line, line_num, pqueue);
+        if (added > 0) process_count += added;
     }
 
     fclose(fp);
-    printf("Loaded %d processes from configuration file\n", process_count);
+    if (verbose) printf("Loaded %d processes from configuration file\n", process_count);
+    return process_count;
+}
+
+int parse_config_file(const char* filename, process_queue* pqueue) {
+    return parse_config(filename, pqueue, 1);
+}
+
+int parse_config_file_quiet(const char* filename, process_queue* pqueue) {
+    return parse_config(filename, pqueue, 0);
+}
+
+int parse_config_buffer(const char* text, size_t length, process_queue* pqueue) {
+    char line[MAX_LINE];
+    int line_num = 0;
+    int process_count = 0;
+    size_t pos = 0;
+
+    while (pos < length) {
+        // Lines longer than MAX_LINE are truncated
+        size_t end = pos;
+        while (end < length && text[end] != '\n') end++;
+        size_t n = end - pos;
+        if (n > sizeof(line) - 1) n = sizeof(line) - 1;
+        memcpy(line, text + pos, n);
+        line[n] = '\0';
+        pos = end + 1;
+        line_num++;
+        int added = parse_line(line, line_num, pqueue);
+        if (added < 0) return -1;
+        process_count += added;
+    }
     return process_count;
 }
@@ -5,4 +5,12 @@
 
 int parse_config_file(const char* filename, process_queue* pqueue);
 
+// Same without the "Loaded N processes" line (sweeps load thousands of files)
+int parse_config_file_quiet(const char* filename, process_queue* pqueue);
+
+// Same format from memory (length bytes of text, not NUL-terminated); quiet.
+// Unlike the file loaders, a line with an out-of-range priority fails the whole
+// buffer with -1 instead of being skipped (the processes added so far stay queued)
+int parse_config_buffer(const char* text, size_t length, process_queue* pqueue);
+
 #endif
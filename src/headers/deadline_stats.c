@@ -0,0 +1,165 @@
+#include "deadline_stats.h"
+#include <string.h>
+
+static const sim_time_t hist_edges[DEADLINE_HIST_BINS - 1] = { 0, 1, 2, 5, 10, 20, 50, 100 };
+static const char* hist_labels[DEADLINE_HIST_BINS] = {
+    "met", "(0,1]", "(1,2]", "(2,5]", "(5,10]", "(10,20]", "(20,50]", "(50,100]", ">100"
+};
+
+const char* deadline_histogram_label(int bin) {
+    return (bin >= 0 && bin < DEADLINE_HIST_BINS) ? hist_labels[bin] : "?";
+}
+
+static int compare_name(const void* a, const void* b) {
+    return strcmp(((const deadline_job_t*)a)->process_name, ((const deadline_job_t*)b)->process_name);
+}
+
+// Jobs with a known lateness first (finished or overdue), by decreasing lateness;
+// pending jobs last
+static int compare_lateness(const void* a, const void* b) {
+    const deadline_job_t* ja = a;
+    const deadline_job_t* jb = b;
+    int pa = (ja->completion < 0 && ja->lateness <= 0);
+    int pb = (jb->completion < 0 && jb->lateness <= 0);
+    if (pa != pb) return pa ? 1 : -1;
+    return (ja->lateness < jb->lateness) - (ja->lateness > jb->lateness);
+}
+
+static int compare_time(const void* a, const void* b) {
+    sim_time_t ta = *(const sim_time_t*)a;
+    sim_time_t tb = *(const sim_time_t*)b;
+    return (ta > tb) - (ta < tb);
+}
+
+// Job list and density of the deadline processes, sorted by name; 0 when there are none
+static int deadline_report_begin(process_queue* p, deadline_report_t* report) {
+    memset(report, 0, sizeof(*report));
+
+    for (node_t* cur = p->head; cur; cur = cur->next)
+        if (cur->proc.deadline > 0) report->jobs++;
+    if (report->jobs == 0) return 0;
+
+    report->list = malloc(report->jobs * sizeof(deadline_job_t));
+    int j = 0;
+    for (node_t* cur = p->head; cur; cur = cur->next) {
+        const process_t* proc = &cur->proc;
+        if (proc->deadline <= 0) continue;
+
+        report->list[j].process_name = proc->process_name;
+        report->list[j].abs_deadline = proc->arrival_time_p + proc->deadline;
+        report->list[j].completion = -1;
+        report->list[j].lateness = 0;
+        j++;
+
+        // Density test counts each task once (first job of a periodic task)
+        if (proc->job == 0) {
+            sim_time_t cpu = 0;
+            for (int k = 0; k < proc->operations_count; k++)
+                if (proc->descriptor_p[k].operation_p == calc_p)
+                    cpu += proc->descriptor_p[k].duration_op;
+            sim_time_t window = proc->deadline;
+            if (proc->period > 0 && proc->period < window) window = proc->period;
+            report->density += (double)cpu / (double)window;
+        }
+    }
+    report->density_schedulable = (report->density <= 1.0);
+
+    qsort(report->list, report->jobs, sizeof(deadline_job_t), compare_name);
+    return report->jobs;
+}
+
+// Termination of a process at time t. Among jobs of the same name, the one sharing
+// the name pointer (same run) wins, then the first still without a completion.
+static void deadline_report_complete(deadline_report_t* report, const char* name, sim_time_t t) {
+    deadline_job_t key;
+    key.process_name = name;
+    deadline_job_t* job = bsearch(&key, report->list, report->jobs, sizeof(deadline_job_t), compare_name);
+    if (!job) return;
+
+    deadline_job_t* first = job;
+    deadline_job_t* last = job;
+    while (first > report->list && strcmp(first[-1].process_name, name) == 0) first--;
+    while (last + 1 < report->list + report->jobs && strcmp(last[1].process_name, name) == 0) last++;
+
+    deadline_job_t* open = NULL;
+    for (job = first; job <= last; job++) {
+        if (job->process_name == name) {
+            job->completion = t;
+            return;
+        }
+        if (!open && job->completion < 0) open = job;
+    }
+    if (open) open->completion = t;
+}
+
+// Lateness of every job, counts, percentiles and histogram. A job still unfinished
+// when the run ended past its deadline is missed, late by at least end_time - deadline.
+static void deadline_report_finish(deadline_report_t* report, sim_time_t end_time) {
+    sim_time_t* lateness = malloc(report->jobs * sizeof(sim_time_t));
+    int known = 0;
+    double total = 0;
+    for (int k = 0; k < report->jobs; k++) {
+        deadline_job_t* job = &report->list[k];
+        if (job->completion < 0) {
+            report->unfinished++;
+            if (job->abs_deadline >= end_time) continue;
+            report->overdue++;
+            job->lateness = end_time - job->abs_deadline;
+        } else {
+            job->lateness = job->completion - job->abs_deadline;
+        }
+        lateness[known++] = job->lateness;
+        total += (double)job->lateness;
+
+        if (job->lateness <= 0) report->met++;
+        else report->missed++;
+
+        int bin = 0;
+        while (bin < DEADLINE_HIST_BINS - 1 && job->lateness > hist_edges[bin]) bin++;
+        report->histogram[bin]++;
+    }
+
+    if (known > 0) {
+        qsort(lateness, known, sizeof(sim_time_t), compare_time);
+        report->min_lateness = lateness[0];
+        report->max_lateness = lateness[known - 1];
+        report->mean_lateness = total / known;
+        report->p50_lateness = lateness[(known - 1) * 50 / 100];
+        report->p90_lateness = lateness[(known - 1) * 90 / 100];
+        report->p99_lateness = lateness[(known - 1) * 99 / 100];
+    }
+    free(lateness);
+
+    qsort(report->list, report->jobs, sizeof(deadline_job_t), compare_lateness);
+}
+
+int compute_deadline_report(process_queue* p, const trace_source_t* trace, sim_time_t end_time,
+                            deadline_report_t* report) {
+    if (!deadline_report_begin(p, report)) return 0;
+
+    process_descriptor_t d;
+    for (int i = 0; i < trace->size && trace_source_get(trace, i, &d); i++) {
+        if (d.state == terminated_p) deadline_report_complete(report, d.process_name, d.date);
+    }
+
+    deadline_report_finish(report, end_time);
+    return report->jobs;
+}
+
+int compute_deadline_report_metrics(process_queue* p, const sim_metrics_t* metrics, sim_time_t end_time,
+                                    deadline_report_t* report) {
+    if (!deadline_report_begin(p, report)) return 0;
+
+    for (int i = 0; i < metrics->procs.count; i++) {
+        if ((metrics->last_code[i] & 7) == terminated_p)
+            deadline_report_complete(report, metrics->procs.names[i], metrics->last_time[i]);
+    }
+
+    deadline_report_finish(report, end_time);
+    return report->jobs;
+}
+
+void free_deadline_report(deadline_report_t* report) {
+    free(report->list);
+    report->list = NULL;
+}
@@ -0,0 +1,52 @@
+#ifndef DEADLINE_STATS_H
+#define DEADLINE_STATS_H
+
+#include "basic_sched.h"
+#include "trace_index.h"
+#include "sim_metrics.h"
+
+// Lateness histogram: bin 0 = met (<= 0), then (0,1], (1,2], (2,5] ... (100,inf)
+#define DEADLINE_HIST_BINS 9
+
+typedef struct deadline_job_t {
+    const char* process_name;
+    sim_time_t abs_deadline;   // arrival + deadline
+    sim_time_t completion;     // Termination time, -1 if the job never finished
+    sim_time_t lateness;       // completion - abs_deadline; for an overdue job the lower
+                               // bound end_time - abs_deadline, 0 for a pending one
+} deadline_job_t;
+
+typedef struct deadline_report_t {
+    int jobs;                  // Processes with a deadline
+    int met;
+    int missed;                // Including the overdue unfinished jobs
+    int unfinished;            // Run cut short before the job terminated
+    int overdue;               // Unfinished jobs whose deadline passed before the run ended
+    sim_time_t min_lateness;   // Over finished and overdue jobs (overdue ones as lower bounds)
+    sim_time_t max_lateness;
+    double mean_lateness;
+    sim_time_t p50_lateness;
+    sim_time_t p90_lateness;
+    sim_time_t p99_lateness;
+    int histogram[DEADLINE_HIST_BINS];
+    double density;            // Sum of C / min(D, P) over tasks (CPU demand only)
+    int density_schedulable;   // density <= 1: EDF meets every deadline without I/O
+    deadline_job_t* list;      // All jobs, latest (worst) first, pending ones last
+} deadline_report_t;
+
+// Build the report for the processes of a run that ended at end_time, from its trace;
+// returns the number of deadline jobs. Termination records are matched to the
+// processes by name, so the trace may come from a file.
+int compute_deadline_report(process_queue* p, const trace_source_t* trace, sim_time_t end_time,
+                            deadline_report_t* report);
+
+// Same report from the statistics of a run that kept no trace
+int compute_deadline_report_metrics(process_queue* p, const sim_metrics_t* metrics, sim_time_t end_time,
+                                    deadline_report_t* report);
+
+void free_deadline_report(deadline_report_t* report);
+
+// Label of a histogram bin, e.g. "(2,5]"
+const char* deadline_histogram_label(int bin);
+
+#endif
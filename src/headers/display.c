@@ -21,7 +21,7 @@ static const char* operation_to_string(process_operation_t op) {
     }
 }
 
-void print_simulation_results(process_descriptor_t* descriptor, int size) {
+void print_simulation_results(const trace_source_t* trace) {
     printf("\n");
     printf("========================================\n");
     printf("   SIMULATION RESULTS\n");
@@ -30,78 +30,134 @@ void print_simulation_results(process_descriptor_t* descriptor, int size) {
     printf("%-15s %-10s %-15s %-10s\n", "PROCESS", "TIME", "STATE", "OPERATION");
     printf("%-15s %-10s %-15s %-10s\n", "-------", "----", "-----", "---------");
     
-    for (int i = 0; i < size; i++) {
-        printf("%-15s %-10d %-15s %-10s\n",
-               descriptor[i].process_name,
-               descriptor[i].date,
-               state_to_string(descriptor[i].state),
-               operation_to_string(descriptor[i].operation));
+    process_descriptor_t d;
+    for (int i = 0; i < trace->size && trace_source_get(trace, i, &d); i++) {
+        printf("%-15s %-10lld %-15s %-10s\n",
+               d.process_name,
+               (long long)d.date,
+               state_to_string(d.state),
+               operation_to_string(d.operation));
     }
     printf("\n");
 }
 
-void print_statistics(process_descriptor_t* descriptor, int size) {
-    if (size == 0) return;
+// Per-process table shared by the trace and metrics statistics
+static void print_stats_table(const char** names, const trace_proc_stats_t* stats, int count) {
+    printf("%-15s %-12s %-12s %-12s %-15s\n", 
+           "PROCESS", "START", "END", "TURNAROUND", "WAITING");
+    printf("%-15s %-12s %-12s %-12s %-15s\n",
+           "-------", "-----", "---", "----------", "-------");
+    
+    for (int i = 0; i < count; i++) {
+        sim_time_t turnaround = stats[i].end_time - stats[i].start_time;
+        printf("%-15s %-12lld %-12lld %-12lld %-15lld\n",
+               names[i],
+               (long long)stats[i].start_time,
+               (long long)stats[i].end_time,
+               (long long)turnaround,
+               (long long)stats[i].total_wait);
+    }
+    printf("\n");
+}
+
+void print_statistics(const trace_source_t* trace, const trace_index_t* index) {
+    if (trace->size == 0) return;
     
     printf("========================================\n");
     printf("   STATISTICS\n");
     printf("========================================\n\n");
     
-    // Calculate per-process statistics
-    typedef struct {
-        char name[64];
-        int start_time;
-        int end_time;
-        int total_wait;
-        int total_run;
-    } proc_stats_t;
+    // Per-process statistics from the trace index (any number of processes)
+    trace_proc_stats_t* stats = trace_index_stats(index, trace);
+    if (!stats) return;
     
-    proc_stats_t stats[100];
-    int num_procs = 0;
+    print_stats_table(index->proc_names, stats, index->proc_count);
     
-    for (int i = 0; i < size; i++) {
-        int found = -1;
-        for (int j = 0; j < num_procs; j++) {
-            if (strcmp(stats[j].name, descriptor[i].process_name) == 0) {
-                found = j;
-                break;
-            }
-        }
-        
-        if (found == -1) {
-            found = num_procs++;
-            strncpy(stats[found].name, descriptor[i].process_name, 63);
-            stats[found].name[63] = '\0';
-            stats[found].start_time = descriptor[i].date;
-            stats[found].end_time = descriptor[i].date;
-            stats[found].total_wait = 0;
-            stats[found].total_run = 0;
-        }
-        
-        if (descriptor[i].date > stats[found].end_time) {
-            stats[found].end_time = descriptor[i].date;
+    free(stats);
+}
+
+void print_metrics(const sim_metrics_t* metrics) {
+    if (metrics->procs.count == 0) return;
+    
+    printf("========================================\n");
+    printf("   STATISTICS\n");
+    printf("========================================\n\n");
+    
+    print_stats_table(metrics->procs.names, metrics->stats, metrics->procs.count);
+    
+    sim_metrics_summary_t summary;
+    sim_metrics_summarize(metrics, 0, &summary);
+    printf("Average turnaround: %.2f | Average waiting: %.2f | Makespan: %lld\n\n",
+           summary.mean_turnaround, summary.mean_waiting, (long long)summary.makespan);
+}
+
+void print_comparison(const compare_row_t* rows, int count) {
+    printf("========================================\n");
+    printf("   COMPARISON\n");
+    printf("========================================\n\n");
+
+    printf("%-20s", "POLICY");
+    for (int c = 0; c < COMPARE_COLUMNS; c++) printf(" %9s", compare_column_name(c));
+    printf("\n");
+
+    for (int i = 0; i < count; i++) {
+        printf("%-20s", rows[i].name);
+        for (int c = 0; c < COMPARE_COLUMNS; c++) {
+            char cell[32];
+            compare_cell(&rows[i], c, cell, sizeof(cell));
+            printf("%s%9s", (c > 0 && compare_is_best(rows, count, c - 1, i)) ? "*" : " ", cell);
         }
-        
-        if (descriptor[i].state == running_p) {
-            stats[found].total_run++;
-        } else if (descriptor[i].state == waiting_p) {
-            stats[found].total_wait++;
+        printf("%s\n", compare_is_best(rows, count, COMPARE_COLUMNS - 1, i) ? "*" : "");
+    }
+    printf("\n");
+
+    for (int i = 0; i < count; i++) {
+        if (rows[i].status != sim_completed) {
+            printf("%s %s at time %lld: %d / %d processes finished\n", rows[i].name,
+                   compare_status_text(rows[i].status), (long long)rows[i].end_time,
+                   rows[i].finished, rows[i].total);
         }
     }
-    
-    printf("%-15s %-12s %-12s %-12s %-15s\n", 
-           "PROCESS", "START", "END", "TURNAROUND", "WAITING");
-    printf("%-15s %-12s %-12s %-12s %-15s\n",
-           "-------", "-----", "---", "----------", "-------");
-    
-    for (int i = 0; i < num_procs; i++) {
-        int turnaround = stats[i].end_time - stats[i].start_time;
-        printf("%-15s %-12d %-12d %-12d %-15d\n",
-               stats[i].name,
-               stats[i].start_time,
-               stats[i].end_time,
-               turnaround,
-               stats[i].total_wait);
+}
+
+void print_deadline_report(const deadline_report_t* report) {
+    if (report->jobs == 0) return;
+
+    printf("========================================\n");
+    printf("   DEADLINES\n");
+    printf("========================================\n\n");
+
+    printf("Jobs with deadline: %d | Met: %d | Missed: %d", report->jobs, report->met, report->missed);
+    if (report->overdue > 0) printf(" (%d overdue)", report->overdue);
+    if (report->unfinished > report->overdue) printf(" | Pending: %d", report->unfinished - report->overdue);
+    printf("\n");
+    printf("Lateness min: %lld | mean: %.2f | p50: %lld | p90: %lld | p99: %lld | max: %lld\n",
+           (long long)report->min_lateness, report->mean_lateness,
+           (long long)report->p50_lateness, (long long)report->p90_lateness,
+           (long long)report->p99_lateness, (long long)report->max_lateness);
+    printf("CPU density: %.3f (%s)\n\n", report->density,
+           report->density_schedulable ? "schedulable under EDF, CPU only" : "not guaranteed");
+
+    for (int b = 0; b < DEADLINE_HIST_BINS; b++) {
+        printf("%-9s %6d\n", deadline_histogram_label(b), report->histogram[b]);
+    }
+    printf("\n");
+
+    // The list is sorted worst first, so the late jobs lead it
+    if (report->missed == 0) return;
+    printf("%-15s %-12s %-12s %-12s\n", "PROCESS", "DEADLINE", "COMPLETION", "LATENESS");
+    printf("%-15s %-12s %-12s %-12s\n", "-------", "--------", "----------", "--------");
+    for (int i = 0; i < report->jobs && report->list[i].lateness > 0; i++) {
+        const deadline_job_t* job = &report->list[i];
+        if (job->completion < 0) {
+            char bound[24];
+            snprintf(bound, sizeof(bound), ">=%lld", (long long)job->lateness);
+            printf("%-15s %-12lld %-12s %-12s\n", job->process_name,
+                   (long long)job->abs_deadline, "overdue", bound);
+        } else {
+            printf("%-15s %-12lld %-12lld %-12lld\n", job->process_name,
+                   (long long)job->abs_deadline, (long long)job->completion, (long long)job->lateness);
+        }
     }
     printf("\n");
 }
@@ -2,8 +2,21 @@
 #define DISPLAY_H
 
 #include "basic_sched.h"
+#include "trace_index.h"
+#include "sim_metrics.h"
+#include "compare.h"
+#include "deadline_stats.h"
 
-void print_simulation_results(process_descriptor_t* descriptor, int size);
-void print_statistics(process_descriptor_t* descriptor, int size);
+void print_simulation_results(const trace_source_t* trace);
+void print_statistics(const trace_source_t* trace, const trace_index_t* index);
+
+// Statistics of a run that kept no trace (same table, plus averages)
+void print_metrics(const sim_metrics_t* metrics);
+
+// Comparison table of compare_run(); the best value of each column is marked with *
+void print_comparison(const compare_row_t* rows, int count);
+
+// Deadline counts, lateness percentiles and histogram, and the late or overdue jobs
+void print_deadline_report(const deadline_report_t* report);
 
 #endif
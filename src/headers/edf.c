@@ -0,0 +1,172 @@
+#include "basic_sched.h"
+#include <stdlib.h>
+
+#define EDF_NO_DEADLINE INT64_MAX  // Processes without deadline run in the background
+
+// Per-process EDF state
+typedef struct {
+    process_t proc;
+    int idx;                  // Position in the workload
+    sim_time_t abs_deadline;  // arrival + deadline
+    int op_idx;               // Current operation index
+    sim_time_t op_remaining;  // Remaining time for current operation
+} edf_entity_t;
+
+// Binary min-heap of entity indices ordered by absolute deadline
+typedef struct {
+    int *items;
+    int size;
+} edf_heap_t;
+
+static int deadline_less(const edf_entity_t *ents, int a, int b) {
+    if (ents[a].abs_deadline != ents[b].abs_deadline)
+        return ents[a].abs_deadline < ents[b].abs_deadline;
+    if (ents[a].proc.arrival_time_p != ents[b].proc.arrival_time_p)
+        return ents[a].proc.arrival_time_p < ents[b].proc.arrival_time_p;
+    return a < b;
+}
+
+static void heap_push(edf_heap_t *h, const edf_entity_t *ents, int idx) {
+    int i = h->size++;
+    h->items[i] = idx;
+    while (i > 0 && deadline_less(ents, h->items[i], h->items[(i - 1) / 2])) {
+        int parent = (i - 1) / 2;
+        int tmp = h->items[i];
+        h->items[i] = h->items[parent];
+        h->items[parent] = tmp;
+        i = parent;
+    }
+}
+
+static int heap_pop(edf_heap_t *h, const edf_entity_t *ents) {
+    int top = h->items[0];
+    if (--h->size > 0) {
+        h->items[0] = h->items[h->size];
+        int i = 0;
+        for (;;) {
+            int l = 2 * i + 1, r = l + 1, m = i;
+            if (l < h->size && deadline_less(ents, h->items[l], h->items[m])) m = l;
+            if (r < h->size && deadline_less(ents, h->items[r], h->items[m])) m = r;
+            if (m == i) break;
+            int tmp = h->items[i];
+            h->items[i] = h->items[m];
+            h->items[m] = tmp;
+            i = m;
+        }
+    }
+    return top;
+}
+
+// Put an entity in the heap serving its current operation (no-op when stuck or done)
+static void edf_make_ready(edf_entity_t *ents, int idx, edf_heap_t *ready, edf_heap_t *io) {
+    edf_entity_t *e = &ents[idx];
+    if (e->op_idx >= e->proc.operations_count) return;
+
+    process_operation_t op = e->proc.descriptor_p[e->op_idx].operation_p;
+    if (op == calc_p) heap_push(ready, ents, idx);
+    else if (op == IO_p) heap_push(io, ents, idx);
+}
+
+void edf_sched(process_queue *p, process_descriptor_t **descriptor, int *size, sim_run_t *run) {
+    if (!p || p->size == 0) return;
+
+    int n = p->size;
+    edf_entity_t *ents = calloc(n, sizeof(edf_entity_t));
+    edf_heap_t ready = { malloc(n * sizeof(int)), 0 };
+    edf_heap_t io = { malloc(n * sizeof(int)), 0 };
+    sim_active_t set;
+    int set_ok = sim_active_init(&set, p);
+
+    if (!ents || !ready.items || !io.items || !set_ok) {
+        free(ents); free(ready.items); free(io.items);
+        if (set_ok) sim_active_free(&set);
+        return;
+    }
+
+    int idx = 0;
+    for (node_t *node = p->head; node != NULL; node = node->next, idx++) {
+        edf_entity_t *e = &ents[idx];
+        e->proc = node->proc;
+        e->idx = idx;
+        e->abs_deadline = (node->proc.deadline > 0)
+                              ? node->proc.arrival_time_p + node->proc.deadline
+                              : EDF_NO_DEADLINE;
+        e->op_idx = 0;
+        e->op_remaining = (node->proc.operations_count > 0) ?
+                              node->proc.descriptor_p[0].duration_op : 0;
+    }
+
+    edf_entity_t *curr = NULL;      // Process holding the CPU
+    edf_entity_t *io_curr = NULL;   // Process holding the I/O device (non-preemptive)
+
+    sim_time_t current_time = 0;
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
+
+    while (set.finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
+
+        // Admit arrivals
+        for (int a; (a = sim_active_admit(&set, current_time)) >= 0;) {
+            edf_make_ready(ents, a, &ready, &io);
+        }
+
+        // Preempt when a ready process has an earlier deadline
+        if (curr && ready.size > 0 && deadline_less(ents, ready.items[0], curr->idx)) {
+            heap_push(&ready, ents, curr->idx);
+            curr = NULL;
+        }
+
+        if (!curr && ready.size > 0) {
+            curr = &ents[heap_pop(&ready, ents)];
+        }
+
+        // The I/O device serves the earliest deadline once free
+        if (!io_curr && io.size > 0) {
+            io_curr = &ents[heap_pop(&io, ents)];
+        }
+
+        edf_entity_t *cpu_ran = curr;
+        edf_entity_t *io_ran = io_curr;
+
+        // Execute CPU operation
+        if (cpu_ran) {
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, cpu_ran->idx, calc_p,
+                                                  &cpu_ran->op_idx, &cpu_ran->op_remaining, current_time);
+            if (r != sim_op_continues) curr = NULL;
+            if (r == sim_op_next) edf_make_ready(ents, cpu_ran->idx, &ready, &io);
+        }
+
+        // Execute I/O operation
+        if (io_ran) {
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, io_ran->idx, IO_p,
+                                                  &io_ran->op_idx, &io_ran->op_remaining, current_time);
+            if (r != sim_op_continues) io_curr = NULL;
+            if (r == sim_op_next) edf_make_ready(ents, io_ran->idx, &ready, &io);
+        }
+
+        if (!sim_active_end_tick(&set, run, descriptor, size, cpu_ran ? cpu_ran->idx : -1,
+                                 io_ran ? io_ran->idx : -1, &current_time, &status)) {
+            break;
+        }
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = set.finished;
+        run->total = n;
+    }
+
+    free(ents);
+    free(ready.items);
+    free(io.items);
+    sim_active_free(&set);
+}
@@ -0,0 +1,69 @@
+#define _POSIX_C_SOURCE 200809L
+#include "event_ring.h"
+#include <time.h>
+
+int event_ring_init(event_ring_t* ring, size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+
+    ring->slots = malloc(cap * sizeof(process_descriptor_t));
+    if (!ring->slots) return 0;
+    ring->mask = cap - 1;
+    ring->closed = 0;
+    ring->cancelled = 0;
+    ring->head = ring->tail_cache = 0;
+    ring->tail = ring->head_cache = 0;
+    return 1;
+}
+
+void event_ring_free(event_ring_t* ring) {
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+void event_ring_pause(void) {
+    struct timespec ts = { 0, 100000 };   // 100 us
+    nanosleep(&ts, NULL);
+}
+
+int event_ring_push(event_ring_t* ring, const process_descriptor_t* record) {
+    size_t tail = ring->tail;
+
+    // Full: re-read the consumer's head (acquire), back off until a slot frees up
+    while (tail - ring->head_cache > ring->mask) {
+        if (__atomic_load_n(&ring->cancelled, __ATOMIC_ACQUIRE)) return 0;
+        ring->head_cache = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        if (tail - ring->head_cache > ring->mask) event_ring_pause();
+    }
+
+    ring->slots[tail & ring->mask] = *record;
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return !__atomic_load_n(&ring->cancelled, __ATOMIC_RELAXED);
+}
+
+void event_ring_close(event_ring_t* ring) {
+    __atomic_store_n(&ring->closed, 1, __ATOMIC_RELEASE);
+}
+
+int event_ring_pop(event_ring_t* ring, process_descriptor_t* record) {
+    size_t head = ring->head;
+
+    if (head == ring->tail_cache) {
+        ring->tail_cache = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head == ring->tail_cache) return 0;
+    }
+
+    *record = ring->slots[head & ring->mask];
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+int event_ring_finished(event_ring_t* ring) {
+    // Check closed first: every record pushed before close is then visible in tail
+    if (!__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE)) return 0;
+    return ring->head == __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+void event_ring_cancel(event_ring_t* ring) {
+    __atomic_store_n(&ring->cancelled, 1, __ATOMIC_RELEASE);
+}
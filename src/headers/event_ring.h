@@ -0,0 +1,43 @@
+#ifndef EVENT_RING_H
+#define EVENT_RING_H
+
+#include <stddef.h>
+#include "basic_sched.h"
+
+#define EVENT_RING_CACHE_LINE 64
+
+// Bounded lock-free single-producer / single-consumer queue of trace records.
+// The producer (simulation thread) blocks while the ring is full, so a slow
+// consumer (the animation) paces the simulation and memory stays bounded.
+typedef struct event_ring_t {
+    process_descriptor_t* slots;
+    size_t mask;                 // Capacity - 1 (capacity is a power of two)
+    int closed;                  // Producer finished (atomic)
+    int cancelled;               // Consumer gave up (atomic)
+
+    // Each index is written by one side only; keep them on separate cache lines
+    char pad0[EVENT_RING_CACHE_LINE];
+    size_t head;                 // Next slot to read (consumer)
+    size_t tail_cache;           // Consumer's last view of tail
+    char pad1[EVENT_RING_CACHE_LINE];
+    size_t tail;                 // Next slot to write (producer)
+    size_t head_cache;           // Producer's last view of head
+    char pad2[EVENT_RING_CACHE_LINE];
+} event_ring_t;
+
+int event_ring_init(event_ring_t* ring, size_t capacity);
+void event_ring_free(event_ring_t* ring);
+
+// Producer side
+int event_ring_push(event_ring_t* ring, const process_descriptor_t* record);  // 0 once cancelled
+void event_ring_close(event_ring_t* ring);
+
+// Consumer side
+int event_ring_pop(event_ring_t* ring, process_descriptor_t* record);         // 0 when empty
+int event_ring_finished(event_ring_t* ring);   // Closed and drained
+void event_ring_cancel(event_ring_t* ring);
+
+// Short back-off used by either side while waiting for the other one
+void event_ring_pause(void);
+
+#endif
@@ -0,0 +1,315 @@
+#include "experiment.h"
+#include <ctype.h>
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+
+void workload_spec_default(workload_spec_t* spec) {
+    spec->processes = (dist_t){dist_uniform, 5, 20};
+    spec->interarrival = (dist_t){dist_exponential, 5, 0};
+    spec->priority = (dist_t){dist_uniform, 1, 10};
+    spec->bursts = (dist_t){dist_uniform, 1, 4};
+    spec->calc = (dist_t){dist_exponential, 10, 0};
+    spec->io = (dist_t){dist_uniform, 1, 10};
+    spec->io_probability = 1.0;
+}
+
+static char* trim(char* str) {
+    while (isspace((unsigned char)*str)) str++;
+    char* end = str + strlen(str);
+    while (end > str && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return str;
+}
+
+static int parse_dist(const char* text, dist_t* dist) {
+    char* end;
+    if (strncmp(text, "exp:", 4) == 0) {
+        dist->kind = dist_exponential;
+        dist->a = strtod(text + 4, &end);
+        dist->b = 0;
+        return *end == '\0' && dist->a >= 0;
+    }
+    const char* range = strstr(text, "..");
+    if (range) {
+        dist->kind = dist_uniform;
+        dist->a = (double)strtoll(text, &end, 10);
+        if (end != range) return 0;
+        dist->b = (double)strtoll(range + 2, &end, 10);
+        return *end == '\0' && dist->a >= 0 && dist->a <= dist->b;
+    }
+    dist->kind = dist_constant;
+    dist->a = (double)strtoll(text, &end, 10);
+    dist->b = 0;
+    return end != text && *end == '\0' && dist->a >= 0;
+}
+
+int workload_spec_load(const char* path, workload_spec_t* spec) {
+    workload_spec_default(spec);
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "Error: Cannot open workload spec '%s'\n", path);
+        return 0;
+    }
+
+    char line[256];
+    int line_num = 0, ok = 1;
+    while (ok && fgets(line, sizeof(line), fp)) {
+        line_num++;
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char* text = trim(line);
+        if (text[0] == '\0') continue;
+
+        char* eq = strchr(text, '=');
+        if (!eq) {
+            fprintf(stderr, "Error: %s line %d - expected key = value\n", path, line_num);
+            ok = 0;
+            break;
+        }
+        *eq = '\0';
+        char* key = trim(text);
+        char* value = trim(eq + 1);
+
+        dist_t* dist = NULL;
+        if (strcmp(key, "processes") == 0) dist = &spec->processes;
+        else if (strcmp(key, "interarrival") == 0) dist = &spec->interarrival;
+        else if (strcmp(key, "priority") == 0) dist = &spec->priority;
+        else if (strcmp(key, "bursts") == 0) dist = &spec->bursts;
+        else if (strcmp(key, "calc") == 0) dist = &spec->calc;
+        else if (strcmp(key, "io") == 0) dist = &spec->io;
+
+        if (dist) {
+            if (!parse_dist(value, dist)) {
+                fprintf(stderr, "Error: %s line %d - bad distribution '%s'\n", path, line_num, value);
+                ok = 0;
+            }
+        } else if (strcmp(key, "io_probability") == 0) {
+            char* end;
+            spec->io_probability = strtod(value, &end);
+            if (*end != '\0' || spec->io_probability < 0 || spec->io_probability > 1) {
+                fprintf(stderr, "Error: %s line %d - io_probability must be in [0, 1]\n", path, line_num);
+                ok = 0;
+            }
+        } else {
+            fprintf(stderr, "Error: %s line %d - unknown key '%s'\n", path, line_num, key);
+            ok = 0;
+        }
+    }
+    fclose(fp);
+    return ok;
+}
+
+// Uniform double in [0, 1)
+static double rng_unit(sim_rng_t* rng) {
+    return (double)(sim_rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static sim_time_t draw(const dist_t* dist, sim_rng_t* rng) {
+    switch (dist->kind) {
+        case dist_uniform: {
+            uint64_t span = (uint64_t)(dist->b - dist->a) + 1;
+            return (sim_time_t)dist->a + (sim_time_t)sim_rng_below(rng, span);
+        }
+        case dist_exponential:
+            return (sim_time_t)(-dist->a * log(1.0 - rng_unit(rng)) + 0.5);
+        default:
+            return (sim_time_t)dist->a;
+    }
+}
+
+int workload_generate(const workload_spec_t* spec, uint64_t seed, process_queue* queue) {
+    sim_rng_t rng;
+    sim_rng_seed(&rng, seed);
+    sim_time_t count = draw(&spec->processes, &rng);
+    if (count < 1) count = 1;
+
+    sim_time_t arrival = 0;
+    for (sim_time_t p = 0; p < count; p++) {
+        if (p > 0) arrival += draw(&spec->interarrival, &rng);
+        sim_time_t bursts = draw(&spec->bursts, &rng);
+        if (bursts < 1) bursts = 1;
+        if (bursts > 1000) bursts = 1000;
+
+        process_t proc;
+        memset(&proc, 0, sizeof(proc));
+        char name[32];
+        snprintf(name, sizeof(name), "P%lld", (long long)(p + 1));
+        proc.process_name = malloc(strlen(name) + 1);
+        proc.descriptor_p = malloc((size_t)(2 * bursts - 1) * sizeof(operation_t));
+        if (!proc.process_name || !proc.descriptor_p) {
+            free(proc.process_name);
+            free(proc.descriptor_p);
+            return 0;
+        }
+        strcpy(proc.process_name, name);
+        proc.arrival_time_p = arrival;
+        proc.begining_date = arrival;
+        sim_time_t priority = draw(&spec->priority, &rng);
+        if (priority < SIM_PRIORITY_MIN) priority = SIM_PRIORITY_MIN;
+        if (priority > SIM_PRIORITY_MAX) priority = SIM_PRIORITY_MAX;
+        proc.priority_p = (int)priority;
+
+        int ops = 0;
+        for (sim_time_t b = 0; b < bursts; b++) {
+            sim_time_t calc = draw(&spec->calc, &rng);
+            proc.descriptor_p[ops].operation_p = calc_p;
+            proc.descriptor_p[ops++].duration_op = (calc < 1) ? 1 : calc;
+            if (b + 1 < bursts && rng_unit(&rng) < spec->io_probability) {
+                sim_time_t io = draw(&spec->io, &rng);
+                proc.descriptor_p[ops].operation_p = IO_p;
+                proc.descriptor_p[ops++].duration_op = (io < 1) ? 1 : io;
+            }
+        }
+        proc.operations_count = ops;
+        add_tail(queue, proc);
+    }
+    return 1;
+}
+
+void workload_free(process_queue* queue) {
+    while (queue->size > 0) {
+        free(queue->head->proc.process_name);
+        free(queue->head->proc.descriptor_p);
+        remove_head(queue);
+    }
+}
+
+void stat_acc_add(stat_acc_t* acc, double x) {
+    acc->n++;
+    double delta = x - acc->mean;
+    acc->mean += delta / (double)acc->n;
+    acc->m2 += delta * (x - acc->mean);
+}
+
+void stat_acc_merge(stat_acc_t* into, const stat_acc_t* from) {
+    if (from->n == 0) return;
+    if (into->n == 0) {
+        *into = *from;
+        return;
+    }
+    int64_t n = into->n + from->n;
+    double delta = from->mean - into->mean;
+    into->mean += delta * (double)from->n / (double)n;
+    into->m2 += from->m2 + delta * delta * (double)into->n * (double)from->n / (double)n;
+    into->n = n;
+}
+
+double stat_acc_ci95(const stat_acc_t* acc) {
+    if (acc->n < 2) return 0;
+    double variance = acc->m2 / (double)(acc->n - 1);
+    return 1.96 * sqrt(variance / (double)acc->n);
+}
+
+uint64_t experiment_workload_seed(uint64_t seed, int64_t index) {
+    sim_rng_t rng;
+    sim_rng_seed(&rng, seed ^ ((uint64_t)index * 0xD1B54A32D192ED03ULL));
+    return sim_rng_next(&rng);
+}
+
+// Thread of an experiment: workloads i = index, index + threads, ...
+typedef struct experiment_worker_t {
+    const workload_spec_t* spec;
+    int64_t runs;
+    uint64_t seed;
+    sim_time_t horizon;
+    int index;
+    int threads;
+    const int* choices;
+    int choice_count;
+    experiment_policy_fn policy;
+    void* ctx;
+    experiment_result_t* results;   // One per choice, owned by this thread
+    int ok;
+} experiment_worker_t;
+
+static void* experiment_worker_main(void* arg) {
+    experiment_worker_t* w = arg;
+    for (int64_t i = w->index; i < w->runs; i += w->threads) {
+        uint64_t workload_seed = experiment_workload_seed(w->seed, i);
+
+        process_queue queue = {NULL, NULL, 0};
+        if (!workload_generate(w->spec, workload_seed, &queue)) {
+            workload_free(&queue);
+            w->ok = 0;
+            break;
+        }
+        for (int c = 0; c < w->choice_count; c++) {
+            sim_run_t run;
+            sim_run_init(&run, w->horizon);
+            sim_metrics_t metrics;
+            sim_metrics_init(&metrics);
+            run.trace_level = trace_none;
+            run.metrics = &metrics;
+            w->policy(w->ctx, w->choices[c], &queue, workload_seed, &run);
+
+            sim_metrics_summary_t summary;
+            sim_metrics_summarize(&metrics, run.end_time, &summary);
+            experiment_result_t* r = &w->results[c];
+            stat_acc_add(&r->metrics[metric_waiting], summary.mean_waiting);
+            stat_acc_add(&r->metrics[metric_p99_response], (double)summary.p99_response);
+            stat_acc_add(&r->metrics[metric_throughput], summary.throughput);
+            stat_acc_add(&r->metrics[metric_utilization], summary.utilization);
+            if (run.status != sim_completed) r->incomplete++;
+            if (metrics.error) w->ok = 0;
+            sim_metrics_free(&metrics);
+        }
+        workload_free(&queue);
+    }
+    return NULL;
+}
+
+int experiment_run(const workload_spec_t* spec, int64_t runs, uint64_t seed, sim_time_t horizon,
+                   int threads, const int* choices, int choice_count, experiment_policy_fn policy,
+                   void* ctx, experiment_result_t* results) {
+    memset(results, 0, choice_count * sizeof(experiment_result_t));
+    if (threads < 1) threads = 1;
+    if (runs < threads) threads = (runs > 0) ? (int)runs : 1;
+
+    experiment_worker_t* workers = calloc(threads, sizeof(experiment_worker_t));
+    pthread_t* ids = calloc(threads, sizeof(pthread_t));
+    int* started = calloc(threads, sizeof(int));
+    int ok = (workers && ids && started);
+
+    for (int t = 0; ok && t < threads; t++) {
+        experiment_worker_t* w = &workers[t];
+        w->spec = spec;
+        w->runs = runs;
+        w->seed = seed;
+        w->horizon = horizon;
+        w->index = t;
+        w->threads = threads;
+        w->choices = choices;
+        w->choice_count = choice_count;
+        w->policy = policy;
+        w->ctx = ctx;
+        w->results = calloc(choice_count, sizeof(experiment_result_t));
+        w->ok = 1;
+        if (!w->results) {
+            ok = 0;
+            break;
+        }
+        if (t == 0) continue;       // Thread 0's share runs on the calling thread
+        started[t] = (pthread_create(&ids[t], NULL, experiment_worker_main, w) == 0);
+        if (!started[t]) ok = 0;
+    }
+    if (ok) experiment_worker_main(&workers[0]);
+
+    // Merge in thread order, so the result only depends on the seed and thread count
+    for (int t = 0; workers && t < threads; t++) {
+        if (started && started[t]) pthread_join(ids[t], NULL);
+        if (!workers[t].results) continue;
+        if (!workers[t].ok) ok = 0;
+        for (int c = 0; c < choice_count; c++) {
+            for (int m = 0; m < EXPERIMENT_METRICS; m++) {
+                stat_acc_merge(&results[c].metrics[m], &workers[t].results[c].metrics[m]);
+            }
+            results[c].incomplete += workers[t].results[c].incomplete;
+        }
+        free(workers[t].results);
+    }
+    free(workers);
+    free(ids);
+    free(started);
+    return ok;
+}
@@ -0,0 +1,81 @@
+#ifndef EXPERIMENT_H
+#define EXPERIMENT_H
+
+#include "basic_sched.h"
+#include "sim_metrics.h"
+
+// Monte Carlo experiments: N random workloads drawn from a distribution spec, each run
+// under several policies, with every metric aggregated as a streaming mean and
+// variance (memory does not depend on N).
+
+// Distribution of one workload parameter. In a spec file: "7" (constant), "2..9"
+// (uniform integer, inclusive) or "exp:10" (exponential with mean 10, rounded).
+typedef enum dist_kind_t {
+    dist_constant,
+    dist_uniform,
+    dist_exponential
+} dist_kind_t;
+
+typedef struct dist_t {
+    dist_kind_t kind;
+    double a;                  // Constant, lower bound or mean
+    double b;                  // Upper bound
+} dist_t;
+
+// Spec file: "key = value" lines, '#' comments; missing keys keep the defaults
+typedef struct workload_spec_t {
+    dist_t processes;          // Processes per workload (default 5..20)
+    dist_t interarrival;       // Time between consecutive arrivals (exp:5)
+    dist_t priority;           // (1..10)
+    dist_t bursts;             // CALC bursts per process (1..4)
+    dist_t calc;               // CALC burst length, at least 1 (exp:10)
+    dist_t io;                 // I/O length, at least 1 (1..10)
+    double io_probability;     // Chance of an I/O between two CALC bursts (1.0)
+} workload_spec_t;
+
+void workload_spec_default(workload_spec_t* spec);
+int workload_spec_load(const char* path, workload_spec_t* spec);   // 0 (with a message) on error
+
+// Fill an empty queue with the workload of a seed; 0 when out of memory
+int workload_generate(const workload_spec_t* spec, uint64_t seed, process_queue* queue);
+void workload_free(process_queue* queue);
+
+// Streaming mean and variance (Welford), mergeable across threads
+typedef struct stat_acc_t {
+    int64_t n;
+    double mean;
+    double m2;                 // Sum of squared deviations from the mean
+} stat_acc_t;
+
+void stat_acc_add(stat_acc_t* acc, double x);
+void stat_acc_merge(stat_acc_t* into, const stat_acc_t* from);
+double stat_acc_ci95(const stat_acc_t* acc);   // Half-width of the 95% confidence interval
+
+typedef enum experiment_metric_t {
+    metric_waiting,            // Mean waiting time of a run
+    metric_p99_response,       // 99th percentile response time of a run
+    metric_throughput,         // Terminated processes per tick
+    metric_utilization,        // Share of the makespan the CPU was busy
+    EXPERIMENT_METRICS
+} experiment_metric_t;
+
+// Aggregates of one policy
+typedef struct experiment_result_t {
+    stat_acc_t metrics[EXPERIMENT_METRICS];
+    int64_t incomplete;        // Runs that stalled or reached the horizon
+} experiment_result_t;
+
+// Runs one policy (menu number) on a workload; seed is the workload's, for randomized policies
+typedef void (*experiment_policy_fn)(void* ctx, int choice, process_queue* queue, uint64_t seed,
+                                     sim_run_t* run);
+
+// Seed of workload index of an experiment (the same whatever thread generates it)
+uint64_t experiment_workload_seed(uint64_t seed, int64_t index);
+
+// Simulate runs workloads under every policy in choices, on threads threads.
+// results[c] belongs to choices[c]. Reproducible for a given seed and thread count.
+int experiment_run(const workload_spec_t* spec, int64_t runs, uint64_t seed, sim_time_t horizon,
+                   int threads, const int* choices, int choice_count, experiment_policy_fn policy,
+                   void* ctx, experiment_result_t* results);
+
+#endif
@@ -0,0 +1,242 @@
+#include "basic_sched.h"
+#include <stdlib.h>
+
+#define MLFQ_DEFAULT_LEVELS 3
+#define MLFQ_DEFAULT_QUANTUM 2     // Top-level quantum, doubled at each lower level
+#define MLFQ_DEFAULT_BOOST 50      // Priority boost period (ticks)
+
+// Per-process MLFQ state
+typedef struct {
+    process_t proc;
+    int idx;                  // Position in the workload
+    int level;                // Queue level (0 = highest), valid for boost_epoch
+    int boost_epoch;          // Boost generation in which level was assigned
+    sim_time_t level_used;    // CPU time used at the current level (allotment)
+    int op_idx;               // Current operation index
+    sim_time_t op_remaining;  // Remaining time for current operation
+    int next;                 // Queue link (-1 = end)
+} mlfq_entity_t;
+
+// Intrusive FIFO of entity indices
+typedef struct {
+    int head;
+    int tail;
+} mlfq_queue_t;
+
+typedef struct {
+    mlfq_entity_t *ents;
+    mlfq_queue_t levels[MLFQ_MAX_LEVELS];
+    unsigned nonempty;        // Bit l set when level l has ready processes
+    int level_count;
+    int epoch;                // Incremented by every priority boost
+} mlfq_t;
+
+static void queue_push_back(mlfq_t *m, mlfq_queue_t *q, int idx) {
+    m->ents[idx].next = -1;
+    if (q->tail >= 0) m->ents[q->tail].next = idx;
+    else q->head = idx;
+    q->tail = idx;
+}
+
+static void queue_push_front(mlfq_t *m, mlfq_queue_t *q, int idx) {
+    m->ents[idx].next = q->head;
+    q->head = idx;
+    if (q->tail < 0) q->tail = idx;
+}
+
+static int queue_pop_front(mlfq_t *m, mlfq_queue_t *q) {
+    int idx = q->head;
+    q->head = m->ents[idx].next;
+    if (q->head < 0) q->tail = -1;
+    return idx;
+}
+
+// Level of an entity, reset lazily to the top after a priority boost
+static int mlfq_level(mlfq_t *m, mlfq_entity_t *e) {
+    if (e->boost_epoch != m->epoch) {
+        e->boost_epoch = m->epoch;
+        e->level = 0;
+        e->level_used = 0;
+    }
+    return e->level;
+}
+
+static void mlfq_enqueue(mlfq_t *m, int idx, int front) {
+    int level = mlfq_level(m, &m->ents[idx]);
+    if (front) queue_push_front(m, &m->levels[level], idx);
+    else queue_push_back(m, &m->levels[level], idx);
+    m->nonempty |= 1u << level;
+}
+
+// Highest non-empty level, -1 when every queue is empty
+static int mlfq_top_level(const mlfq_t *m) {
+    return m->nonempty ? __builtin_ctz(m->nonempty) : -1;
+}
+
+static int mlfq_dequeue(mlfq_t *m, int level) {
+    int idx = queue_pop_front(m, &m->levels[level]);
+    if (m->levels[level].head < 0) m->nonempty &= ~(1u << level);
+    return idx;
+}
+
+// Priority boost: splice every lower queue onto the top queue in O(levels)
+static void mlfq_boost(mlfq_t *m) {
+    for (int l = 1; l < m->level_count; l++) {
+        mlfq_queue_t *q = &m->levels[l];
+        if (q->head < 0) continue;
+        if (m->levels[0].tail >= 0) m->ents[m->levels[0].tail].next = q->head;
+        else m->levels[0].head = q->head;
+        m->levels[0].tail = q->tail;
+        q->head = q->tail = -1;
+    }
+    m->nonempty = (m->levels[0].head >= 0) ? 1u : 0u;
+    m->epoch++;
+}
+
+// Put an entity where its current operation can be served (no-op when stuck or done)
+static void mlfq_make_ready(mlfq_t *m, int idx, sim_active_t *set) {
+    mlfq_entity_t *e = &m->ents[idx];
+    if (e->op_idx >= e->proc.operations_count) return;
+
+    process_operation_t op = e->proc.descriptor_p[e->op_idx].operation_p;
+    if (op == calc_p) mlfq_enqueue(m, idx, 0);
+    else if (op == IO_p) sim_active_io_push(set, idx);
+}
+
+void mlfq_sched(process_queue *p, process_descriptor_t **descriptor, int *size,
+                const mlfq_params_t *params, sim_run_t *run) {
+    if (!p || p->size == 0) return;
+
+    // Resolve parameters (missing or invalid values fall back to defaults)
+    int level_count = (params && params->levels > 0) ? params->levels : MLFQ_DEFAULT_LEVELS;
+    if (level_count > MLFQ_MAX_LEVELS) level_count = MLFQ_MAX_LEVELS;
+    sim_time_t quanta[MLFQ_MAX_LEVELS];
+    for (int l = 0; l < level_count; l++) {
+        if (params && params->quanta[l] > 0) quanta[l] = params->quanta[l];
+        else quanta[l] = (l == 0) ? MLFQ_DEFAULT_QUANTUM : quanta[l - 1] * 2;
+    }
+    sim_time_t boost_period = (params && params->boost_period != 0)
+                                  ? params->boost_period : MLFQ_DEFAULT_BOOST;
+
+    int n = p->size;
+    mlfq_t m;
+    m.ents = calloc(n, sizeof(mlfq_entity_t));
+    m.level_count = level_count;
+    m.nonempty = 0;
+    m.epoch = 0;
+    for (int l = 0; l < MLFQ_MAX_LEVELS; l++) m.levels[l].head = m.levels[l].tail = -1;
+
+    sim_active_t set;
+    if (!m.ents || !sim_active_init(&set, p)) {
+        free(m.ents);
+        return;
+    }
+
+    int idx = 0;
+    for (node_t *node = p->head; node != NULL; node = node->next, idx++) {
+        mlfq_entity_t *e = &m.ents[idx];
+        e->proc = node->proc;
+        e->idx = idx;
+        e->op_idx = 0;
+        e->op_remaining = (node->proc.operations_count > 0) ?
+                              node->proc.descriptor_p[0].duration_op : 0;
+        e->next = -1;
+    }
+
+    int curr = -1;                 // Process holding the CPU
+    sim_time_t next_boost = boost_period;
+
+    sim_time_t current_time = 0;
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
+
+    while (set.finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
+
+        // Periodic priority boost (catching up after skipped idle gaps)
+        if (boost_period > 0 && current_time >= next_boost) {
+            mlfq_boost(&m);
+            next_boost = (current_time / boost_period + 1) * boost_period;
+        }
+
+        // Admit arrivals at the top level
+        for (int a; (a = sim_active_admit(&set, current_time)) >= 0;) {
+            m.ents[a].boost_epoch = m.epoch;
+            m.ents[a].level = 0;
+            m.ents[a].level_used = 0;
+            mlfq_make_ready(&m, a, &set);
+        }
+
+        // Preempt when a higher level has ready processes (resume first later)
+        int top = mlfq_top_level(&m);
+        if (curr >= 0 && top >= 0 && top < mlfq_level(&m, &m.ents[curr])) {
+            mlfq_enqueue(&m, curr, 1);
+            curr = -1;
+            top = mlfq_top_level(&m);
+        }
+
+        if (curr < 0 && top >= 0) {
+            curr = mlfq_dequeue(&m, top);
+        }
+
+        int cpu_ran = curr;
+        int io_ran = set.io_head;
+
+        // Execute CPU operation
+        if (cpu_ran >= 0) {
+            mlfq_entity_t *e = &m.ents[cpu_ran];
+            int level = mlfq_level(&m, e);
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, cpu_ran, calc_p,
+                                                  &e->op_idx, &e->op_remaining, current_time);
+            e->level_used++;
+
+            // Allotment exhausted: demote one level (stays at the bottom level)
+            int demoted = 0;
+            if (e->level_used >= quanta[level]) {
+                if (level < level_count - 1) e->level = level + 1;
+                e->level_used = 0;
+                demoted = 1;
+            }
+
+            if (r != sim_op_continues) {
+                curr = -1;
+                if (r == sim_op_next) mlfq_make_ready(&m, cpu_ran, &set);
+            } else if (demoted) {
+                mlfq_enqueue(&m, cpu_ran, 0);
+                curr = -1;
+            }
+        }
+
+        // Execute I/O operation (one device, served in FIFO order)
+        if (io_ran >= 0) {
+            mlfq_entity_t *e = &m.ents[io_ran];
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, io_ran, IO_p,
+                                                  &e->op_idx, &e->op_remaining, current_time);
+
+            // I/O completed: the process keeps its level and remaining allotment
+            if (r != sim_op_continues) sim_active_io_pop(&set);
+            if (r == sim_op_next) mlfq_make_ready(&m, io_ran, &set);
+        }
+
+        if (!sim_active_end_tick(&set, run, descriptor, size, cpu_ran, io_ran, &current_time, &status)) {
+            break;
+        }
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = set.finished;
+        run->total = n;
+    }
+
+    free(m.ents);
+    sim_active_free(&set);
+}
@@ -1,16 +1,17 @@
 #include "basic_sched.h"
+#include "checkpoint.h"
 #include <stdlib.h>
 #include <limits.h>
 
-void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, int *size) {
+void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, int *size, sim_run_t *run) {
     if (!p || p->size == 0) return;
 
     int n = p->size;
 
     process_t *procs = malloc(n * sizeof(process_t));
     int *op_idx  = malloc(n * sizeof(int));
-    int *op_left = malloc(n * sizeof(int));
-    int *io_until = malloc(n * sizeof(int));
+    sim_time_t *op_left = malloc(n * sizeof(sim_time_t));
+    sim_time_t *io_until = malloc(n * sizeof(sim_time_t));
     int *done    = malloc(n * sizeof(int));
 
     if (!procs || !op_idx || !op_left || !io_until || !done) {
@@ -29,18 +30,50 @@ void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, in
     }
 
     int finished = 0;
-    int current_time = 0;
-    int max_time = 10000;
+    for (int k = 0; k < n; k++)
+        if (done[k]) finished++;
+    sim_time_t current_time = 0;
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
 
     int max_priority = INT_MIN;
     for (int k = 0; k < n; k++)
         if (procs[k].priority_p > max_priority) max_priority = procs[k].priority_p;
 
-    int *rr_index = malloc((max_priority+1) * sizeof(int));
-    for (int k = 0; k <= max_priority; k++)
+    // Priorities are SIM_PRIORITY_MIN..MAX (the loaders reject others): one cursor per level
+    int levels = (max_priority >= 0) ? max_priority + 1 : 0;
+    int *rr_index = malloc((levels > 0 ? levels : 1) * sizeof(int));
+    for (int k = 0; k < levels; k++)
         rr_index[k] = -1;
 
-    while (finished < n && current_time < max_time) {
+    // Continue a snapshot: process states plus each level's last pick
+    const sim_checkpoint_t *cp = checkpoint_resume(run, checkpoint_multilevel, p, levels);
+    if (cp) {
+        for (int k = 0; k < n; k++) {
+            op_idx[k] = cp->procs[k].op_idx;
+            op_left[k] = cp->procs[k].op_remaining;
+            io_until[k] = cp->procs[k].io_until;
+            done[k] = cp->procs[k].terminated;
+        }
+        for (int k = 0; k < levels; k++)
+            rr_index[k] = (int)cp->cursors[k];
+        current_time = cp->time;
+        finished = cp->finished;
+    } else if (run && run->resume) {
+        free(procs); free(op_idx); free(op_left); free(io_until); free(done); free(rr_index);
+        return;
+    }
+
+    while (finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
+
         int cpu_pick = -1;
         int io_pick = -1;
         int best_priority = INT_MIN;
@@ -142,7 +175,7 @@ void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, in
             r.date = current_time;
             r.state = running_p;
             r.operation = calc_p;
-            append_descriptor(descriptor, r, size);
+            sim_emit(run, descriptor, size, r);
 
             op_left[cpu_pick]--;
             
@@ -161,7 +194,7 @@ void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, in
             r.date = current_time;
             r.state = running_p;
             r.operation = IO_p;
-            append_descriptor(descriptor, r, size);
+            sim_emit(run, descriptor, size, r);
 
             
             if (io_until[io_pick] <= current_time + 1) {
@@ -183,30 +216,75 @@ void multilevel_rr_sched(process_queue* p, process_descriptor_t** descriptor, in
                 w.date = current_time;
                 w.state = waiting_p;
                 w.operation = none;
-                append_descriptor(descriptor, w, size);
+                sim_emit(run, descriptor, size, w);
             }
         }
 
         
+        int terminated_now = 0;
         for (int k = 0; k < n; k++) {
             if (!done[k] &&
                 procs[k].arrival_time_p <= current_time &&
                 op_idx[k] >= procs[k].operations_count && io_until[k] < 0) {
                 done[k] = 1;
                 finished++;
+                terminated_now++;
 
                 process_descriptor_t t;
                 t.process_name = procs[k].process_name;
                 t.date = current_time + 1;
                 t.state = terminated_p;
                 t.operation = none;
-                append_descriptor(descriptor, t, size);
+                sim_emit(run, descriptor, size, t);
+            }
+        }
+
+        // Nothing ran or terminated: skip idle gaps (up to the horizon), detect permanent stalls
+        if (cpu_pick < 0 && io_pick < 0 && !terminated_now) {
+            int active = 0;
+            sim_time_t next_arrival = -1;
+            for (int k = 0; k < n; k++) {
+                if (done[k]) continue;
+                if (procs[k].arrival_time_p > current_time) {
+                    if (next_arrival < 0 || procs[k].arrival_time_p < next_arrival)
+                        next_arrival = procs[k].arrival_time_p;
+                } else {
+                    active = 1;
+                }
+            }
+            if (next_arrival < 0) {
+                status = sim_stalled;
+                current_time++;
+                break;
+            }
+            if (!active) {
+                current_time = (horizon > 0 && next_arrival > horizon) ? horizon : next_arrival;
+                continue;
             }
         }
 
         current_time++;
     }
 
+    if (status == sim_horizon_reached || status == sim_cancelled) {
+        sim_checkpoint_t *out = checkpoint_begin(run, checkpoint_multilevel, p, current_time, finished, levels);
+        for (int k = 0; out && k < n; k++) {
+            out->procs[k].op_idx = op_idx[k];
+            out->procs[k].op_remaining = op_left[k];
+            out->procs[k].io_until = io_until[k];
+            out->procs[k].terminated = done[k];
+        }
+        for (int k = 0; out && k < levels; k++)
+            out->cursors[k] = rr_index[k];
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = finished;
+        run->total = n;
+    }
+
     free(procs); free(op_idx); free(op_left); free(io_until); free(done); free(rr_index);
 }
 
@@ -1,21 +1,25 @@
 #include "basic_sched.h"
+#include "checkpoint.h"
 #include <stdlib.h>
 #include <limits.h>
 
-#define AGING_THRESHOLD 5   // Number of ticks before priority promotion
+#define AGING_THRESHOLD 5   // Default number of ticks before priority promotion
 #define HIGH_PRIORITY 10    // Maximum priority (HIGH level)
 #define MEDIUM_PRIORITY 5   // Medium level
 #define LOW_PRIORITY 1      // Minimum priority (LOW level)
 
-void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descriptor, int *size) {
+void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descriptor, int *size,
+                               const aging_params_t *params, sim_run_t *run) {
     if (!p || p->size == 0) return;
 
+    int threshold = (params && params->threshold > 0) ? params->threshold : AGING_THRESHOLD;
+
     int n = p->size;
 
     process_t *procs = malloc(n * sizeof(process_t));
     int *op_idx  = malloc(n * sizeof(int));
-    int *op_left = malloc(n * sizeof(int));
-    int *io_until = malloc(n * sizeof(int));
+    sim_time_t *op_left = malloc(n * sizeof(sim_time_t));
+    sim_time_t *io_until = malloc(n * sizeof(sim_time_t));
     int *done    = malloc(n * sizeof(int));
     int *wait_time = malloc(n * sizeof(int));
 
@@ -36,15 +40,49 @@ void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descript
     }
 
     int finished = 0;
-    int current_time = 0;
-    int max_time = 10000;
+    for (int k = 0; k < n; k++)
+        if (done[k]) finished++;
+    sim_time_t current_time = 0;
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
 
     /* Round-Robin index table for each priority level */
-    int rr_cap = HIGH_PRIORITY + 5;  // Safe capacity based on max priority
+    int rr_cap = SIM_PRIORITY_MAX + 1;  // Every accepted priority (promotion stops at HIGH_PRIORITY)
     int *rr_index = malloc(rr_cap * sizeof(int));
     for (int k = 0; k < rr_cap; k++) rr_index[k] = -1;
 
-    while (finished < n && current_time < max_time) {
+    /* Continue a snapshot: process states, promoted priorities and aging counters */
+    const sim_checkpoint_t *cp = checkpoint_resume(run, checkpoint_aging, p, rr_cap);
+    if (cp) {
+        for (int k = 0; k < n; k++) {
+            op_idx[k] = cp->procs[k].op_idx;
+            op_left[k] = cp->procs[k].op_remaining;
+            io_until[k] = cp->procs[k].io_until;
+            done[k] = cp->procs[k].terminated;
+            wait_time[k] = (int)cp->procs[k].waited;
+            // Promotion only ever lands on the MEDIUM or HIGH level
+            int saved = cp->procs[k].priority;
+            if (saved == MEDIUM_PRIORITY || saved == HIGH_PRIORITY) procs[k].priority_p = saved;
+        }
+        for (int k = 0; k < rr_cap; k++) rr_index[k] = (int)cp->cursors[k];
+        current_time = cp->time;
+        finished = cp->finished;
+    } else if (run && run->resume) {
+        free(procs); free(op_idx); free(op_left); free(io_until); free(done); free(wait_time);
+        free(rr_index);
+        return;
+    }
+
+    while (finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
+
         int cpu_pick = -1;
         int io_pick = -1;
 
@@ -140,12 +178,12 @@ void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descript
 
         /* Execute CPU operation */
         if (cpu_pick >= 0) {
-            process_descriptor_t run;
-            run.process_name = procs[cpu_pick].process_name;
-            run.date = current_time;
-            run.state = running_p;
-            run.operation = calc_p;
-            append_descriptor(descriptor, run, size);
+            process_descriptor_t r;
+            r.process_name = procs[cpu_pick].process_name;
+            r.date = current_time;
+            r.state = running_p;
+            r.operation = calc_p;
+            sim_emit(run, descriptor, size, r);
 
             op_left[cpu_pick]--;
             wait_time[cpu_pick] = 0; // Reset aging when running
@@ -167,7 +205,7 @@ void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descript
 
             wait_time[k]++;
 
-            if (wait_time[k] >= AGING_THRESHOLD) {
+            if (wait_time[k] >= threshold) {
                 // Promote to next priority level (with cap at HIGH_PRIORITY)
                 if (procs[k].priority_p < HIGH_PRIORITY) {
                     int old_priority = procs[k].priority_p;
@@ -188,12 +226,12 @@ void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descript
 
         /* Execute I/O operation */
         if (io_pick >= 0) {
-            process_descriptor_t run;
-            run.process_name = procs[io_pick].process_name;
-            run.date = current_time;
-            run.state = running_p;
-            run.operation = IO_p;
-            append_descriptor(descriptor, run, size);
+            process_descriptor_t r;
+            r.process_name = procs[io_pick].process_name;
+            r.date = current_time;
+            r.state = running_p;
+            r.operation = IO_p;
+            sim_emit(run, descriptor, size, r);
 
             /* Check if I/O completed */
             if (io_until[io_pick] <= current_time + 1) {
@@ -215,30 +253,76 @@ void multilevel_rr_aging_sched(process_queue* p, process_descriptor_t** descript
                 w.date = current_time;
                 w.state = waiting_p;
                 w.operation = none;
-                append_descriptor(descriptor, w, size);
+                sim_emit(run, descriptor, size, w);
             }
         }
 
         /* Check for terminated processes */
+        int terminated_now = 0;
         for (int k = 0; k < n; k++) {
             if (!done[k] &&
                 procs[k].arrival_time_p <= current_time &&
                 op_idx[k] >= procs[k].operations_count && io_until[k] < 0) {
                 done[k] = 1;
                 finished++;
+                terminated_now++;
 
                 process_descriptor_t t;
                 t.process_name = procs[k].process_name;
                 t.date = current_time + 1;
                 t.state = terminated_p;
                 t.operation = none;
-                append_descriptor(descriptor, t, size);
+                sim_emit(run, descriptor, size, t);
+            }
+        }
+
+        // Nothing ran or terminated: skip idle gaps (up to the horizon), detect permanent stalls
+        if (cpu_pick < 0 && io_pick < 0 && !terminated_now) {
+            int active = 0;
+            sim_time_t next_arrival = -1;
+            for (int k = 0; k < n; k++) {
+                if (done[k]) continue;
+                if (procs[k].arrival_time_p > current_time) {
+                    if (next_arrival < 0 || procs[k].arrival_time_p < next_arrival)
+                        next_arrival = procs[k].arrival_time_p;
+                } else {
+                    active = 1;
+                }
+            }
+            if (next_arrival < 0) {
+                status = sim_stalled;
+                current_time++;
+                break;
+            }
+            if (!active) {
+                current_time = (horizon > 0 && next_arrival > horizon) ? horizon : next_arrival;
+                continue;
             }
         }
 
         current_time++;
     }
 
+    if (status == sim_horizon_reached || status == sim_cancelled) {
+        sim_checkpoint_t *out = checkpoint_begin(run, checkpoint_aging, p, current_time, finished, rr_cap);
+        for (int k = 0; out && k < n; k++) {
+            out->procs[k].op_idx = op_idx[k];
+            out->procs[k].op_remaining = op_left[k];
+            out->procs[k].io_until = io_until[k];
+            out->procs[k].terminated = done[k];
+            out->procs[k].priority = procs[k].priority_p;
+            out->procs[k].waited = wait_time[k];
+        }
+        for (int k = 0; out && k < rr_cap; k++) out->cursors[k] = rr_index[k];
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = finished;
+        run->total = n;
+    }
+
     free(procs); free(op_idx); free(op_left); free(io_until); free(done); free(wait_time);
     free(rr_index);
 }
@@ -0,0 +1,77 @@
+#include "name_table.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+void name_table_init(name_table_t* table) {
+    table->keys = NULL;
+    table->slot_ids = NULL;
+    table->cap = 0;
+    table->names = NULL;
+    table->count = 0;
+    table->names_cap = 0;
+}
+
+void name_table_free(name_table_t* table) {
+    free(table->keys);
+    free(table->slot_ids);
+    free(table->names);
+    name_table_init(table);
+}
+
+static unsigned hash_pointer(const char* key) {
+    uintptr_t v = (uintptr_t)key;
+    v ^= v >> 17;
+    v *= 0xed5ad4bbu;
+    v ^= v >> 11;
+    return (unsigned)v;
+}
+
+static void slot_insert(const char** keys, int* ids, int cap, const char* key, int id) {
+    unsigned mask = (unsigned)cap - 1;
+    unsigned slot = hash_pointer(key) & mask;
+    while (keys[slot]) slot = (slot + 1) & mask;
+    keys[slot] = key;
+    ids[slot] = id;
+}
+
+int name_table_id(name_table_t* table, const char* name, int* added) {
+    *added = 0;
+    if (table->cap > 0) {
+        unsigned mask = (unsigned)table->cap - 1;
+        for (unsigned slot = hash_pointer(name) & mask; table->keys[slot]; slot = (slot + 1) & mask) {
+            if (table->keys[slot] == name) return table->slot_ids[slot];
+        }
+    }
+
+    if ((table->count + 1) * 2 > table->cap) {
+        int cap = table->cap ? table->cap * 2 : 64;
+        const char** keys = calloc(cap, sizeof(char*));
+        int* ids = malloc(cap * sizeof(int));
+        if (!keys || !ids) {
+            free(keys);
+            free(ids);
+            return -1;
+        }
+        for (int i = 0; i < table->cap; i++) {
+            if (table->keys[i]) slot_insert(keys, ids, cap, table->keys[i], table->slot_ids[i]);
+        }
+        free(table->keys);
+        free(table->slot_ids);
+        table->keys = keys;
+        table->slot_ids = ids;
+        table->cap = cap;
+    }
+    if (table->count == table->names_cap) {
+        int names_cap = table->names_cap ? table->names_cap * 2 : 64;
+        const char** names = realloc(table->names, names_cap * sizeof(char*));
+        if (!names) return -1;
+        table->names = names;
+        table->names_cap = names_cap;
+    }
+
+    int id = table->count++;
+    table->names[id] = name;
+    slot_insert(table->keys, table->slot_ids, table->cap, name, id);
+    *added = 1;
+    return id;
+}
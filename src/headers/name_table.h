@@ -0,0 +1,22 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+// Dense ids for process names seen while a trace streams by, in order of first
+// appearance. Names are compared by pointer: every record of a run shares the
+// process_name pointer of its process.
+typedef struct name_table_t {
+    const char** keys;         // Open addressing, NULL = free
+    int* slot_ids;
+    int cap;                   // Power of two, load factor <= 1/2
+    const char** names;        // Name of every id
+    int count;
+    int names_cap;
+} name_table_t;
+
+void name_table_init(name_table_t* table);
+void name_table_free(name_table_t* table);
+
+// Id of a name, assigning the next one on first sight (*added set then); -1 when out of memory
+int name_table_id(name_table_t* table, const char* name, int* added);
+
+#endif
@@ -1,6 +1,8 @@
+#define _POSIX_C_SOURCE 200809L
 #include "ncurses_display.h"
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
 
 // Color pairs
 #define COLOR_CALC 1    // Green for CALC
@@ -41,6 +43,11 @@ available_algorithms_t check_available_algorithms() {
     avail.priority_available = (priority_sched != NULL);
     avail.multilevel_available = (multilevel_rr_sched != NULL);
     avail.multilevel_aging_available = (multilevel_rr_aging_sched != NULL);
+    avail.cfs_available = (cfs_sched != NULL);
+    avail.lottery_available = (lottery_sched != NULL);
+    avail.stride_available = (stride_sched != NULL);
+    avail.edf_available = (edf_sched != NULL);
+    avail.mlfq_available = (mlfq_sched != NULL);
     
     return avail;
 }
@@ -108,6 +115,47 @@ int show_menu() {
         attroff(COLOR_PAIR(COLOR_WAIT));
     }
     
+    if (avail.cfs_available) {
+        mvprintw(line++, (width - 50) / 2, "  6. Completely Fair Scheduler (CFS)");
+    } else {
+        attron(COLOR_PAIR(COLOR_WAIT));
+        mvprintw(line++, (width - 50) / 2, "  6. Completely Fair Scheduler (Not Available)");
+        attroff(COLOR_PAIR(COLOR_WAIT));
+    }
+    
+    if (avail.lottery_available) {
+        mvprintw(line++, (width - 50) / 2, "  7. Lottery Scheduling");
+    } else {
+        attron(COLOR_PAIR(COLOR_WAIT));
+        mvprintw(line++, (width - 50) / 2, "  7. Lottery Scheduling (Not Available)");
+        attroff(COLOR_PAIR(COLOR_WAIT));
+    }
+    
+    if (avail.stride_available) {
+        mvprintw(line++, (width - 50) / 2, "  8. Stride Scheduling");
+    } else {
+        attron(COLOR_PAIR(COLOR_WAIT));
+        mvprintw(line++, (width - 50) / 2, "  8. Stride Scheduling (Not Available)");
+        attroff(COLOR_PAIR(COLOR_WAIT));
+    }
+    
+    if (avail.edf_available) {
+        mvprintw(line++, (width - 50) / 2, "  9. Earliest Deadline First (EDF)");
+    } else {
+        attron(COLOR_PAIR(COLOR_WAIT));
+        mvprintw(line++, (width - 50) / 2, "  9. Earliest Deadline First (Not Available)");
+        attroff(COLOR_PAIR(COLOR_WAIT));
+    }
+    
+    if (avail.mlfq_available) {
+        mvprintw(line++, (width - 50) / 2, " 10. Multi-level Feedback Queue (MLFQ)");
+    } else {
+        attron(COLOR_PAIR(COLOR_WAIT));
+        mvprintw(line++, (width - 50) / 2, " 10. Multi-level Feedback Queue (Not Available)");
+        attroff(COLOR_PAIR(COLOR_WAIT));
+    }
+    
+    mvprintw(line++, (width - 50) / 2, " 11. Compare all policies");
     mvprintw(line++, (width - 50) / 2, "  0. Exit");
     
     attron(COLOR_PAIR(COLOR_HEADER));
@@ -147,6 +195,102 @@ int get_quantum() {
     return quantum;
 }
 
+cfs_params_t get_cfs_params() {
+    int height, width;
+    getmaxyx(stdscr, height, width);
+    
+    cfs_params_t params;
+    long long value;
+    
+    echo();
+    curs_set(1);
+    
+    attron(COLOR_PAIR(COLOR_HEADER));
+    mvprintw(height / 2, (width - 40) / 2, "Target latency (0=default 20): ");
+    attroff(COLOR_PAIR(COLOR_HEADER));
+    refresh();
+    value = 0;
+    scanw("%lld", &value);
+    params.target_latency = value;
+    
+    attron(COLOR_PAIR(COLOR_HEADER));
+    mvprintw(height / 2 + 1, (width - 40) / 2, "Minimum granularity (0=default 2): ");
+    attroff(COLOR_PAIR(COLOR_HEADER));
+    refresh();
+    value = 0;
+    scanw("%lld", &value);
+    params.min_granularity = value;
+    
+    curs_set(0);
+    noecho();
+    
+    return params;
+}
+
+uint64_t get_seed() {
+    int height, width;
+    getmaxyx(stdscr, height, width);
+    
+    attron(COLOR_PAIR(COLOR_HEADER));
+    mvprintw(height / 2 + 1, (width - 40) / 2, "Random seed (0=default 1): ");
+    attroff(COLOR_PAIR(COLOR_HEADER));
+    
+    refresh();
+    
+    echo();
+    curs_set(1);
+    unsigned long long seed = 0;
+    scanw("%llu", &seed);
+    curs_set(0);
+    noecho();
+    
+    if (seed == 0) seed = 1;
+    return seed;
+}
+
+mlfq_params_t get_mlfq_params() {
+    int height, width;
+    getmaxyx(stdscr, height, width);
+    
+    mlfq_params_t params;
+    params.levels = 0;
+    for (int l = 0; l < MLFQ_MAX_LEVELS; l++) params.quanta[l] = 0;
+    
+    echo();
+    curs_set(1);
+    
+    // One quantum per level, e.g. "2,4,8" for three levels
+    attron(COLOR_PAIR(COLOR_HEADER));
+    mvprintw(height / 2, (width - 40) / 2, "Quanta per level (default 2,4,8): ");
+    attroff(COLOR_PAIR(COLOR_HEADER));
+    refresh();
+    char buffer[128] = "";
+    getnstr(buffer, sizeof(buffer) - 1);
+    
+    char* cursor = buffer;
+    while (*cursor && params.levels < MLFQ_MAX_LEVELS) {
+        char* end;
+        long long q = strtoll(cursor, &end, 10);
+        if (end == cursor) break;
+        params.quanta[params.levels++] = q;
+        cursor = end;
+        while (*cursor == ',' || *cursor == ' ') cursor++;
+    }
+    
+    attron(COLOR_PAIR(COLOR_HEADER));
+    mvprintw(height / 2 + 1, (width - 40) / 2, "Boost period (0=default 50, -1=never): ");
+    attroff(COLOR_PAIR(COLOR_HEADER));
+    refresh();
+    long long boost = 0;
+    scanw("%lld", &boost);
+    params.boost_period = boost;
+    
+    curs_set(0);
+    noecho();
+    
+    return params;
+}
+
 /*
 static const char* state_to_char(process_state state) {
     switch (state) {
@@ -177,41 +321,54 @@ static int get_color_for_operation(process_operation_t op, process_state state)
     return COLOR_WAIT;
 }
 
-void display_gantt_chart(process_descriptor_t* descriptor, int size) {
-    if (size == 0) return;
-    
-    clear();
-    
-    // Find unique processes and max time
-    char proc_names[100][64];
-    int proc_count = 0;
-    int max_time = 0;
-    
-    for (int i = 0; i < size; i++) {
-        int found = 0;
-        for (int j = 0; j < proc_count; j++) {
-            if (strcmp(proc_names[j], descriptor[i].process_name) == 0) {
-                found = 1;
-                break;
-            }
-        }
-        if (!found) {
-            strncpy(proc_names[proc_count], descriptor[i].process_name, 63);
-            proc_names[proc_count][63] = '\0';
-            proc_count++;
-        }
-        if (descriptor[i].date > max_time) max_time = descriptor[i].date;
+static int get_color_for_cell(trace_cell_t cell) {
+    switch (cell) {
+        case cell_calc: return COLOR_CALC;
+        case cell_io: return COLOR_IO;
+        case cell_term: return COLOR_TERM;
+        default: return COLOR_WAIT;
     }
-    
-    int height, width;
-    getmaxyx(stdscr, height, width);
-    
-    // Title
+}
+
+// One Gantt column: colored glyph (ACS characters for compatibility) + separator
+static void draw_gantt_glyph(WINDOW* win, trace_cell_t cell, chtype glyph) {
+    if (cell != cell_empty) {
+        wattron(win, COLOR_PAIR(get_color_for_cell(cell)));
+        waddch(win, glyph);
+        wattroff(win, COLOR_PAIR(get_color_for_cell(cell)));
+    } else {
+        waddch(win, ' ');
+    }
+    waddch(win, '|');
+}
+
+static void draw_gantt_cell(WINDOW* win, trace_cell_t cell) {
+    draw_gantt_glyph(win, cell, ACS_CKBOARD);
+}
+
+// Zoomed column: color of the dominant cell, density from its share of the column's ticks
+static void draw_gantt_summary(WINDOW* win, const trace_lod_cell_t* sum, sim_time_t ticks) {
+    trace_cell_t cell = trace_lod_dominant(sum);
+    uint32_t share = 0;
+    switch (cell) {
+        case cell_calc: share = sum->calc; break;
+        case cell_io: share = sum->io; break;
+        case cell_wait: share = sum->wait; break;
+        case cell_term: share = sum->term; break;
+        default: break;
+    }
+    chtype glyph = ACS_CKBOARD;
+    if ((sim_time_t)share * 4 < ticks) glyph = '.';
+    else if ((sim_time_t)share * 4 < ticks * 3) glyph = ':';
+    draw_gantt_glyph(win, cell, glyph);
+}
+
+// Title and color legend shared by the Gantt views
+static void draw_gantt_legend(int width, const char* title) {
     attron(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
-    mvprintw(0, (width - 40) / 2, "        GANTT CHART - SCHEDULING        ");
+    mvprintw(0, (width - 40) / 2, "%s", title);
     attroff(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
     
-    // Legend with colored blocks (using ACS characters for compatibility)
     attron(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
     mvprintw(2, 2, "Legend: ");
     attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
@@ -235,95 +392,217 @@ void display_gantt_chart(process_descriptor_t* descriptor, int size) {
     addch(ACS_CKBOARD);
     printw("=Term");
     attroff(COLOR_PAIR(COLOR_TERM));
+}
+
+/*
+ * Pad-based Gantt rendering.
+ *
+ * At zoom level z every column summarizes 2^z ticks (read from the trace_lod_t pyramid).
+ * The chart is cut into tiles of GANTT_TILE_PROCS processes x tile_cols columns, each
+ * rendered once into an off-screen pad the first time it becomes visible. Scrolling only
+ * copies pad rectangles to the virtual screen (pnoutrefresh) and lets doupdate() send the
+ * cells that actually changed, so nothing is cleared or reprinted per keypress.
+ */
+#define GANTT_TILE_COLS 500    // Minimum columns per tile (multiple of 10: periodic header)
+#define GANTT_TILE_PROCS 64    // Minimum processes per tile
+#define GANTT_TILE_CACHE 6     // View over 2x2 body tiles + 2 name tiles
+#define GANTT_TOP 6            // First screen row of the process area
+#define GANTT_LEFT 18          // First screen column of the tick area
+#define GANTT_NAME_TILE -1     // Tile column holding the process names
+#define GANTT_LOD_BUDGET (64u << 20)  // Bytes for the precomputed zoom levels
+
+typedef struct gantt_tile_t {
+    WINDOW* pad;
+    sim_time_t tx;             // Tile column, GANTT_NAME_TILE for names
+    int ty;                    // Tile row
+    int zoom;                  // Zoom level the tile was rendered at
+    unsigned long used;        // LRU stamp
+} gantt_tile_t;
+
+typedef struct gantt_view_t {
+    const trace_index_t* index;
+    const trace_lod_t* lod;
+    int zoom;                  // Column = 2^zoom ticks
+    sim_time_t tile_cols;
+    int tile_procs;
+    gantt_tile_t tiles[GANTT_TILE_CACHE];
+    unsigned long clock;
+    WINDOW* header;            // Time header, periodic with 10 ticks
+    trace_lod_cell_t* row;     // Scratch row of tile_cols summaries
+} gantt_view_t;
+
+static void gantt_view_init(gantt_view_t* view, const trace_index_t* index, const trace_lod_t* lod,
+                            int view_ticks, int view_rows) {
+    memset(view, 0, sizeof(*view));
+    view->index = index;
+    view->lod = lod;
+    view->tile_cols = GANTT_TILE_COLS;
+    if (view->tile_cols < view_ticks) view->tile_cols = (view_ticks + 9) / 10 * 10;
+    view->tile_procs = (view_rows > GANTT_TILE_PROCS) ? view_rows : GANTT_TILE_PROCS;
+    view->row = malloc(view->tile_cols * sizeof(trace_lod_cell_t));
+
+    view->header = newpad(2, 2 * (view_ticks + 10));
+    for (int t = 0; t < view_ticks + 10; t++) {
+        mvwprintw(view->header, 0, 2 * t, "%d|", t % 10);
+        mvwprintw(view->header, 1, 2 * t, "--");
+    }
+}
+
+static void gantt_view_free(gantt_view_t* view) {
+    for (int i = 0; i < GANTT_TILE_CACHE; i++) {
+        if (view->tiles[i].pad) delwin(view->tiles[i].pad);
+    }
+    if (view->header) delwin(view->header);
+    free(view->row);
+}
+
+static void gantt_render_tile(gantt_view_t* view, gantt_tile_t* tile) {
+    const trace_index_t* index = view->index;
+    int p0 = tile->ty * view->tile_procs;
+    int p1 = p0 + view->tile_procs;
+    if (p1 > index->proc_count) p1 = index->proc_count;
+
+    if (tile->tx == GANTT_NAME_TILE) {
+        tile->pad = newpad(2 * view->tile_procs, GANTT_LEFT - 2);
+        for (int p = p0; p < p1; p++) {
+            mvwprintw(tile->pad, 2 * (p - p0), 0, "%-14.14s |", index->proc_names[p]);
+        }
+        return;
+    }
+
+    tile->pad = newpad(2 * view->tile_procs, 2 * (int)view->tile_cols);
+    sim_time_t c0 = tile->tx * view->tile_cols;
+    sim_time_t count = trace_lod_columns(view->lod, tile->zoom) - c0;
+    if (count > view->tile_cols) count = view->tile_cols;
+    for (int p = p0; p < p1 && count > 0; p++) {
+        trace_lod_row(view->lod, p, tile->zoom, c0, (int)count, view->row);
+        wmove(tile->pad, 2 * (p - p0), 0);
+        for (int c = 0; c < count; c++) {
+            draw_gantt_summary(tile->pad, &view->row[c], (sim_time_t)1 << tile->zoom);
+        }
+    }
+}
+
+// Rendered pad of a tile, evicting the least recently used one on a miss
+static WINDOW* gantt_tile(gantt_view_t* view, sim_time_t tx, int ty) {
+    int zoom = (tx == GANTT_NAME_TILE) ? 0 : view->zoom;
+    gantt_tile_t* victim = &view->tiles[0];
+    for (int i = 0; i < GANTT_TILE_CACHE; i++) {
+        gantt_tile_t* tile = &view->tiles[i];
+        if (tile->pad && tile->tx == tx && tile->ty == ty && tile->zoom == zoom) {
+            tile->used = ++view->clock;
+            return tile->pad;
+        }
+        if (!tile->pad || (victim->pad && tile->used < victim->used)) victim = tile;
+    }
+
+    if (victim->pad) delwin(victim->pad);
+    victim->tx = tx;
+    victim->ty = ty;
+    victim->zoom = zoom;
+    victim->used = ++view->clock;
+    gantt_render_tile(view, victim);
+    return victim->pad;
+}
+
+// Copy the visible window (scroll_x in columns of the current zoom) to the virtual screen;
+// the caller runs doupdate()
+static void gantt_view_show(gantt_view_t* view, sim_time_t scroll_x, int scroll_y,
+                            int view_ticks, int view_rows) {
+    const trace_index_t* index = view->index;
+    sim_time_t x_end = scroll_x + view_ticks;
+    sim_time_t columns = trace_lod_columns(view->lod, view->zoom);
+    if (x_end > columns) x_end = columns;
+    int y_end = scroll_y + view_rows;
+    if (y_end > index->proc_count) y_end = index->proc_count;
+    if (x_end <= scroll_x || y_end <= scroll_y) return;
+
+    pnoutrefresh(view->header, 0, 2 * (int)(scroll_x % 10), GANTT_TOP - 2, GANTT_LEFT,
+                 GANTT_TOP - 1, GANTT_LEFT + 2 * (int)(x_end - scroll_x) - 1);
+
+    for (int ty = scroll_y / view->tile_procs; ty * view->tile_procs < y_end; ty++) {
+        int p_from = ty * view->tile_procs;
+        if (p_from < scroll_y) p_from = scroll_y;
+        int p_to = (ty + 1) * view->tile_procs;
+        if (p_to > y_end) p_to = y_end;
+        int pad_row = 2 * (p_from - ty * view->tile_procs);
+        int screen_row = GANTT_TOP + 2 * (p_from - scroll_y);
+        int screen_last = screen_row + 2 * (p_to - p_from) - 1;
+
+        pnoutrefresh(gantt_tile(view, GANTT_NAME_TILE, ty), pad_row, 0,
+                     screen_row, 2, screen_last, GANTT_LEFT - 1);
+
+        for (sim_time_t tx = scroll_x / view->tile_cols; tx * view->tile_cols < x_end; tx++) {
+            sim_time_t t_from = tx * view->tile_cols;
+            if (t_from < scroll_x) t_from = scroll_x;
+            sim_time_t t_to = (tx + 1) * view->tile_cols;
+            if (t_to > x_end) t_to = x_end;
+            int screen_col = GANTT_LEFT + 2 * (int)(t_from - scroll_x);
+
+            pnoutrefresh(gantt_tile(view, tx, ty), pad_row, 2 * (int)(t_from - tx * view->tile_cols),
+                         screen_row, screen_col, screen_last, screen_col + 2 * (int)(t_to - t_from) - 1);
+        }
+    }
+}
+
+void display_gantt_chart(const trace_source_t* trace, const trace_index_t* index) {
+    if (trace->size == 0) return;
     
-    // Scrolling variables
-    int scroll_x = 0;
+    clear();
+    
+    int proc_count = index->proc_count;
+    sim_time_t max_time = index->max_time;
+    
+    int height, width;
+    getmaxyx(stdscr, height, width);
+    
+    draw_gantt_legend(width, "        GANTT CHART - SCHEDULING        ");
+    mvprintw(GANTT_TOP - 2, 2, "Process        |");
+    mvprintw(GANTT_TOP - 1, 2, "---------------|");
+    
+    // Zoom pyramid: each column summarizes 2^zoom ticks
+    trace_lod_t lod;
+    trace_lod_build(&lod, index, GANTT_LOD_BUDGET);
+    
+    // Scrolling variables (2 columns per tick, 2 rows per process), scroll_x in columns
+    sim_time_t scroll_x = 0;
     int scroll_y = 0;
-    int view_width = width - 20;
-    int view_height = height - 10;
+    int view_width = (width - GANTT_LEFT - 1) / 2;
+    int view_height = (height - GANTT_TOP - 2) / 2;
+    if (view_width < 1) view_width = 1;
+    if (view_height < 1) view_height = 1;
+    int max_scroll_y = (proc_count > view_height) ? proc_count - view_height : 0;
     
+    gantt_view_t view;
+    gantt_view_init(&view, index, &lod, view_width, view_height);
+    
+    int shown_zoom = view.zoom;
     int running = 1;
     while (running) {
-        // Clear display area
-        for (int i = 4; i < height - 2; i++) {
-            move(i, 0);
-            clrtoeol();
-        }
-        
-        // Display time header (with separators)
-        mvprintw(4, 2, "Process        |");
-        for (int t = scroll_x; t < scroll_x + view_width && t <= max_time; t++) {
-            printw("%d|", t % 10);
-        }
-        
-        mvprintw(5, 2, "---------------|");
-        for (int t = scroll_x; t < scroll_x + view_width && t <= max_time; t++) {
-            printw("--");
-        }
+        sim_time_t columns = trace_lod_columns(&lod, view.zoom);
+        sim_time_t max_scroll_x = (columns > view_width) ? columns - view_width : 0;
+        if (scroll_x > max_scroll_x) scroll_x = max_scroll_x;
+        sim_time_t first_tick = scroll_x << view.zoom;
+        sim_time_t last_tick = ((scroll_x + view_width) << view.zoom) - 1;
+        if (last_tick > max_time) last_tick = max_time;
         
-        // Display each process timeline
-        for (int p = scroll_y; p < scroll_y + view_height && p < proc_count; p++) {
-            mvprintw(6 + (p - scroll_y) * 2, 2, "%-14s |", proc_names[p]);
-            
-            // Build timeline for this process
-            char timeline[10000];
-            for (int t = 0; t <= max_time; t++) {
-                timeline[t] = ' ';
-            }
-            
-            for (int i = 0; i < size; i++) {
-                if (strcmp(descriptor[i].process_name, proc_names[p]) == 0) {
-                    int t = descriptor[i].date;
-                    if (t >= 0 && t <= max_time) {
-                        if (descriptor[i].state == running_p) {
-                            timeline[t] = (descriptor[i].operation == calc_p) ? 'C' : 'I';
-                        } else if (descriptor[i].state == waiting_p) {
-                            timeline[t] = 'W';
-                        } else if (descriptor[i].state == terminated_p) {
-                            timeline[t] = 'T';
-                        }
-                    }
-                }
-            }
-            
-            // Display visible portion with colored blocks (using ACS characters)
-            for (int t = scroll_x; t < scroll_x + view_width && t <= max_time; t++) {
-                char ch = timeline[t];
-                int color = COLOR_WAIT;
-                
-                // Find the descriptor for this time to get proper color
-                for (int i = 0; i < size; i++) {
-                    if (strcmp(descriptor[i].process_name, proc_names[p]) == 0 && descriptor[i].date == t) {
-                        color = get_color_for_operation(descriptor[i].operation, descriptor[i].state);
-                        break;
-                    }
-                }
-                
-                if (ch != ' ') {
-                    attron(COLOR_PAIR(color));
-                    // Map characters to ncurses ACS block characters
-                    if (ch == 'C' || ch == 'I') {
-                        addch(ACS_CKBOARD);  // Checker board for CALC/I/O
-                    } else if (ch == 'W' || ch == 'T') {
-                        addch(ACS_CKBOARD); // Checker board for Wait/Terminated
-                    }
-                    attroff(COLOR_PAIR(color));
-                    addch('|'); // Separator after each tick
-                } else {
-                    addch(' ');
-                    addch('|'); // Separator for empty ticks
-                }
-            }
-        }
-        
-        // Status bar
+        // Status bar is the only stdscr line that changes
         attron(COLOR_PAIR(COLOR_HEADER));
-        mvprintw(height - 2, 0, " Time: %d-%d | Process: %d-%d | Arrow keys=scroll | q/Enter/Space=continue ",
-                 scroll_x, scroll_x + view_width, scroll_y + 1, 
+        mvprintw(height - 2, 0, " Time: %lld-%lld | 1 col = %lld ticks | Process: %d-%d | Arrows=scroll +/-=zoom | q=continue ",
+                 (long long)first_tick, (long long)last_tick, (long long)1 << view.zoom, scroll_y + 1,
                  (scroll_y + view_height < proc_count) ? scroll_y + view_height : proc_count);
+        clrtoeol();
         attroff(COLOR_PAIR(COLOR_HEADER));
         
-        refresh();
+        // A zoom change can shrink the chart: repaint the blank background under it
+        if (view.zoom != shown_zoom) {
+            touchwin(stdscr);
+            shown_zoom = view.zoom;
+        }
+        
+        wnoutrefresh(stdscr);
+        gantt_view_show(&view, scroll_x, scroll_y, view_width, view_height);
+        doupdate();
         
         // Handle input
         int ch = getch();
@@ -332,13 +611,34 @@ void display_gantt_chart(process_descriptor_t* descriptor, int size) {
                 if (scroll_x > 0) scroll_x--;
                 break;
             case KEY_RIGHT:
-                if (scroll_x < max_time - view_width) scroll_x++;
+                if (scroll_x < max_scroll_x) scroll_x++;
+                break;
+            case KEY_PPAGE:
+                scroll_x = (scroll_x > view_width) ? scroll_x - view_width : 0;
+                break;
+            case KEY_NPAGE:
+                scroll_x = (scroll_x + view_width < max_scroll_x) ? scroll_x + view_width : max_scroll_x;
                 break;
             case KEY_UP:
                 if (scroll_y > 0) scroll_y--;
                 break;
             case KEY_DOWN:
-                if (scroll_y < proc_count - view_height) scroll_y++;
+                if (scroll_y < max_scroll_y) scroll_y++;
+                break;
+            case '-':
+                // Zoom out, keeping the first visible tick in view
+                if (view.zoom < lod.top_level) {
+                    view.zoom++;
+                    scroll_x = first_tick >> view.zoom;
+                }
+                break;
+            case '+':
+            case '=':
+                // Zoom in around the first visible tick
+                if (view.zoom > 0) {
+                    view.zoom--;
+                    scroll_x = first_tick >> view.zoom;
+                }
                 break;
             case 'q':
             case 'Q':
@@ -348,152 +648,291 @@ void display_gantt_chart(process_descriptor_t* descriptor, int size) {
                 break;
         }
     }
+    
+    gantt_view_free(&view);
+    trace_lod_free(&lod);
 }
 
-void display_realtime_gantt(process_descriptor_t* descriptor, int size, int delay_ms) {
-    if (size == 0) return;
-    
-    clear();
-    
-    // Find unique processes and max time
-    char proc_names[100][64];
-    int proc_count = 0;
-    int max_time = 0;
-    
-    for (int i = 0; i < size; i++) {
-        int found = 0;
-        for (int j = 0; j < proc_count; j++) {
-            if (strcmp(proc_names[j], descriptor[i].process_name) == 0) {
-                found = 1;
+/*
+ * Playback of a run streaming into an event ring.
+ *
+ * Simulated time advances at `speed` ticks per second of wall time, but the terminal is
+ * updated at most LIVE_MAX_FPS times per second: every tick due since the last frame is
+ * applied to the model and only the final state is drawn (frames are dropped, ticks
+ * never are). Input is
+ * polled with a frame-long timeout so the controls stay responsive while playing.
+ *
+ * The model keeps the cells of the current page for every process, not only for the
+ * rows on screen, so scrolling vertically just redraws another window of rows.
+ */
+#define LIVE_MAX_FPS 30
+#define LIVE_MIN_SPEED 0.125           // Ticks per second
+#define LIVE_MAX_SPEED 1048576.0
+
+typedef struct live_view_t {
+    event_ring_t* ring;
+    int height;
+    int view_ticks;
+    int view_rows;
+    name_table_t rows;         // Row of each process, by first appearance
+    int row_cap;               // Rows allocated in cells and drawn
+    unsigned char* cells;      // Cells of the current page, view_ticks per row
+    sim_time_t* drawn;         // Last tick set on each row
+    int top;                   // First row on screen
+    sim_time_t page;           // First tick of the current page
+    sim_time_t next_tick;      // Next tick to apply
+    process_descriptor_t record;
+    int has_record;
+    int done;                  // Trace drained
+} live_view_t;
+
+// Room for row r in the model; 0 when out of memory
+static int live_reserve(live_view_t* live, int r) {
+    if (r < live->row_cap) return 1;
+    int cap = live->row_cap ? live->row_cap * 2 : 64;
+    while (cap <= r) cap *= 2;
+    unsigned char* cells = realloc(live->cells, (size_t)cap * live->view_ticks);
+    if (!cells) return 0;
+    live->cells = cells;
+    sim_time_t* drawn = realloc(live->drawn, (size_t)cap * sizeof(sim_time_t));
+    if (!drawn) return 0;
+    live->drawn = drawn;
+    live->row_cap = cap;
+    return 1;
+}
+
+// Apply tick next_tick from the ring; sets done once the simulation has no more records
+static void live_advance(live_view_t* live) {
+    sim_time_t t = live->next_tick;
+    if (t - live->page >= live->view_ticks) live->page = t;
+    int col = (int)(t - live->page);
+    
+    // Every record of tick t (records arrive in time order)
+    for (;;) {
+        if (!live->has_record) {
+            if (event_ring_pop(live->ring, &live->record)) {
+                live->has_record = 1;
+            } else if (event_ring_finished(live->ring)) {
+                live->done = 1;
                 break;
+            } else {
+                event_ring_pause();   // Simulation thread is still working
+                continue;
             }
         }
-        if (!found) {
-            strncpy(proc_names[proc_count], descriptor[i].process_name, 63);
-            proc_names[proc_count][63] = '\0';
-            proc_count++;
+        if (live->record.date > t) break;
+        live->has_record = 0;
+        
+        int added;
+        int r = name_table_id(&live->rows, live->record.process_name, &added);
+        if (r < 0 || !live_reserve(live, r)) continue;
+        unsigned char* row = live->cells + (size_t)r * live->view_ticks;
+        if (added) {
+            memset(row, cell_empty, col);
+            live->drawn[r] = -1;
+        }
+        if (live->record.date >= live->page && live->record.date > live->drawn[r]) {
+            row[live->record.date - live->page] = (unsigned char)trace_cell_of(&live->record);
+            live->drawn[r] = live->record.date;
         }
-        if (descriptor[i].date > max_time) max_time = descriptor[i].date;
     }
     
-    int height, width;
-    getmaxyx(stdscr, height, width);
-    
-    // Title
-    attron(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
-    mvprintw(0, (width - 40) / 2, "   REAL-TIME GANTT CHART SIMULATION     ");
-    attroff(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
-    
-    // Legend (using ACS characters for compatibility)
-    attron(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
-    mvprintw(2, 2, "Legend: ");
-    attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
-    
-    attron(COLOR_PAIR(COLOR_CALC));
-    addch(ACS_CKBOARD);
-    printw("=CALC  ");
-    attroff(COLOR_PAIR(COLOR_CALC));
-    
-    attron(COLOR_PAIR(COLOR_IO));
-    addch(ACS_CKBOARD);
-    printw("=I/O  ");
-    attroff(COLOR_PAIR(COLOR_IO));
+    // Empty tick for the known processes without a record
+    for (int r = 0; r < live->rows.count && r < live->row_cap; r++) {
+        if (live->drawn[r] < t) {
+            live->cells[(size_t)r * live->view_ticks + col] = cell_empty;
+            live->drawn[r] = t;
+        }
+    }
     
-    attron(COLOR_PAIR(COLOR_WAIT));
-    addch(ACS_CKBOARD);
-    printw("=Wait  ");
-    attroff(COLOR_PAIR(COLOR_WAIT));
+    live->next_tick = t + 1;
+}
+
+// Keep the first row on screen within the known rows
+static void live_scroll(live_view_t* live, int rows) {
+    int max_top = live->rows.count - live->view_rows;
+    live->top += rows;
+    if (live->top > max_top) live->top = max_top;
+    if (live->top < 0) live->top = 0;
+}
+
+// Redraw the chart area: the ticks of the current page for the rows on screen
+static void live_draw(const live_view_t* live) {
+    for (int i = GANTT_TOP - 2; i < live->height - 2; i++) {
+        move(i, 0);
+        clrtoeol();
+    }
+    mvprintw(GANTT_TOP - 2, 2, "Process        |");
+    mvprintw(GANTT_TOP - 1, 2, "---------------|");
+    int shown = (int)(live->next_tick - live->page);
+    for (int c = 0; c < shown; c++) {
+        mvprintw(GANTT_TOP - 2, GANTT_LEFT + c * 2, "%d|", (int)((live->page + c) % 10));
+        mvprintw(GANTT_TOP - 1, GANTT_LEFT + c * 2, "--");
+    }
+    for (int v = 0; v < live->view_rows; v++) {
+        int r = live->top + v;
+        if (r >= live->rows.count || r >= live->row_cap) break;
+        mvprintw(GANTT_TOP + v * 2, 2, "%-14.14s |", live->rows.names[r]);
+        move(GANTT_TOP + v * 2, GANTT_LEFT);
+        const unsigned char* row = live->cells + (size_t)r * live->view_ticks;
+        for (int c = 0; c < shown; c++) draw_gantt_cell(stdscr, (trace_cell_t)row[c]);
+    }
+}
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Ask for a tick on the status bar, -1 when the input is empty or invalid
+static sim_time_t prompt_time(int height) {
+    char buffer[32];
     
-    attron(COLOR_PAIR(COLOR_TERM));
-    addch(ACS_CKBOARD);
-    printw("=Term");
-    attroff(COLOR_PAIR(COLOR_TERM));
+    timeout(-1);
+    attron(COLOR_PAIR(COLOR_HEADER));
+    mvprintw(height - 2, 0, " Jump to time: ");
+    clrtoeol();
+    attroff(COLOR_PAIR(COLOR_HEADER));
+    refresh();
     
-    // Display process headers
-    mvprintw(4, 2, "Process        |");
-    mvprintw(5, 2, "---------------|");
+    echo();
+    curs_set(1);
+    int ok = getnstr(buffer, sizeof(buffer) - 1);
+    curs_set(0);
+    noecho();
     
-    for (int p = 0; p < proc_count && p < height - 10; p++) {
-        mvprintw(6 + p * 2, 2, "%-14s |", proc_names[p]);
-    }
+    char* end;
+    long long value = strtoll(buffer, &end, 10);
+    if (ok == ERR || end == buffer || value < 0) return -1;
+    return value;
+}
+
+void display_realtime_gantt(event_ring_t* ring, int delay_ms) {
+    clear();
     
-    refresh();
+    int height, width;
+    getmaxyx(stdscr, height, width);
     
-    // Animate tick by tick
-    timeout(delay_ms);
-    for (int t = 0; t <= max_time; t++) {
-        // Update time header (with separator)
-        mvprintw(4, 17 + (t * 2), "%d|", t % 10);
+    draw_gantt_legend(width, "   REAL-TIME GANTT CHART SIMULATION     ");
+    
+    live_view_t live;
+    memset(&live, 0, sizeof(live));
+    live.ring = ring;
+    live.height = height;
+    live.view_ticks = (width - GANTT_LEFT - 1) / 2;
+    live.view_rows = (height - GANTT_TOP - 2) / 2;
+    if (live.view_ticks < 1) live.view_ticks = 1;
+    if (live.view_rows < 0) live.view_rows = 0;
+    name_table_init(&live.rows);
+    
+    double speed = (delay_ms > 0) ? 1000.0 / delay_ms : LIVE_MAX_SPEED;
+    int paused = 0;
+    double owed = 1.0;            // Ticks due but not applied yet (tick 0 shows at once)
+    double last = wall_seconds();
+    double frame = 1.0 / LIVE_MAX_FPS;
+    
+    timeout(1000 / LIVE_MAX_FPS);
+    int quit = 0;
+    while (!live.done && !quit) {
+        double now = wall_seconds();
+        if (!paused) owed += (now - last) * speed;
+        last = now;
         
-        // Update each process for this time tick
-        for (int p = 0; p < proc_count && p < height - 10; p++) {
-            // Find descriptor for this process at this time
-            char ch = ' ';
-            int color = COLOR_WAIT;
-            
-            for (int i = 0; i < size; i++) {
-                if (strcmp(descriptor[i].process_name, proc_names[p]) == 0 && 
-                    descriptor[i].date == t) {
-                    color = get_color_for_operation(descriptor[i].operation, descriptor[i].state);
-                    
-                    if (descriptor[i].state == running_p) {
-                        ch = (descriptor[i].operation == calc_p) ? 'C' : 'I';
-                    } else if (descriptor[i].state == waiting_p) {
-                        ch = 'W';
-                    } else if (descriptor[i].state == terminated_p) {
-                        ch = 'T';
-                    }
-                    break;
-                }
-            }
-            
-            // Display the block at the correct position (2 chars per tick: block + separator)
-            int display_col = 17 + (t * 2);
-            if (display_col < width - 2) {
-                move(6 + p * 2, display_col);
-                if (ch != ' ') {
-                    attron(COLOR_PAIR(color));
-                    // Map to ncurses ACS block characters
-                    if (ch == 'C' || ch == 'I') {
-                        addch(ACS_CKBOARD);  // Checker board for CALC/I/O
-                    } else if (ch == 'W' || ch == 'T') {
-                        addch(ACS_CKBOARD); // Checker board for Wait/Terminated
-                    }
-                    attroff(COLOR_PAIR(color));
-                    addch('|'); // Separator after each tick
-                } else {
-                    addch(' ');
-                    addch('|'); // Separator for empty ticks
-                }
-            }
+        // Apply the due ticks to the model; only live_draw() below touches the screen.
+        // Ticks that do not fit in a frame stay owed for the next ones, so a slow
+        // stretch delays the playback but never skips ticks
+        while (!paused && owed >= 1.0 && !live.done) {
+            live_advance(&live);
+            owed -= 1.0;
+            if (wall_seconds() - now > frame) break;
         }
+        live_draw(&live);
         
         // Status bar
+        int last_row = live.top + live.view_rows;
+        if (last_row > live.rows.count) last_row = live.rows.count;
         attron(COLOR_PAIR(COLOR_HEADER));
-        mvprintw(height - 2, 0, " Time: %d/%d | Press 'q' to skip animation, any other key to continue... ", 
-                 t, max_time);
+        mvprintw(height - 2, 0, " Time: %lld | %g ticks/s%s | Rows %d-%d/%d | Space=pause s=step +/-=speed g=jump e=end Up/Down/PgUp/PgDn=rows q=skip ",
+                 (long long)(live.next_tick > 0 ? live.next_tick - 1 : 0), speed, paused ? " (paused)" : "",
+                 live.rows.count > 0 ? live.top + 1 : 0, last_row, live.rows.count);
+        clrtoeol();
         attroff(COLOR_PAIR(COLOR_HEADER));
-        
         refresh();
         
-        // Check for user input
+        // Non-blocking input (waits at most one frame)
         int ch = getch();
-        if (ch == 'q' || ch == 'Q') {
-            // Skip remaining animation
-            timeout(-1);
-            break;
+        switch (ch) {
+            case ' ':
+            case 'p':
+                paused = !paused;
+                break;
+            case 's':
+                paused = 1;
+                if (!live.done) live_advance(&live);
+                break;
+            case '+':
+            case '=':
+                if (speed * 2 <= LIVE_MAX_SPEED) speed *= 2;
+                break;
+            case '-':
+                if (speed / 2 >= LIVE_MIN_SPEED) speed /= 2;
+                break;
+            case KEY_UP:
+                live_scroll(&live, -1);
+                break;
+            case KEY_DOWN:
+                live_scroll(&live, 1);
+                break;
+            case KEY_PPAGE:
+                live_scroll(&live, -live.view_rows);
+                break;
+            case KEY_NPAGE:
+                live_scroll(&live, live.view_rows);
+                break;
+            case 'g': {
+                // The trace is streamed, so jumps only go forward
+                sim_time_t target = prompt_time(height);
+                while (target >= 0 && live.next_tick <= target && !live.done) {
+                    live_advance(&live);
+                }
+                timeout(1000 / LIVE_MAX_FPS);
+                owed = 0.0;
+                last = wall_seconds();
+                break;
+            }
+            case 'e':
+            case KEY_END:
+                while (!live.done) live_advance(&live);
+                break;
+            case 'q':
+            case 'Q':
+                // Skip the remaining animation; the simulation finishes without it
+                event_ring_cancel(ring);
+                quit = 1;
+                break;
         }
     }
     
+    // Final message; the rows still scroll until another key is pressed
     timeout(-1);
-    
-    // Final message
-    attron(COLOR_PAIR(COLOR_HEADER));
-    mvprintw(height - 2, 0, " Animation complete. Press any key to continue... ");
-    clrtoeol();
-    attroff(COLOR_PAIR(COLOR_HEADER));
-    refresh();
-    getch();
+    for (;;) {
+        live_draw(&live);
+        attron(COLOR_PAIR(COLOR_HEADER));
+        mvprintw(height - 2, 0, " Animation complete. Up/Down/PgUp/PgDn scroll, any other key continues... ");
+        clrtoeol();
+        attroff(COLOR_PAIR(COLOR_HEADER));
+        refresh();
+        int ch = getch();
+        if (ch == KEY_UP) live_scroll(&live, -1);
+        else if (ch == KEY_DOWN) live_scroll(&live, 1);
+        else if (ch == KEY_PPAGE) live_scroll(&live, -live.view_rows);
+        else if (ch == KEY_NPAGE) live_scroll(&live, live.view_rows);
+        else break;
+    }
+    free(live.cells);
+    free(live.drawn);
+    name_table_free(&live.rows);
 }
 
 void display_ready_queue(process_queue* queue __attribute__((unused)), int current_time __attribute__((unused))) {
@@ -502,7 +941,124 @@ void display_ready_queue(process_queue* queue __attribute__((unused)), int curre
     // update a window showing the current ready queue
 }
 
-void display_simulation_results(process_descriptor_t* descriptor, int size) {
+// Row filters of the results table
+typedef enum results_filter_t {
+    filter_all = 0,
+    filter_calc,
+    filter_io,
+    filter_wait,
+    filter_term,
+    filter_count
+} results_filter_t;
+
+static const char* results_filter_name(results_filter_t filter) {
+    switch (filter) {
+        case filter_calc: return "CALC";
+        case filter_io: return "I/O";
+        case filter_wait: return "WAITING";
+        case filter_term: return "TERMINATED";
+        default: return "ALL";
+    }
+}
+
+/*
+ * Virtualized results table: rows are positions in a sequence of trace records (the whole
+ * trace, or one process's records from the trace index), optionally filtered by state.
+ * Only the rows on screen are formatted; records are unpacked one at a time through the
+ * trace source (packed trace, or the few decoded blocks of a replayed trace file).
+ * A state filter ranks and finds rows through the index's cell counts, so neither
+ * depends on the length of the trace.
+ */
+typedef struct results_view_t {
+    const trace_source_t* trace;
+    const trace_index_t* index;
+    int base;                  // First entry of the sequence in index->records, -1 = whole trace
+    int seq_len;
+    results_filter_t filter;
+} results_view_t;
+
+static int results_record(const results_view_t* view, int pos) {
+    return (view->base >= 0) ? view->index->records[view->base + pos] : pos;
+}
+
+static trace_cell_t results_cell(results_filter_t filter) {
+    switch (filter) {
+        case filter_calc: return cell_calc;
+        case filter_io: return cell_io;
+        case filter_wait: return cell_wait;
+        case filter_term: return cell_term;
+        default: return cell_empty;
+    }
+}
+
+// Number of matching rows before pos
+static int results_rank(const results_view_t* view, int pos) {
+    if (view->filter == filter_all) return pos;
+    trace_cell_t cell = results_cell(view->filter);
+    if (view->base < 0) return trace_index_cell_rank(view->index, 0, cell, pos);
+    return trace_index_cell_rank(view->index, 1, cell, view->base + pos) -
+           trace_index_cell_rank(view->index, 1, cell, view->base);
+}
+
+// Position of the matching row of rank k, -1 when there is none
+static int results_select(const results_view_t* view, int k) {
+    if (k < 0) return -1;
+    if (view->filter == filter_all) return (k < view->seq_len) ? k : -1;
+    trace_cell_t cell = results_cell(view->filter);
+    if (view->base < 0) return trace_index_cell_select(view->index, 0, cell, k);
+    int entry = trace_index_cell_select(view->index, 1, cell,
+                                        k + trace_index_cell_rank(view->index, 1, cell, view->base));
+    return (entry >= 0 && entry < view->base + view->seq_len) ? entry - view->base : -1;
+}
+
+// First matching position from pos in direction dir (+1/-1), -1 when there is none
+static int results_seek(const results_view_t* view, int pos, int dir) {
+    if (pos < 0 || pos >= view->seq_len) return -1;
+    if (dir > 0) return results_select(view, results_rank(view, pos));
+    return results_select(view, results_rank(view, pos + 1) - 1);
+}
+
+// Move matching position pos by up to count matching rows in direction dir;
+// *moved = rows actually moved
+static int results_step(const results_view_t* view, int pos, int count, int dir, int* moved) {
+    int rank = results_rank(view, pos);
+    int target = rank + dir * count;
+    int total = results_rank(view, view->seq_len);
+    if (target > total - 1) target = total - 1;
+    if (target < 0) target = 0;
+    *moved = (target > rank) ? target - rank : rank - target;
+    return (*moved > 0) ? results_select(view, target) : pos;
+}
+
+// First position at or after time t (records are in time order)
+static int results_find_time(const results_view_t* view, sim_time_t t) {
+    int lo = 0, hi = view->seq_len;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        process_descriptor_t d;
+        if (trace_source_get(view->trace, results_record(view, mid), &d) && d.date < t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Read a line on the status bar into buffer (empty string when cancelled)
+static void prompt_line(int height, const char* label, char* buffer, int size) {
+    attron(COLOR_PAIR(COLOR_HEADER));
+    mvprintw(height - 2, 0, " %s", label);
+    clrtoeol();
+    attroff(COLOR_PAIR(COLOR_HEADER));
+    refresh();
+    
+    echo();
+    curs_set(1);
+    if (getnstr(buffer, size - 1) == ERR) buffer[0] = '\0';
+    curs_set(0);
+    noecho();
+}
+
+void display_simulation_results(const trace_source_t* trace, const trace_index_t* index) {
+    int size = trace->size;
     clear();
     
     int height, width;
@@ -519,9 +1075,17 @@ void display_simulation_results(process_descriptor_t* descriptor, int size) {
     mvprintw(3, 2, "%-15s %-10s %-15s %-10s", "-------", "----", "-----", "---------");
     attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
     
-    // Scrolling variables
-    int scroll = 0;
+    // The index provides the per-process record lists used by the process filter
+    results_view_t view = { trace, index, -1, size, filter_all };
+    int proc = -1;                 // Process filter, -1 = all
+    
+    // Scrolling variables: scroll is the position of the first visible row
+    int scroll = results_seek(&view, 0, 1);
+    int rank = 0;                  // Matching rows before scroll
+    int total = size;              // Matching rows
     int view_height = height - 7;
+    if (view_height < 1) view_height = 1;
+    int moved;
     
     int running = 1;
     while (running) {
@@ -531,10 +1095,15 @@ void display_simulation_results(process_descriptor_t* descriptor, int size) {
             clrtoeol();
         }
         
-        // Display visible portion
-        for (int i = scroll; i < scroll + view_height && i < size; i++) {
+        // Format only the visible rows
+        int line = 0;
+        int last = scroll;
+        for (int pos = scroll; pos >= 0 && line < view_height; pos = results_seek(&view, pos + 1, 1)) {
+            process_descriptor_t record;
+            if (!trace_source_get(trace, results_record(&view, pos), &record)) break;
+            const process_descriptor_t* d = &record;
             const char* state_str;
-            switch (descriptor[i].state) {
+            switch (d->state) {
                 case waiting_p: state_str = "WAITING"; break;
                 case running_p: state_str = "RUNNING"; break;
                 case terminated_p: state_str = "TERMINATED"; break;
@@ -544,39 +1113,103 @@ void display_simulation_results(process_descriptor_t* descriptor, int size) {
             }
             
             const char* op_str;
-            switch (descriptor[i].operation) {
+            switch (d->operation) {
                 case calc_p: op_str = "CALC"; break;
                 case IO_p: op_str = "I/O"; break;
                 case none: op_str = "NONE"; break;
                 default: op_str = "UNKNOWN"; break;
             }
             
-            int color = get_color_for_operation(descriptor[i].operation, descriptor[i].state);
+            int color = get_color_for_operation(d->operation, d->state);
             attron(COLOR_PAIR(color));
-            mvprintw(4 + (i - scroll), 2, "%-15s %-10d %-15s %-10s",
-                     descriptor[i].process_name,
-                     descriptor[i].date,
-                     state_str,
-                     op_str);
+            mvprintw(4 + line, 2, "%-15s %-10lld %-15s %-10s",
+                     d->process_name, (long long)d->date, state_str, op_str);
             attroff(COLOR_PAIR(color));
+            line++;
+            last = pos;
         }
         
         // Status bar
         attron(COLOR_PAIR(COLOR_HEADER));
-        mvprintw(height - 2, 0, " Showing: %d-%d of %d | Arrow keys=scroll | q/Enter/Space=continue ",
-                 scroll + 1, (scroll + view_height < size) ? scroll + view_height : size, size);
+        mvprintw(height - 2, 0, " Showing: %d-%d of %d | %s, %s | PgUp/PgDn Home/End g=time /=process f=state q=continue ",
+                 line > 0 ? rank + 1 : 0, rank + line, total,
+                 proc >= 0 ? index->proc_names[proc] : "all processes", results_filter_name(view.filter));
+        clrtoeol();
         attroff(COLOR_PAIR(COLOR_HEADER));
         
         refresh();
         
         // Handle input
         int ch = getch();
+        char buffer[64];
         switch (ch) {
             case KEY_UP:
-                if (scroll > 0) scroll--;
+                if (scroll >= 0) {
+                    scroll = results_step(&view, scroll, 1, -1, &moved);
+                    rank -= moved;
+                }
                 break;
             case KEY_DOWN:
-                if (scroll < size - view_height) scroll++;
+                if (scroll >= 0 && results_seek(&view, last + 1, 1) >= 0) {
+                    scroll = results_step(&view, scroll, 1, 1, &moved);
+                    rank += moved;
+                }
+                break;
+            case KEY_PPAGE:
+                if (scroll >= 0) {
+                    scroll = results_step(&view, scroll, view_height, -1, &moved);
+                    rank -= moved;
+                }
+                break;
+            case KEY_NPAGE:
+                if (scroll >= 0 && results_seek(&view, last + 1, 1) >= 0) {
+                    scroll = results_seek(&view, last + 1, 1);
+                    rank += line;
+                }
+                break;
+            case KEY_HOME:
+                scroll = results_seek(&view, 0, 1);
+                rank = 0;
+                break;
+            case KEY_END:
+                scroll = results_seek(&view, view.seq_len - 1, -1);
+                rank = (total > 0) ? total - 1 : 0;
+                if (scroll >= 0) {
+                    scroll = results_step(&view, scroll, view_height - 1, -1, &moved);
+                    rank -= moved;
+                }
+                break;
+            case 'g': {
+                prompt_line(height, "Jump to time: ", buffer, sizeof(buffer));
+                char* end;
+                long long t = strtoll(buffer, &end, 10);
+                if (end != buffer) {
+                    int pos = results_seek(&view, results_find_time(&view, t), 1);
+                    if (pos >= 0) {
+                        scroll = pos;
+                        rank = results_rank(&view, pos);
+                    }
+                }
+                break;
+            }
+            case '/': {
+                // Process filter through the index; an empty name shows every process
+                prompt_line(height, "Process (empty = all): ", buffer, sizeof(buffer));
+                int p = buffer[0] ? trace_index_find(index, buffer) : -1;
+                if (buffer[0] && p < 0) break;
+                proc = p;
+                view.base = (proc >= 0) ? index->record_offset[proc] : -1;
+                view.seq_len = (proc >= 0) ? index->record_offset[proc + 1] - index->record_offset[proc] : size;
+                scroll = results_seek(&view, 0, 1);
+                rank = 0;
+                total = results_rank(&view, view.seq_len);
+                break;
+            }
+            case 'f':
+                view.filter = (results_filter_t)((view.filter + 1) % filter_count);
+                scroll = results_seek(&view, 0, 1);
+                rank = 0;
+                total = results_rank(&view, view.seq_len);
                 break;
             case 'q':
             case 'Q':
@@ -588,8 +1221,8 @@ void display_simulation_results(process_descriptor_t* descriptor, int size) {
     }
 }
 
-void display_statistics(process_descriptor_t* descriptor, int size) {
-    if (size == 0) return;
+void display_statistics(const trace_source_t* trace, const trace_index_t* index) {
+    if (trace->size == 0) return;
     
     clear();
     
@@ -601,66 +1234,111 @@ void display_statistics(process_descriptor_t* descriptor, int size) {
     mvprintw(0, (width - 40) / 2, "              STATISTICS                ");
     attroff(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
     
-    // Calculate per-process statistics
-    typedef struct {
-        char name[64];
-        int start_time;
-        int end_time;
-        int total_wait;
-        int total_run;
-    } proc_stats_t;
+    // Per-process statistics from the trace index (any number of processes)
+    int num_procs = index->proc_count;
+    trace_proc_stats_t* stats = trace_index_stats(index, trace);
+    if (!stats) return;
+    
+    // Headers
+    attron(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+    mvprintw(2, 2, "%-15s %-12s %-12s %-12s %-15s", 
+             "PROCESS", "START", "END", "TURNAROUND", "WAITING");
+    mvprintw(3, 2, "%-15s %-12s %-12s %-12s %-15s",
+             "-------", "-----", "---", "----------", "-------");
+    attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
     
-    proc_stats_t stats[100];
-    int num_procs = 0;
+    // Only the visible processes are formatted
+    int scroll = 0;
+    int view_height = height - 7;
+    if (view_height < 1) view_height = 1;
+    int max_scroll = (num_procs > view_height) ? num_procs - view_height : 0;
     
-    for (int i = 0; i < size; i++) {
-        int found = -1;
-        for (int j = 0; j < num_procs; j++) {
-            if (strcmp(stats[j].name, descriptor[i].process_name) == 0) {
-                found = j;
-                break;
-            }
+    int running = 1;
+    while (running) {
+        for (int i = 4; i < height - 2; i++) {
+            move(i, 0);
+            clrtoeol();
         }
         
-        if (found == -1) {
-            found = num_procs++;
-            strncpy(stats[found].name, descriptor[i].process_name, 63);
-            stats[found].name[63] = '\0';
-            stats[found].start_time = descriptor[i].date;
-            stats[found].end_time = descriptor[i].date;
-            stats[found].total_wait = 0;
-            stats[found].total_run = 0;
+        for (int i = scroll; i < scroll + view_height && i < num_procs; i++) {
+            sim_time_t turnaround = stats[i].end_time - stats[i].start_time;
+            mvprintw(4 + (i - scroll), 2, "%-15s %-12lld %-12lld %-12lld %-15lld",
+                     index->proc_names[i],
+                     (long long)stats[i].start_time,
+                     (long long)stats[i].end_time,
+                     (long long)turnaround,
+                     (long long)stats[i].total_wait);
         }
         
-        if (descriptor[i].date > stats[found].end_time) {
-            stats[found].end_time = descriptor[i].date;
-        }
+        // Status bar
+        attron(COLOR_PAIR(COLOR_HEADER));
+        mvprintw(height - 2, 0, " Showing: %d-%d of %d | Arrows/PgUp/PgDn=scroll | q/Enter/Space=continue ",
+                 num_procs > 0 ? scroll + 1 : 0,
+                 (scroll + view_height < num_procs) ? scroll + view_height : num_procs, num_procs);
+        clrtoeol();
+        attroff(COLOR_PAIR(COLOR_HEADER));
+        
+        refresh();
         
-        if (descriptor[i].state == running_p) {
-            stats[found].total_run++;
-        } else if (descriptor[i].state == waiting_p) {
-            stats[found].total_wait++;
+        // Handle input
+        int ch = getch();
+        switch (ch) {
+            case KEY_UP:
+                if (scroll > 0) scroll--;
+                break;
+            case KEY_DOWN:
+                if (scroll < max_scroll) scroll++;
+                break;
+            case KEY_PPAGE:
+                scroll = (scroll > view_height) ? scroll - view_height : 0;
+                break;
+            case KEY_NPAGE:
+                scroll = (scroll + view_height < max_scroll) ? scroll + view_height : max_scroll;
+                break;
+            case KEY_HOME:
+                scroll = 0;
+                break;
+            case KEY_END:
+                scroll = max_scroll;
+                break;
+            case 'q':
+            case 'Q':
+            case '\n':
+            case ' ':
+                running = 0;
+                break;
         }
     }
     
-    // Headers
-    attron(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
-    mvprintw(2, 2, "%-15s %-12s %-12s %-12s %-15s", 
-             "PROCESS", "START", "END", "TURNAROUND", "WAITING");
-    mvprintw(3, 2, "%-15s %-12s %-12s %-12s %-15s",
-             "-------", "-----", "---", "----------", "-------");
-    attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+    free(stats);
+}
+
+void display_run_report(const sim_run_t* run) {
+    clear();
+    
+    int height, width;
+    getmaxyx(stdscr, height, width);
     
-    // Display statistics
-    for (int i = 0; i < num_procs; i++) {
-        int turnaround = stats[i].end_time - stats[i].start_time;
-        mvprintw(4 + i, 2, "%-15s %-12d %-12d %-12d %-15d",
-                 stats[i].name,
-                 stats[i].start_time,
-                 stats[i].end_time,
-                 turnaround,
-                 stats[i].total_wait);
+    // Title
+    attron(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
+    mvprintw(0, (width - 40) / 2, "          RUN CUT SHORT                 ");
+    attroff(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
+    
+    attron(COLOR_PAIR(COLOR_WAIT) | A_BOLD);
+    if (run->status == sim_horizon_reached) {
+        mvprintw(3, 2, "The simulation reached its time horizon (%lld) before every process finished.",
+                 (long long)run->horizon);
+    } else if (run->status == sim_cancelled) {
+        mvprintw(3, 2, "The simulation was cancelled before every process finished.");
+    } else {
+        mvprintw(3, 2, "The simulation stalled: the remaining processes can never make progress.");
+        mvprintw(4, 2, "Check their operations (only calc and io are executable).");
     }
+    attroff(COLOR_PAIR(COLOR_WAIT) | A_BOLD);
+    
+    mvprintw(6, 2, "Stopped at time:     %lld", (long long)run->end_time);
+    mvprintw(7, 2, "Processes finished:  %d / %d", run->finished, run->total);
+    mvprintw(9, 2, "The following screens show the partial trace.");
     
     // Status bar
     attron(COLOR_PAIR(COLOR_HEADER));
@@ -670,3 +1348,204 @@ void display_statistics(process_descriptor_t* descriptor, int size) {
     refresh();
     getch();
 }
+
+void display_deadline_report(const deadline_report_t* report) {
+    if (report->jobs == 0) return;
+    
+    clear();
+    
+    int height, width;
+    getmaxyx(stdscr, height, width);
+    
+    // Title
+    attron(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
+    mvprintw(0, (width - 40) / 2, "              DEADLINES                 ");
+    attroff(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
+    
+    mvprintw(2, 2, "Jobs with deadline: %d   Met: %d   ", report->jobs, report->met);
+    attron(COLOR_PAIR(report->missed > 0 ? COLOR_TERM : COLOR_CALC) | A_BOLD);
+    printw("Missed: %d", report->missed);
+    attroff(COLOR_PAIR(report->missed > 0 ? COLOR_TERM : COLOR_CALC) | A_BOLD);
+    if (report->overdue > 0) {
+        printw(" (%d overdue)", report->overdue);
+    }
+    if (report->unfinished > report->overdue) {
+        printw("   Pending: %d", report->unfinished - report->overdue);
+    }
+    
+    mvprintw(3, 2, "Lateness  min: %lld  mean: %.2f  p50: %lld  p90: %lld  p99: %lld  max: %lld",
+             (long long)report->min_lateness, report->mean_lateness,
+             (long long)report->p50_lateness, (long long)report->p90_lateness,
+             (long long)report->p99_lateness, (long long)report->max_lateness);
+    
+    mvprintw(4, 2, "CPU density: %.3f -> ", report->density);
+    attron(COLOR_PAIR(report->density_schedulable ? COLOR_CALC : COLOR_TERM) | A_BOLD);
+    printw("%s", report->density_schedulable ? "schedulable under EDF (CPU only)"
+                                             : "not guaranteed (density > 1)");
+    attroff(COLOR_PAIR(report->density_schedulable ? COLOR_CALC : COLOR_TERM) | A_BOLD);
+    
+    // Lateness histogram
+    attron(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+    mvprintw(6, 2, "LATENESS HISTOGRAM");
+    attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+    
+    int finished = report->met + report->missed;
+    int bar_width = width - 30;
+    for (int b = 0; b < DEADLINE_HIST_BINS; b++) {
+        int len = (finished > 0) ? (int)((long long)report->histogram[b] * bar_width / finished) : 0;
+        if (report->histogram[b] > 0 && len == 0) len = 1;
+        mvprintw(7 + b, 2, "%-9s %6d ", deadline_histogram_label(b), report->histogram[b]);
+        attron(COLOR_PAIR(b == 0 ? COLOR_CALC : COLOR_TERM));
+        for (int c = 0; c < len; c++) addch(ACS_CKBOARD);
+        attroff(COLOR_PAIR(b == 0 ? COLOR_CALC : COLOR_TERM));
+    }
+    
+    // Jobs, worst lateness first
+    int list_top = 8 + DEADLINE_HIST_BINS;
+    attron(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+    mvprintw(list_top, 2, "%-15s %-12s %-12s %-12s", "PROCESS", "DEADLINE", "COMPLETION", "LATENESS");
+    attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+    
+    int scroll = 0;
+    int view_height = height - list_top - 3;
+    if (view_height < 1) view_height = 1;
+    
+    int running = 1;
+    while (running) {
+        for (int i = list_top + 1; i < height - 2; i++) {
+            move(i, 0);
+            clrtoeol();
+        }
+        
+        for (int i = scroll; i < scroll + view_height && i < report->jobs; i++) {
+            const deadline_job_t* job = &report->list[i];
+            if (job->completion < 0 && job->lateness > 0) {
+                char bound[24];
+                snprintf(bound, sizeof(bound), ">=%lld", (long long)job->lateness);
+                attron(COLOR_PAIR(COLOR_TERM));
+                mvprintw(list_top + 1 + (i - scroll), 2, "%-15s %-12lld %-12s %-12s",
+                         job->process_name, (long long)job->abs_deadline, "overdue", bound);
+                attroff(COLOR_PAIR(COLOR_TERM));
+            } else if (job->completion < 0) {
+                attron(COLOR_PAIR(COLOR_WAIT));
+                mvprintw(list_top + 1 + (i - scroll), 2, "%-15s %-12lld %-12s %-12s",
+                         job->process_name, (long long)job->abs_deadline, "-", "pending");
+                attroff(COLOR_PAIR(COLOR_WAIT));
+            } else {
+                int color = (job->lateness > 0) ? COLOR_TERM : COLOR_CALC;
+                attron(COLOR_PAIR(color));
+                mvprintw(list_top + 1 + (i - scroll), 2, "%-15s %-12lld %-12lld %-12lld",
+                         job->process_name, (long long)job->abs_deadline,
+                         (long long)job->completion, (long long)job->lateness);
+                attroff(COLOR_PAIR(color));
+            }
+        }
+        
+        // Status bar
+        attron(COLOR_PAIR(COLOR_HEADER));
+        mvprintw(height - 2, 0, " Jobs: %d-%d of %d | Arrow keys=scroll | q/Enter/Space=continue ",
+                 scroll + 1, (scroll + view_height < report->jobs) ? scroll + view_height : report->jobs,
+                 report->jobs);
+        attroff(COLOR_PAIR(COLOR_HEADER));
+        
+        refresh();
+        
+        int ch = getch();
+        switch (ch) {
+            case KEY_UP:
+                if (scroll > 0) scroll--;
+                break;
+            case KEY_DOWN:
+                if (scroll < report->jobs - view_height) scroll++;
+                break;
+            case 'q':
+            case 'Q':
+            case '\n':
+            case ' ':
+                running = 0;
+                break;
+        }
+    }
+}
+
+void display_comparison(const compare_row_t* rows, int count) {
+    if (count == 0) return;
+
+    const int name_width = 22, cell_width = 11;
+    int first_column = 0;
+    int running = 1;
+    while (running) {
+        clear();
+        int height, width;
+        getmaxyx(stdscr, height, width);
+        int visible = (width - 2 - name_width) / cell_width;
+        if (visible < 1) visible = 1;
+        if (visible > COMPARE_COLUMNS) visible = COMPARE_COLUMNS;
+        if (first_column > COMPARE_COLUMNS - visible) first_column = COMPARE_COLUMNS - visible;
+
+        // Title
+        attron(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
+        mvprintw(0, (width - 40) / 2, "              COMPARISON                ");
+        attroff(COLOR_PAIR(COLOR_TITLE) | A_BOLD);
+        mvprintw(2, 2, "%d processes, every policy run concurrently. Best values in bold.",
+                 rows[0].total);
+
+        // Headers
+        attron(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+        mvprintw(4, 2, "%-*s", name_width, "POLICY");
+        for (int c = 0; c < visible; c++) {
+            printw("%*s", cell_width, compare_column_name(first_column + c));
+        }
+        attroff(COLOR_PAIR(COLOR_HEADER) | A_BOLD);
+
+        int line = 5;
+        for (int i = 0; i < count && line < height - 3; i++, line++) {
+            mvprintw(line, 2, "%-*s", name_width, rows[i].name);
+            for (int c = 0; c < visible; c++) {
+                int column = first_column + c;
+                char cell[32];
+                compare_cell(&rows[i], column, cell, sizeof(cell));
+                int best = compare_is_best(rows, count, column, i);
+                if (best) attron(COLOR_PAIR(COLOR_CALC) | A_BOLD);
+                printw("%*s", cell_width, cell);
+                if (best) attroff(COLOR_PAIR(COLOR_CALC) | A_BOLD);
+            }
+        }
+
+        // Runs that did not complete
+        line++;
+        attron(COLOR_PAIR(COLOR_WAIT));
+        for (int i = 0; i < count && line < height - 3; i++) {
+            if (rows[i].status == sim_completed) continue;
+            mvprintw(line++, 2, "%s %s at time %lld: %d / %d processes finished", rows[i].name,
+                     compare_status_text(rows[i].status), (long long)rows[i].end_time,
+                     rows[i].finished, rows[i].total);
+        }
+        attroff(COLOR_PAIR(COLOR_WAIT));
+
+        // Status bar
+        attron(COLOR_PAIR(COLOR_HEADER));
+        mvprintw(height - 2, 0, " Columns: %d-%d of %d | Left/Right=scroll | q/Enter/Space=continue ",
+                 first_column + 1, first_column + visible, COMPARE_COLUMNS);
+        clrtoeol();
+        attroff(COLOR_PAIR(COLOR_HEADER));
+
+        refresh();
+
+        int ch = getch();
+        switch (ch) {
+            case KEY_LEFT:
+                if (first_column > 0) first_column--;
+                break;
+            case KEY_RIGHT:
+                if (first_column < COMPARE_COLUMNS - visible) first_column++;
+                break;
+            case 'q':
+            case 'Q':
+            case '\n':
+            case ' ':
+                running = 0;
+                break;
+        }
+    }
+}
@@ -3,6 +3,12 @@
 
 #include <ncurses.h>
 #include "basic_sched.h"
+#include "deadline_stats.h"
+#include "trace_index.h"
+#include "trace_lod.h"
+#include "event_ring.h"
+#include "name_table.h"
+#include "compare.h"
 
 // Initialize ncurses display
 void init_ncurses_display();
@@ -10,27 +16,49 @@ void init_ncurses_display();
 // Cleanup ncurses display
 void cleanup_ncurses_display();
 
-// Display Gantt chart with scrolling support
-void display_gantt_chart(process_descriptor_t* descriptor, int size);
+// Display Gantt chart with scrolling support. The trace views take the trace's
+// index (trace_index_build()), so a run is indexed once for all of them
+void display_gantt_chart(const trace_source_t* trace, const trace_index_t* index);
 
-// Display real-time Gantt chart animation (tick by tick)
-void display_realtime_gantt(process_descriptor_t* descriptor, int size, int delay_ms);
+// Display real-time Gantt chart animation (tick by tick) of a run streaming into ring
+void display_realtime_gantt(event_ring_t* ring, int delay_ms);
 
 // Display ready queue during execution
 void display_ready_queue(process_queue* queue, int current_time);
 
 // Display simulation results with scrolling
-void display_simulation_results(process_descriptor_t* descriptor, int size);
+void display_simulation_results(const trace_source_t* trace, const trace_index_t* index);
 
 // Display statistics
-void display_statistics(process_descriptor_t* descriptor, int size);
+void display_statistics(const trace_source_t* trace, const trace_index_t* index);
+
+// Display deadline misses, lateness distribution and schedulability
+void display_deadline_report(const deadline_report_t* report);
+
+// Report a run that was cut short (horizon reached or stalled)
+void display_run_report(const sim_run_t* run);
+
+// Side-by-side metrics of every policy run on the same workload
+void display_comparison(const compare_row_t* rows, int count);
 
 // Show menu and get user choice (now dynamically shows only available algorithms)
 int show_menu();
 
+// Menu entry that compares every available policy
+#define MENU_COMPARE_ALL 11
+
 // Get quantum for Round-Robin
 int get_quantum();
 
+// Get target latency and minimum granularity for CFS
+cfs_params_t get_cfs_params();
+
+// Get random seed for lottery scheduling
+uint64_t get_seed();
+
+// Get levels, per-level quanta and boost period for the MLFQ
+mlfq_params_t get_mlfq_params();
+
 // Check which scheduling algorithms are available at runtime
 typedef struct {
     int fifo_available;
@@ -38,6 +66,11 @@ typedef struct {
     int priority_available;
     int multilevel_available;
     int multilevel_aging_available;
+    int cfs_available;
+    int lottery_available;
+    int stride_available;
+    int edf_available;
+    int mlfq_available;
 } available_algorithms_t;
 
 available_algorithms_t check_available_algorithms();
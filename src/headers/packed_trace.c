@@ -0,0 +1,56 @@
+#include "packed_trace.h"
+#include <stdlib.h>
+
+void packed_trace_init(packed_trace_t* trace) {
+    trace->records = NULL;
+    trace->size = 0;
+    trace->capacity = 0;
+    name_table_init(&trace->procs);
+    trace->overflow = 0;
+}
+
+void packed_trace_free(packed_trace_t* trace) {
+    free(trace->records);
+    name_table_free(&trace->procs);
+    packed_trace_init(trace);
+}
+
+int packed_trace_sink(void* ctx, const process_descriptor_t* record) {
+    packed_trace_t* trace = ctx;
+    if (record->date < 0 || record->date > TRACE_RECORD_MAX_TIME) {
+        trace->overflow = 1;
+        return 0;
+    }
+
+    int added;
+    int proc = name_table_id(&trace->procs, record->process_name, &added);
+    if (proc < 0) return 0;
+    if (proc >= TRACE_RECORD_MAX_PROCS) {
+        trace->overflow = 1;
+        return 0;
+    }
+
+    if (trace->size == trace->capacity) {
+        if (trace->capacity > INT32_MAX / 2) {
+            trace->overflow = 1;
+            return 0;
+        }
+        int capacity = trace->capacity ? trace->capacity * 2 : 4096;
+        trace_record_t* grown = realloc(trace->records, (size_t)capacity * sizeof(trace_record_t));
+        if (!grown) return 0;
+        trace->records = grown;
+        trace->capacity = capacity;
+    }
+
+    trace->records[trace->size++] = trace_record_pack(proc, record->date, record->state,
+                                                      record->operation);
+    return 1;
+}
+
+void packed_trace_get(const packed_trace_t* trace, int pos, process_descriptor_t* out) {
+    trace_record_t r = trace->records[pos];
+    out->process_name = (char*)packed_trace_name(trace, r);
+    out->date = trace_record_time(r);
+    out->state = trace_record_state(r);
+    out->operation = trace_record_operation(r);
+}
@@ -0,0 +1,64 @@
+#ifndef PACKED_TRACE_H
+#define PACKED_TRACE_H
+
+#include "basic_sched.h"
+#include "name_table.h"
+
+// One trace record in 64 bits (a third of process_descriptor_t):
+//   bits  0-2   state
+//   bits  3-4   operation
+//   bits  5-28  process id (dense, in order of first appearance)
+//   bits 29-63  time
+// Time is in the high bits, so packed records compare in time order.
+typedef uint64_t trace_record_t;
+
+#define TRACE_RECORD_PROC_BITS 24
+#define TRACE_RECORD_TIME_BITS 35
+#define TRACE_RECORD_MAX_PROCS (1 << TRACE_RECORD_PROC_BITS)
+#define TRACE_RECORD_MAX_TIME (((sim_time_t)1 << TRACE_RECORD_TIME_BITS) - 1)
+
+static inline trace_record_t trace_record_pack(int proc, sim_time_t time,
+                                               process_state state, process_operation_t operation) {
+    return ((uint64_t)time << 29) | ((uint64_t)proc << 5) |
+           ((uint64_t)(operation & 3) << 3) | (uint64_t)(state & 7);
+}
+
+static inline process_state trace_record_state(trace_record_t r) {
+    return (process_state)(r & 7);
+}
+
+static inline process_operation_t trace_record_operation(trace_record_t r) {
+    return (process_operation_t)((r >> 3) & 3);
+}
+
+static inline int trace_record_proc(trace_record_t r) {
+    return (int)((r >> 5) & (TRACE_RECORD_MAX_PROCS - 1));
+}
+
+static inline sim_time_t trace_record_time(trace_record_t r) {
+    return (sim_time_t)(r >> 29);
+}
+
+// In-memory trace of a run, filled through packed_trace_sink()
+typedef struct packed_trace_t {
+    trace_record_t* records;
+    int size;
+    int capacity;
+    name_table_t procs;        // Process id -> name (the workload's name pointers)
+    int overflow;              // A record did not fit (time or process id out of range)
+} packed_trace_t;
+
+void packed_trace_init(packed_trace_t* trace);
+void packed_trace_free(packed_trace_t* trace);
+
+// sim_sink_t adapter (ctx = packed_trace_t); returns 0 when out of memory or range
+int packed_trace_sink(void* ctx, const process_descriptor_t* record);
+
+static inline const char* packed_trace_name(const packed_trace_t* trace, trace_record_t r) {
+    return trace->procs.names[trace_record_proc(r)];
+}
+
+// Unpacked copy of the record at pos
+void packed_trace_get(const packed_trace_t* trace, int pos, process_descriptor_t* out);
+
+#endif
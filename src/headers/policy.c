@@ -0,0 +1,70 @@
+#include "policy.h"
+
+const char* policy_name(int choice) {
+    switch (choice) {
+        case 1: return "FIFO";
+        case 2: return "Round-Robin";
+        case 3: return "Priority Preemptive";
+        case 4: return "Multi-level";
+        case 5: return "Multi-level + Aging";
+        case 6: return "CFS";
+        case 7: return "Lottery";
+        case 8: return "Stride";
+        case 9: return "EDF";
+        case 10: return "MLFQ";
+        default: return "unknown";
+    }
+}
+
+int policy_available(int choice) {
+    switch (choice) {
+        case 1: return fifo_sched != NULL;
+        case 2: return round_robin_sched != NULL;
+        case 3: return priority_sched != NULL;
+        case 4: return multilevel_rr_sched != NULL;
+        case 5: return multilevel_rr_aging_sched != NULL;
+        case 6: return cfs_sched != NULL;
+        case 7: return lottery_sched != NULL;
+        case 8: return stride_sched != NULL;
+        case 9: return edf_sched != NULL;
+        case 10: return mlfq_sched != NULL;
+        default: return 0;
+    }
+}
+
+void policy_run(int choice, const policy_params_t* params, process_queue* queue,
+                process_descriptor_t** descriptor, int* size, sim_run_t* run) {
+    if (!policy_available(choice)) return;
+    switch (choice) {
+        case 1:
+            fifo_sched(queue, descriptor, size, run);
+            break;
+        case 2:
+            round_robin_sched(queue, descriptor, size, params->quantum, run);
+            break;
+        case 3:
+            priority_sched(queue, descriptor, size, run);
+            break;
+        case 4:
+            multilevel_rr_sched(queue, descriptor, size, run);
+            break;
+        case 5:
+            multilevel_rr_aging_sched(queue, descriptor, size, &params->aging, run);
+            break;
+        case 6:
+            cfs_sched(queue, descriptor, size, &params->cfs, run);
+            break;
+        case 7:
+            lottery_sched(queue, descriptor, size, params->quantum, params->seed, run);
+            break;
+        case 8:
+            stride_sched(queue, descriptor, size, params->quantum, run);
+            break;
+        case 9:
+            edf_sched(queue, descriptor, size, run);
+            break;
+        case 10:
+            mlfq_sched(queue, descriptor, size, &params->mlfq, run);
+            break;
+    }
+}
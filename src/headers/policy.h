@@ -0,0 +1,29 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include "basic_sched.h"
+
+// The scheduling policies by menu number (1..POLICY_COUNT), shared by the menu, the
+// batch modes and the library
+
+#define POLICY_COUNT 10
+
+// Parameters of every policy; each policy reads its own (zero = default where allowed)
+typedef struct policy_params_t {
+    int quantum;               // Round-Robin, Lottery, Stride
+    uint64_t seed;             // Lottery
+    cfs_params_t cfs;
+    aging_params_t aging;
+    mlfq_params_t mlfq;
+} policy_params_t;
+
+const char* policy_name(int choice);
+
+// Compiled into this build (the algorithm sources are optional)
+int policy_available(int choice);
+
+// Run an available policy, like the scheduler functions themselves
+void policy_run(int choice, const policy_params_t* params, process_queue* queue,
+                process_descriptor_t** descriptor, int* size, sim_run_t* run);
+
+#endif
@@ -1,15 +1,16 @@
 #include "basic_sched.h"
+#include "checkpoint.h"
 #include <stdlib.h>
 
-void priority_sched(process_queue *p, process_descriptor_t **descriptor, int *size) {
+void priority_sched(process_queue *p, process_descriptor_t **descriptor, int *size, sim_run_t *run) {
     if (p->size == 0) return;
 
     int n = p->size;
 
     process_t *procs = malloc(n * sizeof(process_t));
     int *op_idx = malloc(n * sizeof(int));
-    int *op_left = malloc(n * sizeof(int));
-    int *io_until = malloc(n * sizeof(int));
+    sim_time_t *op_left = malloc(n * sizeof(sim_time_t));
+    sim_time_t *io_until = malloc(n * sizeof(sim_time_t));
     int *done = malloc(n * sizeof(int));
 
     if (!procs || !op_idx || !op_left || !io_until || !done) {
@@ -27,10 +28,39 @@ void priority_sched(process_queue *p, process_descriptor_t **descriptor, int *si
     }
 
     int finished = 0;
-    int current_time = 0;
-    int max_time = 10000;
+    for (int k = 0; k < n; k++)
+        if (done[k]) finished++;
+    sim_time_t current_time = 0;
+
+    // Continue a snapshot
+    const sim_checkpoint_t *cp = checkpoint_resume(run, checkpoint_priority, p, 0);
+    if (cp) {
+        for (int k = 0; k < n; k++) {
+            op_idx[k] = cp->procs[k].op_idx;
+            op_left[k] = cp->procs[k].op_remaining;
+            io_until[k] = cp->procs[k].io_until;
+            done[k] = cp->procs[k].terminated;
+        }
+        current_time = cp->time;
+        finished = cp->finished;
+    } else if (run && run->resume) {
+        free(procs); free(op_idx); free(op_left); free(io_until); free(done);
+        return;
+    }
+
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
+
+    while (finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
 
-    while (finished < n && current_time < max_time) {
         int cpu_pick = -1;
         int io_pick = -1;
 
@@ -88,7 +118,7 @@ void priority_sched(process_queue *p, process_descriptor_t **descriptor, int *si
             entry.date = current_time;
             entry.state = running_p;
             entry.operation = calc_p;
-            append_descriptor(descriptor, entry, size);
+            sim_emit(run, descriptor, size, entry);
 
             op_left[cpu_pick]--;
             
@@ -107,7 +137,7 @@ void priority_sched(process_queue *p, process_descriptor_t **descriptor, int *si
             entry.date = current_time;
             entry.state = running_p;
             entry.operation = IO_p;
-            append_descriptor(descriptor, entry, size);
+            sim_emit(run, descriptor, size, entry);
 
             // Check if I/O completed
             if (io_until[io_pick] <= current_time + 1) {
@@ -130,10 +160,11 @@ void priority_sched(process_queue *p, process_descriptor_t **descriptor, int *si
             w.date = current_time;
             w.state = waiting_p;
             w.operation = none;
-            append_descriptor(descriptor, w, size);
+            sim_emit(run, descriptor, size, w);
         }
 
         // Check for terminated processes
+        int terminated_now = 0;
         for (int k = 0; k < n; k++) {
             if (done[k]) continue;
             if (procs[k].arrival_time_p > current_time) continue;
@@ -141,19 +172,61 @@ void priority_sched(process_queue *p, process_descriptor_t **descriptor, int *si
             if (op_idx[k] >= procs[k].operations_count && io_until[k] < 0) {
                 done[k] = 1;
                 finished++;
+                terminated_now++;
 
                 process_descriptor_t term;
                 term.process_name = procs[k].process_name;
                 term.date = current_time + 1;
                 term.state = terminated_p;
                 term.operation = none;
-                append_descriptor(descriptor, term, size);
+                sim_emit(run, descriptor, size, term);
+            }
+        }
+
+        // Nothing ran or terminated: skip idle gaps (up to the horizon), detect permanent stalls
+        if (cpu_pick < 0 && io_pick < 0 && !terminated_now) {
+            int active = 0;
+            sim_time_t next_arrival = -1;
+            for (int k = 0; k < n; k++) {
+                if (done[k]) continue;
+                if (procs[k].arrival_time_p > current_time) {
+                    if (next_arrival < 0 || procs[k].arrival_time_p < next_arrival)
+                        next_arrival = procs[k].arrival_time_p;
+                } else {
+                    active = 1;
+                }
+            }
+            if (next_arrival < 0) {
+                status = sim_stalled;
+                current_time++;
+                break;
+            }
+            if (!active) {
+                current_time = (horizon > 0 && next_arrival > horizon) ? horizon : next_arrival;
+                continue;
             }
         }
 
         current_time++;
     }
 
+    if (status == sim_horizon_reached || status == sim_cancelled) {
+        sim_checkpoint_t *out = checkpoint_begin(run, checkpoint_priority, p, current_time, finished, 0);
+        for (int k = 0; out && k < n; k++) {
+            out->procs[k].op_idx = op_idx[k];
+            out->procs[k].op_remaining = op_left[k];
+            out->procs[k].io_until = io_until[k];
+            out->procs[k].terminated = done[k];
+        }
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = finished;
+        run->total = n;
+    }
+
     free(procs);
     free(op_idx);
     free(op_left);
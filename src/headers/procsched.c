@@ -0,0 +1,240 @@
+#include "procsched.h"
+#include "config_parser.h"
+#include "policy.h"
+#include "sim_metrics.h"
+#include <string.h>
+
+#if PROCSCHED_PRIORITY_MIN != SIM_PRIORITY_MIN || PROCSCHED_PRIORITY_MAX != SIM_PRIORITY_MAX
+#error "procsched.h and basic_sched.h disagree on the priority range"
+#endif
+
+struct procsched_workload {
+    process_queue queue;
+};
+
+procsched_workload* procsched_workload_new(void) {
+    return calloc(1, sizeof(procsched_workload));
+}
+
+void procsched_workload_free(procsched_workload* workload) {
+    if (!workload) return;
+    while (workload->queue.size > 0) {
+        free(workload->queue.head->proc.process_name);
+        free(workload->queue.head->proc.descriptor_p);
+        remove_head(&workload->queue);
+    }
+    free(workload);
+}
+
+int procsched_workload_add(procsched_workload* workload, const procsched_process* process) {
+    if (!workload || !process || !process->name || !process->ops || process->op_count <= 0 ||
+        process->arrival < 0 || process->tickets < 0 || process->deadline < 0 || process->period < 0 ||
+        process->priority < PROCSCHED_PRIORITY_MIN || process->priority > PROCSCHED_PRIORITY_MAX) {
+        return PROCSCHED_EINVAL;
+    }
+    for (int i = 0; i < process->op_count; i++) {
+        const procsched_op* op = &process->ops[i];
+        if ((op->kind != PROCSCHED_OP_CALC && op->kind != PROCSCHED_OP_IO) || op->duration <= 0) {
+            return PROCSCHED_EINVAL;
+        }
+    }
+
+    // Periodic tasks release one job per period, like the configuration file's
+    int jobs = (process->period > 0 && process->jobs > 1) ? process->jobs : 1;
+    sim_time_t deadline = process->deadline;
+    if (process->period > 0 && deadline == 0) deadline = process->period;
+
+    // The jobs are chained apart and spliced on at the end, so a failure leaves the
+    // workload as it was
+    node_t* first = NULL;
+    node_t* last = NULL;
+    for (int job = 0; job < jobs; job++) {
+        node_t* node = malloc(sizeof(node_t));
+        process_t* proc = node ? &node->proc : NULL;
+        if (proc) {
+            memset(proc, 0, sizeof(*proc));
+            size_t length = strlen(process->name) + 16;
+            proc->process_name = malloc(length);
+            proc->descriptor_p = malloc(process->op_count * sizeof(operation_t));
+            if (proc->process_name) {
+                if (process->period > 0) snprintf(proc->process_name, length, "%s#%d", process->name, job + 1);
+                else strcpy(proc->process_name, process->name);
+            }
+        }
+        if (!proc || !proc->process_name || !proc->descriptor_p) {
+            if (proc) {
+                free(proc->process_name);
+                free(proc->descriptor_p);
+            }
+            free(node);
+            while (first) {
+                node_t* next = first->next;
+                free(first->proc.process_name);
+                free(first->proc.descriptor_p);
+                free(first);
+                first = next;
+            }
+            return PROCSCHED_ENOMEM;
+        }
+        for (int i = 0; i < process->op_count; i++) {
+            proc->descriptor_p[i].operation_p = (process->ops[i].kind == PROCSCHED_OP_IO) ? IO_p : calc_p;
+            proc->descriptor_p[i].duration_op = process->ops[i].duration;
+        }
+        proc->operations_count = process->op_count;
+        proc->arrival_time_p = process->arrival + job * process->period;
+        proc->begining_date = proc->arrival_time_p;
+        proc->priority_p = process->priority;
+        proc->tickets = process->tickets;
+        proc->deadline = deadline;
+        proc->period = process->period;
+        proc->job = job;
+        node->next = NULL;
+        if (last) last->next = node;
+        else first = node;
+        last = node;
+    }
+
+    process_queue* queue = &workload->queue;
+    if (queue->size == 0) queue->head = first;
+    else queue->tail->next = first;
+    queue->tail = last;
+    queue->size += jobs;
+    return PROCSCHED_OK;
+}
+
+int procsched_workload_load(procsched_workload* workload, const char* path) {
+    if (!workload || !path) return PROCSCHED_EINVAL;
+    return (parse_config_file_quiet(path, &workload->queue) > 0) ? PROCSCHED_OK : PROCSCHED_EIO;
+}
+
+int procsched_workload_size(const procsched_workload* workload) {
+    return workload ? workload->queue.size : 0;
+}
+
+void procsched_config_init(procsched_config* config, procsched_policy policy) {
+    memset(config, 0, sizeof(*config));
+    config->policy = policy;
+    config->trace = PROCSCHED_TRACE_FULL;
+    config->quantum = 2;
+    config->seed = 1;
+}
+
+// Forwards the simulator's records to the caller's sink
+typedef struct sink_adapter_t {
+    procsched_sink_fn fn;
+    void* ctx;
+} sink_adapter_t;
+
+static int forward_record(void* ctx, const process_descriptor_t* record) {
+    const sink_adapter_t* adapter = ctx;
+    procsched_record out;
+    out.process = record->process_name;
+    out.time = record->date;
+    out.state = (record->state == terminated_p) ? PROCSCHED_TERMINATED
+              : (record->state == running_p) ? PROCSCHED_RUNNING : PROCSCHED_WAITING;
+    out.io = (record->state == running_p && record->operation == IO_p);
+    return adapter->fn(adapter->ctx, &out);
+}
+
+int procsched_run(const procsched_workload* workload, const procsched_config* config,
+                  procsched_sink_fn sink, void* sink_ctx, procsched_result* result,
+                  procsched_process_stats* stats, int capacity) {
+    if (!workload || !config || !result || capacity < 0 || (capacity > 0 && !stats) ||
+        config->horizon < 0 || config->mlfq_levels > MLFQ_MAX_LEVELS ||
+        config->trace < PROCSCHED_TRACE_FULL || config->trace > PROCSCHED_TRACE_NONE) {
+        return PROCSCHED_EINVAL;
+    }
+    if (config->policy < 1 || config->policy > POLICY_COUNT) return PROCSCHED_EINVAL;
+    if (!policy_available(config->policy)) return PROCSCHED_EUNAVAILABLE;
+
+    policy_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.quantum = (config->quantum > 0) ? config->quantum : 2;
+    params.seed = (config->seed != 0) ? config->seed : 1;
+    params.cfs.target_latency = config->cfs_target_latency;
+    params.cfs.min_granularity = config->cfs_min_granularity;
+    params.aging.threshold = config->aging_threshold;
+    params.mlfq.levels = config->mlfq_levels;
+    for (int l = 0; l < MLFQ_MAX_LEVELS; l++) params.mlfq.quanta[l] = config->mlfq_quanta[l];
+    params.mlfq.boost_period = config->mlfq_boost_period;
+
+    sim_run_t run;
+    sim_run_init(&run, config->horizon);
+    sim_metrics_t metrics;
+    sim_metrics_init(&metrics);
+    run.metrics = &metrics;
+    sink_adapter_t adapter = {sink, sink_ctx};
+    if (sink) {
+        run.sink = forward_record;
+        run.sink_ctx = &adapter;
+        run.trace_level = (sim_trace_level_t)config->trace;
+    } else {
+        run.trace_level = trace_none;   // Nothing to hand the records to
+    }
+
+    // Schedulers only read the queue, so runs may share a workload
+    process_queue* queue = (process_queue*)&workload->queue;
+    policy_run(config->policy, &params, queue, NULL, NULL, &run);
+
+    sim_metrics_summary_t summary;
+    sim_metrics_summarize(&metrics, run.end_time, &summary);
+    memset(result, 0, sizeof(*result));
+    result->status = (procsched_status)run.status;
+    result->end_time = run.end_time;
+    result->finished = run.finished;
+    result->total = run.total;
+    result->mean_waiting = summary.mean_waiting;
+    result->mean_turnaround = summary.mean_turnaround;
+    result->mean_response = summary.mean_response;
+    result->p99_waiting = summary.p99_waiting;
+    result->p99_turnaround = summary.p99_turnaround;
+    result->p99_response = summary.p99_response;
+    result->max_turnaround = summary.max_turnaround;
+    result->makespan = summary.makespan;
+    result->cpu_ticks = summary.cpu_ticks;
+    result->io_ticks = summary.io_ticks;
+    result->context_switches = summary.context_switches;
+    result->throughput = summary.throughput;
+    result->cpu_utilization = summary.utilization;
+    result->io_utilization = summary.io_utilization;
+
+    for (int p = 0; p < metrics.procs.count && p < capacity; p++) {
+        const trace_proc_stats_t* st = &metrics.stats[p];
+        procsched_process_stats* out = &stats[p];
+        memset(out, 0, sizeof(*out));
+        out->name = metrics.procs.names[p];
+        out->start = st->start_time;
+        out->end = st->end_time;
+        out->waiting = st->total_wait;
+        out->running = st->total_run;
+        out->terminated = ((metrics.last_code[p] & 7) == terminated_p);
+    }
+
+    int error = metrics.error;
+    sim_metrics_free(&metrics);
+    return error ? PROCSCHED_ENOMEM : PROCSCHED_OK;
+}
+
+int procsched_policy_available(procsched_policy policy) {
+    return policy_available(policy);
+}
+
+const char* procsched_policy_name(procsched_policy policy) {
+    return policy_name(policy);
+}
+
+const char* procsched_strerror(int code) {
+    switch (code) {
+        case PROCSCHED_OK: return "success";
+        case PROCSCHED_EINVAL: return "invalid argument";
+        case PROCSCHED_ENOMEM: return "out of memory";
+        case PROCSCHED_EUNAVAILABLE: return "policy not available in this build";
+        case PROCSCHED_EIO: return "cannot load the configuration file";
+        default: return "unknown error";
+    }
+}
+
+void procsched_version(int* major, int* minor) {
+    if (major) *major = PROCSCHED_VERSION_MAJOR;
+    if (minor) *minor = PROCSCHED_VERSION_MINOR;
+}
@@ -0,0 +1,194 @@
+#ifndef PROCSCHED_H
+#define PROCSCHED_H
+
+// libprocsched: the schedulers of the simulator as an embeddable C library.
+//
+// Build workloads in memory (or load configuration files), run any policy on them
+// with an optional record sink, and read the run's metrics. The library has no
+// global state and never writes to stdout: workloads are read-only while they run,
+// so any number of threads may run simulations at once, on the same workload or
+// on different ones. Only this header is part of the API; every public struct ends
+// with reserved space so new fields keep the layout (ABI) of version 1.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Exported symbols (the library is built with -fvisibility=hidden)
+#if defined(__GNUC__)
+#define PROCSCHED_API __attribute__((visibility("default")))
+#else
+#define PROCSCHED_API
+#endif
+
+#define PROCSCHED_VERSION_MAJOR 1
+#define PROCSCHED_VERSION_MINOR 0
+
+// Return codes
+#define PROCSCHED_OK 0
+#define PROCSCHED_EINVAL -1        // Invalid argument
+#define PROCSCHED_ENOMEM -2        // Out of memory
+#define PROCSCHED_EUNAVAILABLE -3  // Policy not compiled into this library
+#define PROCSCHED_EIO -4           // Configuration file missing or without processes
+
+// Policies, numbered as in the simulator's menu
+typedef enum procsched_policy {
+    PROCSCHED_FIFO = 1,
+    PROCSCHED_ROUND_ROBIN = 2,
+    PROCSCHED_PRIORITY = 3,
+    PROCSCHED_MULTILEVEL = 4,
+    PROCSCHED_MULTILEVEL_AGING = 5,
+    PROCSCHED_CFS = 6,
+    PROCSCHED_LOTTERY = 7,
+    PROCSCHED_STRIDE = 8,
+    PROCSCHED_EDF = 9,
+    PROCSCHED_MLFQ = 10
+} procsched_policy;
+
+// Accepted process priorities (higher runs first)
+#define PROCSCHED_PRIORITY_MIN 0
+#define PROCSCHED_PRIORITY_MAX 99
+
+typedef enum procsched_op_kind {
+    PROCSCHED_OP_CALC = 0,
+    PROCSCHED_OP_IO = 1
+} procsched_op_kind;
+
+typedef struct procsched_op {
+    procsched_op_kind kind;
+    int64_t duration;          // Ticks, > 0
+} procsched_op;
+
+// One process (or periodic task) of a workload; the workload copies everything
+typedef struct procsched_process {
+    const char* name;
+    int64_t arrival;
+    int priority;              // PROCSCHED_PRIORITY_MIN..PROCSCHED_PRIORITY_MAX
+    int tickets;               // Lottery/stride tickets (0 = priority * 100)
+    int64_t deadline;          // Relative deadline (0 = none, or the period)
+    int64_t period;            // > 0: a periodic task released jobs times
+    int jobs;
+    const procsched_op* ops;
+    int op_count;
+    int64_t reserved[4];       // Zero
+} procsched_process;
+
+typedef struct procsched_workload procsched_workload;
+
+PROCSCHED_API procsched_workload* procsched_workload_new(void);   // NULL when out of memory
+PROCSCHED_API void procsched_workload_free(procsched_workload* workload);
+
+// Append a process; PROCSCHED_EINVAL for a missing name, no operations, a bad operation
+// or a priority out of range. On an error the workload is left unchanged
+PROCSCHED_API int procsched_workload_add(procsched_workload* workload,
+                                         const procsched_process* process);
+
+// Append the processes of a configuration file (the simulator's format); warnings
+// about skipped lines go to stderr
+PROCSCHED_API int procsched_workload_load(procsched_workload* workload, const char* path);
+
+PROCSCHED_API int procsched_workload_size(const procsched_workload* workload);   // Processes (jobs)
+
+// Records a run hands to a sink
+typedef enum procsched_trace {
+    PROCSCHED_TRACE_FULL = 0,          // One record per process per tick
+    PROCSCHED_TRACE_TRANSITIONS = 1,   // Only records that change a process's state
+    PROCSCHED_TRACE_NONE = 2           // No records: metrics only
+} procsched_trace;
+
+typedef enum procsched_state {
+    PROCSCHED_WAITING = 0,
+    PROCSCHED_RUNNING = 1,
+    PROCSCHED_TERMINATED = 2
+} procsched_state;
+
+typedef struct procsched_record {
+    const char* process;       // Valid while the workload lives
+    int64_t time;
+    procsched_state state;
+    int io;                    // Running on the I/O device rather than the CPU
+} procsched_record;
+
+// Receives the records of a run in time order; return 0 to cancel the run
+typedef int (*procsched_sink_fn)(void* ctx, const procsched_record* record);
+
+// Policy and parameters of a run. Initialize with procsched_config_init(); zero
+// parameters select each policy's defaults.
+typedef struct procsched_config {
+    procsched_policy policy;
+    int64_t horizon;           // Stop at this time (0 = run to completion)
+    procsched_trace trace;     // Records given to the sink (ignored without one)
+    int quantum;               // Round-Robin, Lottery, Stride (default 2)
+    uint64_t seed;             // Lottery (default 1)
+    int aging_threshold;       // Multi-level + Aging (default 5)
+    int64_t cfs_target_latency;    // CFS (default 20)
+    int64_t cfs_min_granularity;   // CFS (default 2)
+    int mlfq_levels;           // MLFQ (default 3, at most 16)
+    int64_t mlfq_quanta[16];   // MLFQ allotment per level (default 2, doubled per level)
+    int64_t mlfq_boost_period; // MLFQ (default 50, < 0 = never)
+    int64_t reserved[8];       // Zero
+} procsched_config;
+
+PROCSCHED_API void procsched_config_init(procsched_config* config, procsched_policy policy);
+
+typedef enum procsched_status {
+    PROCSCHED_COMPLETED = 0,           // Every process terminated
+    PROCSCHED_HORIZON_REACHED = 1,
+    PROCSCHED_STALLED = 2,             // No process can ever progress again
+    PROCSCHED_CANCELLED = 3            // The sink returned 0
+} procsched_status;
+
+// Outcome and metrics of a run
+typedef struct procsched_result {
+    procsched_status status;
+    int64_t end_time;          // Simulated time at which the run stopped
+    int finished;              // Terminated processes
+    int total;                 // Processes in the workload
+    double mean_waiting;
+    double mean_turnaround;
+    double mean_response;      // First CPU tick - first record, over processes that ran
+    int64_t p99_waiting;
+    int64_t p99_turnaround;
+    int64_t p99_response;
+    int64_t max_turnaround;
+    int64_t makespan;          // Latest record time
+    int64_t cpu_ticks;
+    int64_t io_ticks;
+    int64_t context_switches;
+    double throughput;         // Terminated processes per tick of the run
+    double cpu_utilization;
+    double io_utilization;
+    int64_t reserved[8];
+} procsched_result;
+
+// Per-process metrics, in order of first appearance in the run
+typedef struct procsched_process_stats {
+    const char* name;          // Valid while the workload lives
+    int64_t start;
+    int64_t end;
+    int64_t waiting;
+    int64_t running;           // CPU and I/O ticks
+    int terminated;
+    int64_t reserved[4];
+} procsched_process_stats;
+
+// Run config's policy on workload. sink (may be NULL) receives the records kept by
+// config->trace. stats (may be NULL) receives up to capacity per-process entries;
+// result->total says how many the workload needs.
+PROCSCHED_API int procsched_run(const procsched_workload* workload, const procsched_config* config,
+                                procsched_sink_fn sink, void* sink_ctx, procsched_result* result,
+                                procsched_process_stats* stats, int capacity);
+
+PROCSCHED_API int procsched_policy_available(procsched_policy policy);
+PROCSCHED_API const char* procsched_policy_name(procsched_policy policy);   // "Round-Robin", ...
+PROCSCHED_API const char* procsched_strerror(int code);
+PROCSCHED_API void procsched_version(int* major, int* minor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+#include "basic_sched.h"
+#include <stdlib.h>
+
+#define TICKETS_PER_PRIORITY 100  // Default tickets = priority_p * 100
+#define STRIDE1 (1 << 20)         // Stride numerator (large for precision)
+
+typedef enum {
+    share_lottery,   // Randomized: winner drawn with probability tickets / total
+    share_stride     // Deterministic: smallest pass runs, pass += stride per quantum
+} share_policy_t;
+
+// Per-process proportional-share state
+typedef struct {
+    process_t proc;
+    int idx;                  // Position in the workload
+    int tickets;              // Base tickets
+    int64_t cur_tickets;      // Tickets in the draw (compensation included)
+    uint64_t stride;          // STRIDE1 / tickets
+    uint64_t pass;            // Virtual time for stride scheduling
+    int heap_pos;             // Slot in the pass heap, -1 when absent
+    int op_idx;               // Current operation index
+    sim_time_t op_remaining;  // Remaining time for current operation
+    sim_time_t quantum_used;  // CPU time used in current quantum
+} share_entity_t;
+
+typedef struct {
+    share_policy_t policy;
+    share_entity_t *ents;
+    int n;
+    // Lottery: Fenwick tree of cur_tickets indexed by idx (1-based)
+    int64_t *fenwick;
+    int64_t total_tickets;
+    int fenwick_step;         // Highest power of two <= n
+    sim_rng_t rng;
+    // Stride: binary min-heap of idx ordered by (pass, idx)
+    int *heap;
+    int heap_size;
+    uint64_t global_pass;
+} share_sched_t;
+
+static void fenwick_add(share_sched_t *s, int idx, int64_t delta) {
+    for (int i = idx + 1; i <= s->n; i += i & -i)
+        s->fenwick[i] += delta;
+    s->total_tickets += delta;
+}
+
+// Index of the entity owning ticket number r, r in [0, total_tickets)
+static int fenwick_find(const share_sched_t *s, int64_t r) {
+    int pos = 0;
+    for (int step = s->fenwick_step; step > 0; step >>= 1) {
+        if (pos + step <= s->n && s->fenwick[pos + step] <= r) {
+            pos += step;
+            r -= s->fenwick[pos];
+        }
+    }
+    return pos;
+}
+
+static int pass_less(const share_sched_t *s, int a, int b) {
+    if (s->ents[a].pass != s->ents[b].pass) return s->ents[a].pass < s->ents[b].pass;
+    return a < b;
+}
+
+static void heap_swap(share_sched_t *s, int i, int j) {
+    int tmp = s->heap[i];
+    s->heap[i] = s->heap[j];
+    s->heap[j] = tmp;
+    s->ents[s->heap[i]].heap_pos = i;
+    s->ents[s->heap[j]].heap_pos = j;
+}
+
+static void heap_push(share_sched_t *s, int idx) {
+    int i = s->heap_size++;
+    s->heap[i] = idx;
+    s->ents[idx].heap_pos = i;
+    while (i > 0 && pass_less(s, s->heap[i], s->heap[(i - 1) / 2])) {
+        heap_swap(s, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static int heap_pop(share_sched_t *s) {
+    int top = s->heap[0];
+    s->ents[top].heap_pos = -1;
+    if (--s->heap_size > 0) {
+        s->heap[0] = s->heap[s->heap_size];
+        s->ents[s->heap[0]].heap_pos = 0;
+        int i = 0;
+        for (;;) {
+            int l = 2 * i + 1, r = l + 1, m = i;
+            if (l < s->heap_size && pass_less(s, s->heap[l], s->heap[m])) m = l;
+            if (r < s->heap_size && pass_less(s, s->heap[r], s->heap[m])) m = r;
+            if (m == i) break;
+            heap_swap(s, i, m);
+            i = m;
+        }
+    }
+    return top;
+}
+
+// A process becomes eligible for the CPU
+static void share_insert(share_sched_t *s, share_entity_t *e) {
+    if (s->policy == share_lottery) {
+        fenwick_add(s, e->idx, e->cur_tickets);
+    } else {
+        if (e->pass < s->global_pass) e->pass = s->global_pass;
+        heap_push(s, e->idx);
+    }
+}
+
+static int share_empty(const share_sched_t *s) {
+    return (s->policy == share_lottery) ? (s->total_tickets == 0) : (s->heap_size == 0);
+}
+
+// Remove and return the next process to run
+static share_entity_t *share_pick(share_sched_t *s) {
+    share_entity_t *e;
+    if (s->policy == share_lottery) {
+        int64_t r = (int64_t)sim_rng_below(&s->rng, (uint64_t)s->total_tickets);
+        e = &s->ents[fenwick_find(s, r)];
+        fenwick_add(s, e->idx, -e->cur_tickets);
+        e->cur_tickets = e->tickets;  // Compensation lasts until the next win
+    } else {
+        e = &s->ents[heap_pop(s)];
+        s->global_pass = e->pass;
+    }
+    e->quantum_used = 0;
+    return e;
+}
+
+// Charge the CPU time used when a process leaves the CPU
+static void share_charge(share_sched_t *s, share_entity_t *e, int quantum) {
+    if (e->quantum_used <= 0) return;
+    if (s->policy == share_lottery) {
+        // Compensation tickets: yielding early inflates tickets by quantum / used
+        if (e->quantum_used < quantum)
+            e->cur_tickets = (int64_t)e->tickets * quantum / e->quantum_used;
+    } else {
+        e->pass += e->stride * (uint64_t)e->quantum_used / (uint64_t)quantum;
+    }
+}
+
+// Put an entity where its current operation can be served (no-op when stuck or done)
+static void share_make_ready(share_sched_t *s, share_entity_t *e, sim_active_t *set) {
+    if (e->op_idx >= e->proc.operations_count) return;
+
+    process_operation_t op = e->proc.descriptor_p[e->op_idx].operation_p;
+    if (op == calc_p) share_insert(s, e);
+    else if (op == IO_p) sim_active_io_push(set, e->idx);
+}
+
+static void proportional_share_sched(process_queue *p, process_descriptor_t **descriptor, int *size,
+                                     int quantum, share_policy_t policy, uint64_t seed,
+                                     sim_run_t *run) {
+    if (!p || p->size == 0 || quantum <= 0) return;
+
+    int n = p->size;
+    share_sched_t s;
+    s.policy = policy;
+    s.n = n;
+    s.ents = calloc(n, sizeof(share_entity_t));
+    s.fenwick = calloc(n + 1, sizeof(int64_t));
+    s.heap = malloc(n * sizeof(int));
+    s.total_tickets = 0;
+    s.heap_size = 0;
+    s.global_pass = 0;
+    sim_rng_seed(&s.rng, seed);
+    for (s.fenwick_step = 1; s.fenwick_step * 2 <= n; s.fenwick_step *= 2);
+
+    sim_active_t set;
+    int set_ok = sim_active_init(&set, p);
+
+    if (!s.ents || !s.fenwick || !s.heap || !set_ok) {
+        free(s.ents); free(s.fenwick); free(s.heap);
+        if (set_ok) sim_active_free(&set);
+        return;
+    }
+
+    int idx = 0;
+    for (node_t *node = p->head; node != NULL; node = node->next, idx++) {
+        share_entity_t *e = &s.ents[idx];
+        e->proc = node->proc;
+        e->idx = idx;
+        e->tickets = node->proc.tickets;
+        if (e->tickets <= 0) {
+            e->tickets = (node->proc.priority_p > 0 ? node->proc.priority_p : 1) * TICKETS_PER_PRIORITY;
+        }
+        e->cur_tickets = e->tickets;
+        e->stride = STRIDE1 / (uint64_t)e->tickets;
+        if (e->stride == 0) e->stride = 1;
+        e->heap_pos = -1;
+        e->op_idx = 0;
+        e->op_remaining = (node->proc.operations_count > 0) ?
+                              node->proc.descriptor_p[0].duration_op : 0;
+    }
+
+    share_entity_t *curr = NULL;   // Process holding the CPU
+
+    sim_time_t current_time = 0;
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
+
+    while (set.finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
+
+        // Admit arrivals
+        for (int a; (a = sim_active_admit(&set, current_time)) >= 0;) {
+            share_make_ready(&s, &s.ents[a], &set);
+        }
+
+        // Quantum expired: the current process re-enters the selection
+        if (curr && curr->quantum_used >= quantum) {
+            share_charge(&s, curr, quantum);
+            share_insert(&s, curr);
+            curr = NULL;
+        }
+
+        if (!curr && !share_empty(&s)) {
+            curr = share_pick(&s);
+        }
+
+        share_entity_t *cpu_ran = curr;
+        share_entity_t *io_ran = (set.io_head >= 0) ? &s.ents[set.io_head] : NULL;
+
+        // Execute CPU operation
+        if (cpu_ran) {
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, cpu_ran->idx, calc_p,
+                                                  &cpu_ran->op_idx, &cpu_ran->op_remaining, current_time);
+            cpu_ran->quantum_used++;
+
+            // Operation completed: leave the CPU
+            if (r != sim_op_continues) {
+                share_charge(&s, cpu_ran, quantum);
+                curr = NULL;
+            }
+            if (r == sim_op_next) share_make_ready(&s, cpu_ran, &set);
+        }
+
+        // Execute I/O operation (one device, served in FIFO order)
+        if (io_ran) {
+            sim_op_result_t r = sim_active_run_op(&set, run, descriptor, size, io_ran->idx, IO_p,
+                                                  &io_ran->op_idx, &io_ran->op_remaining, current_time);
+            if (r != sim_op_continues) sim_active_io_pop(&set);
+            if (r == sim_op_next) share_make_ready(&s, io_ran, &set);
+        }
+
+        if (!sim_active_end_tick(&set, run, descriptor, size, cpu_ran ? cpu_ran->idx : -1,
+                                 io_ran ? io_ran->idx : -1, &current_time, &status)) {
+            break;
+        }
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = set.finished;
+        run->total = n;
+    }
+
+    free(s.ents);
+    free(s.fenwick);
+    free(s.heap);
+    sim_active_free(&set);
+}
+
+void lottery_sched(process_queue *p, process_descriptor_t **descriptor, int *size,
+                   int quantum, uint64_t seed, sim_run_t *run) {
+    proportional_share_sched(p, descriptor, size, quantum, share_lottery, seed, run);
+}
+
+void stride_sched(process_queue *p, process_descriptor_t **descriptor, int *size,
+                  int quantum, sim_run_t *run) {
+    proportional_share_sched(p, descriptor, size, quantum, share_stride, 0, run);
+}
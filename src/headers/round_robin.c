@@ -1,4 +1,5 @@
 #include "basic_sched.h"
+#include "checkpoint.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -6,13 +7,13 @@
 typedef struct {
     process_t proc;
     int op_idx;           // Current operation index
-    int op_remaining;     // Remaining time for current operation
+    sim_time_t op_remaining; // Remaining time for current operation
     int cpu_time_used;    // Time used in current quantum (for CALC only)
-    int io_until;         // Time when I/O will complete (-1 if not doing I/O)
+    sim_time_t io_until;  // Time when I/O will complete (-1 if not doing I/O)
     int terminated;       // 1 if process is terminated
 } proc_state_t;
 
-void round_robin_sched(process_queue *p, process_descriptor_t **descriptor, int *size, int quantum) {
+void round_robin_sched(process_queue *p, process_descriptor_t **descriptor, int *size, int quantum, sim_run_t *run) {
     if (!p || p->size == 0 || quantum <= 0) return;
 
     int n = p->size;
@@ -31,12 +32,40 @@ void round_robin_sched(process_queue *p, process_descriptor_t **descriptor, int
         idx++;
     }
 
-    int current_time = 0;
+    sim_time_t current_time = 0;
     int finished = 0;
-    int max_time = 10000; // Safety timeout
+    sim_time_t horizon = run ? run->horizon : 0;
+    sim_status_t status = sim_completed;
     int rr_index = 0; // Round-robin queue index
 
-    while (finished < n && current_time < max_time) {
+    // Continue a snapshot: process states plus the rotation position
+    const sim_checkpoint_t *cp = checkpoint_resume(run, checkpoint_round_robin, p, 1);
+    if (cp) {
+        for (int k = 0; k < n; k++) {
+            states[k].op_idx = cp->procs[k].op_idx;
+            states[k].op_remaining = cp->procs[k].op_remaining;
+            states[k].cpu_time_used = (int)cp->procs[k].slice_used;
+            states[k].io_until = cp->procs[k].io_until;
+            states[k].terminated = cp->procs[k].terminated;
+        }
+        rr_index = (cp->cursors[0] >= 0) ? (int)cp->cursors[0] : 0;
+        current_time = cp->time;
+        finished = cp->finished;
+    } else if (run && run->resume) {
+        free(states);
+        return;
+    }
+
+    while (finished < n) {
+        if (horizon > 0 && current_time >= horizon) {
+            status = sim_horizon_reached;
+            break;
+        }
+        if (run && run->cancelled) {
+            status = sim_cancelled;
+            break;
+        }
+
         int cpu_assigned = -1;
         int io_assigned = -1;
 
@@ -91,7 +120,7 @@ void round_robin_sched(process_queue *p, process_descriptor_t **descriptor, int
             entry.date = current_time;
             entry.state = running_p;
             entry.operation = calc_p;
-            append_descriptor(descriptor, entry, size);
+            sim_emit(run, descriptor, size, entry);
 
             ps->op_remaining--;
             ps->cpu_time_used++;
@@ -121,7 +150,7 @@ void round_robin_sched(process_queue *p, process_descriptor_t **descriptor, int
             entry.date = current_time;
             entry.state = running_p;
             entry.operation = IO_p;
-            append_descriptor(descriptor, entry, size);
+            sim_emit(run, descriptor, size, entry);
 
             // Check if I/O completed
             if (ps->io_until <= current_time + 1) {
@@ -144,10 +173,11 @@ void round_robin_sched(process_queue *p, process_descriptor_t **descriptor, int
             entry.date = current_time;
             entry.state = waiting_p;
             entry.operation = none;
-            append_descriptor(descriptor, entry, size);
+            sim_emit(run, descriptor, size, entry);
         }
 
         // Check for terminated processes
+        int terminated_now = 0;
         for (int k = 0; k < n; k++) {
             if (states[k].terminated) continue;
             if (states[k].proc.arrival_time_p > current_time) continue;
@@ -155,19 +185,63 @@ void round_robin_sched(process_queue *p, process_descriptor_t **descriptor, int
             if (states[k].op_idx >= states[k].proc.operations_count && states[k].io_until < 0) {
                 states[k].terminated = 1;
                 finished++;
+                terminated_now++;
                 
                 process_descriptor_t entry;
                 entry.process_name = states[k].proc.process_name;
                 entry.date = current_time + 1;
                 entry.state = terminated_p;
                 entry.operation = none;
-                append_descriptor(descriptor, entry, size);
+                sim_emit(run, descriptor, size, entry);
+            }
+        }
+
+        // Nothing ran or terminated: skip idle gaps (up to the horizon), detect permanent stalls
+        if (cpu_assigned < 0 && io_assigned < 0 && !terminated_now) {
+            int active = 0;
+            sim_time_t next_arrival = -1;
+            for (int k = 0; k < n; k++) {
+                if (states[k].terminated) continue;
+                if (states[k].proc.arrival_time_p > current_time) {
+                    if (next_arrival < 0 || states[k].proc.arrival_time_p < next_arrival)
+                        next_arrival = states[k].proc.arrival_time_p;
+                } else {
+                    active = 1;
+                }
+            }
+            if (next_arrival < 0) {
+                status = sim_stalled;
+                current_time++;
+                break;
+            }
+            if (!active) {
+                current_time = (horizon > 0 && next_arrival > horizon) ? horizon : next_arrival;
+                continue;
             }
         }
 
         current_time++;
     }
 
+    if (status == sim_horizon_reached || status == sim_cancelled) {
+        sim_checkpoint_t *out = checkpoint_begin(run, checkpoint_round_robin, p, current_time, finished, 1);
+        for (int k = 0; out && k < n; k++) {
+            out->procs[k].op_idx = states[k].op_idx;
+            out->procs[k].op_remaining = states[k].op_remaining;
+            out->procs[k].slice_used = states[k].cpu_time_used;
+            out->procs[k].io_until = states[k].io_until;
+            out->procs[k].terminated = states[k].terminated;
+        }
+        if (out) out->cursors[0] = rr_index;
+    }
+
+    if (run) {
+        run->status = status;
+        run->end_time = current_time;
+        run->finished = finished;
+        run->total = n;
+    }
+
     free(states);
 }
 
@@ -0,0 +1,785 @@
+#define _POSIX_C_SOURCE 200809L
+#include "server.h"
+#include "config_parser.h"
+#include "experiment.h"
+#include "policy.h"
+#include "sim_metrics.h"
+#include "sweep_shards.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SERVER_DEFAULT_CACHE 256
+#define SERVER_QUEUE_CAPACITY 1024   // Pending runs before readers stop reading
+#define SERVER_CONN_BACKLOG (64 << 10)   // Unsent reply bytes before a reader stops reading
+#define SERVER_DRAIN_SECONDS 5       // Time given to writers to flush replies on shutdown
+#define SERVER_ACCEPT_BACKOFF_MS 100 // Pause after accept() runs out of descriptors or memory
+#define REPLY_HEADER_SIZE 10
+#define RUN_REQUEST_SIZE 65
+#define RUN_REPLY_SIZE 129
+#define INFO_REPLY_SIZE 20
+
+static unsigned char* put_u32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) *p++ = (unsigned char)(v >> (8 * i));
+    return p;
+}
+
+static unsigned char* put_u64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) *p++ = (unsigned char)(v >> (8 * i));
+    return p;
+}
+
+static unsigned char* put_f64(unsigned char* p, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return put_u64(p, bits);
+}
+
+static uint32_t get_u32(const unsigned char* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t get_u64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+// FNV-1a: the id of a workload's text
+static uint64_t hash_text(const char* text, size_t length) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// A parsed workload; runs only read its queue
+typedef struct cached_workload_t {
+    uint64_t id;
+    char* text;                // Kept to tell hash collisions apart
+    size_t length;
+    process_queue queue;
+    int refs;                  // The cache's own, plus one per pending run
+    uint64_t last_used;        // Cache clock at the latest load or run
+} cached_workload_t;
+
+typedef struct workload_cache_t {
+    cached_workload_t** entries;
+    int count;
+    int capacity;
+    uint64_t clock;
+    pthread_mutex_t lock;
+} workload_cache_t;
+
+struct server_t;
+
+// A client connection, shared by its reader thread, the runs it queued and its writer
+// thread. Replies are appended to the outbound buffer and sent by the writer, so a
+// client that reads slowly only holds up its own reader, never the workers.
+typedef struct server_conn_t {
+    int fd;
+    int refs;                  // The reader's, plus one per pending run
+    int done;                  // refs reached 0: the writer sends what is left and closes
+    int failed;                // A send failed: further replies are dropped
+    unsigned char* out;        // Replies not yet handed to the writer
+    size_t out_size;
+    size_t out_cap;
+    pthread_mutex_t lock;      // Guards refs, done, failed and the outbound buffer
+    pthread_cond_t changed;    // Replies queued (for the writer) or sent (for the reader)
+    struct server_t* server;
+    struct server_conn_t* prev;    // Open connections of the server
+    struct server_conn_t* next;
+} server_conn_t;
+
+typedef struct server_job_t {
+    server_conn_t* conn;
+    uint32_t tag;
+    cached_workload_t* workload;
+    int choice;
+    policy_params_t params;
+    sim_time_t horizon;
+} server_job_t;
+
+typedef struct server_t {
+    workload_cache_t cache;
+    server_job_t jobs[SERVER_QUEUE_CAPACITY];   // Ring of pending runs
+    int head;
+    int count;
+    int stopping;
+    int threads;
+    int64_t runs;              // Runs served
+    server_conn_t* conns;      // Open connections (until their writer closes them)
+    int conn_count;
+    pthread_mutex_t lock;      // Guards the ring, stopping, runs and the connections
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    pthread_cond_t conns_closed;
+} server_t;
+
+static volatile sig_atomic_t server_stop = 0;
+static int server_wake_fd = -1;   // Write end of the self-pipe the accept loop polls
+
+static void server_on_signal(int sig) {
+    (void)sig;
+    int saved = errno;
+    server_stop = 1;
+    if (write(server_wake_fd, "", 1) < 0) {
+        // The pipe is full, so the accept loop is already being woken
+    }
+    errno = saved;
+}
+
+static void workload_unref(cached_workload_t* w) {
+    if (--w->refs > 0) return;
+    workload_free(&w->queue);
+    free(w->text);
+    free(w);
+}
+
+// Entry with this exact text (*id gets its id), or NULL and *id is a free id for it
+static cached_workload_t* cache_find_text(workload_cache_t* cache, const char* text, size_t length,
+                                          uint64_t* id) {
+    for (uint64_t h = hash_text(text, length);; h++) {
+        cached_workload_t* clash = NULL;
+        for (int i = 0; i < cache->count && !clash; i++) {
+            if (cache->entries[i]->id == h) clash = cache->entries[i];
+        }
+        *id = h;
+        if (!clash) return NULL;
+        if (clash->length == length && memcmp(clash->text, text, length) == 0) return clash;
+    }
+}
+
+static int cache_index(const workload_cache_t* cache, uint64_t id) {
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->entries[i]->id == id) return i;
+    }
+    return -1;
+}
+
+static void cache_remove(workload_cache_t* cache, int index) {
+    cached_workload_t* w = cache->entries[index];
+    cache->entries[index] = cache->entries[--cache->count];
+    workload_unref(w);
+}
+
+// Cache a workload's text (parsing it unless already cached); returns a status
+static int cache_load(workload_cache_t* cache, const char* text, size_t length, uint64_t* id,
+                      int* processes) {
+    pthread_mutex_lock(&cache->lock);
+    cached_workload_t* found = cache_find_text(cache, text, length, id);
+    if (found) {
+        found->last_used = ++cache->clock;
+        *processes = found->queue.size;
+        pthread_mutex_unlock(&cache->lock);
+        return server_ok;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    // Parse without the lock: other clients keep running meanwhile
+    cached_workload_t* w = calloc(1, sizeof(cached_workload_t));
+    char* copy = malloc(length > 0 ? length : 1);
+    if (!w || !copy) {
+        free(w);
+        free(copy);
+        return server_no_memory;
+    }
+    memcpy(copy, text, length);
+    w->text = copy;
+    w->length = length;
+    w->refs = 1;
+    int parsed = parse_config_buffer(text, length, &w->queue);
+    if (parsed <= 0) {
+        workload_unref(w);
+        return (parsed < 0) ? server_bad_workload : server_no_processes;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    found = cache_find_text(cache, text, length, id);   // Another client may have won
+    if (found) {
+        found->last_used = ++cache->clock;
+        *processes = found->queue.size;
+        pthread_mutex_unlock(&cache->lock);
+        workload_unref(w);
+        return server_ok;
+    }
+    if (cache->count == cache->capacity) {
+        int oldest = 0;
+        for (int i = 1; i < cache->count; i++) {
+            if (cache->entries[i]->last_used < cache->entries[oldest]->last_used) oldest = i;
+        }
+        cache_remove(cache, oldest);
+    }
+    w->id = *id;
+    w->last_used = ++cache->clock;
+    cache->entries[cache->count++] = w;
+    *processes = w->queue.size;
+    pthread_mutex_unlock(&cache->lock);
+    return server_ok;
+}
+
+// Reference to a cached workload for a run, NULL when it is not cached
+static cached_workload_t* cache_acquire(workload_cache_t* cache, uint64_t id) {
+    pthread_mutex_lock(&cache->lock);
+    int index = cache_index(cache, id);
+    cached_workload_t* w = NULL;
+    if (index >= 0) {
+        w = cache->entries[index];
+        w->refs++;
+        w->last_used = ++cache->clock;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return w;
+}
+
+static void cache_release(workload_cache_t* cache, cached_workload_t* w) {
+    pthread_mutex_lock(&cache->lock);
+    workload_unref(w);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+static int cache_drop(workload_cache_t* cache, uint64_t id) {
+    pthread_mutex_lock(&cache->lock);
+    int index = cache_index(cache, id);
+    if (index >= 0) cache_remove(cache, index);
+    pthread_mutex_unlock(&cache->lock);
+    return index >= 0;
+}
+
+// The last reference hands the connection to its writer, which closes it
+static void conn_release(server_conn_t* conn) {
+    pthread_mutex_lock(&conn->lock);
+    if (--conn->refs == 0) {
+        conn->done = 1;
+        pthread_cond_broadcast(&conn->changed);
+    }
+    pthread_mutex_unlock(&conn->lock);
+}
+
+static int read_full(int fd, unsigned char* buf, size_t size) {
+    while (size > 0) {
+        ssize_t n = read(fd, buf, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        buf += n;
+        size -= (size_t)n;
+    }
+    return 1;
+}
+
+static int send_full(int fd, const unsigned char* buf, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, buf, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        buf += n;
+        size -= (size_t)n;
+    }
+    return 1;
+}
+
+// Queue a reply for the connection's writer; never blocks on the client. A reply is
+// lost when the client has gone (its reader then sees the end of the stream), or when
+// there is no memory for it, in which case the connection is shut down.
+static void server_reply(server_conn_t* conn, uint32_t tag, int type, int status,
+                         const unsigned char* body, size_t size) {
+    unsigned char frame[REPLY_HEADER_SIZE + RUN_REPLY_SIZE];
+    unsigned char* p = put_u32(frame, (uint32_t)(REPLY_HEADER_SIZE - 4 + size));
+    p = put_u32(p, tag);
+    *p++ = (unsigned char)type;
+    *p++ = (unsigned char)status;
+    if (size > 0) memcpy(p, body, size);
+    size += REPLY_HEADER_SIZE;
+
+    pthread_mutex_lock(&conn->lock);
+    if (!conn->failed && conn->out_size + size > conn->out_cap) {
+        size_t cap = conn->out_cap ? conn->out_cap : 1024;
+        while (cap < conn->out_size + size) cap *= 2;
+        unsigned char* out = realloc(conn->out, cap);
+        if (out) {
+            conn->out = out;
+            conn->out_cap = cap;
+        } else {
+            conn->failed = 1;
+            shutdown(conn->fd, SHUT_RDWR);
+        }
+    }
+    if (!conn->failed) {
+        memcpy(conn->out + conn->out_size, frame, size);
+        conn->out_size += size;
+        pthread_cond_broadcast(&conn->changed);
+    }
+    pthread_mutex_unlock(&conn->lock);
+}
+
+// One thread per connection: sends the queued replies outside the lock, then closes
+// the connection once its reader and runs are done with it
+static void* server_writer_main(void* arg) {
+    server_conn_t* conn = arg;
+    unsigned char* sending = NULL;
+    size_t sending_cap = 0;
+
+    pthread_mutex_lock(&conn->lock);
+    for (;;) {
+        while (conn->out_size == 0 && !conn->done) pthread_cond_wait(&conn->changed, &conn->lock);
+        if (conn->out_size == 0) break;
+
+        // Swap buffers: replies keep queueing while this batch is sent
+        unsigned char* batch = conn->out;
+        size_t size = conn->out_size;
+        size_t cap = conn->out_cap;
+        conn->out = sending;
+        conn->out_cap = sending_cap;
+        conn->out_size = 0;
+        sending = batch;
+        sending_cap = cap;
+        int failed = conn->failed;
+        pthread_mutex_unlock(&conn->lock);
+
+        int ok = failed || send_full(conn->fd, sending, size);
+
+        pthread_mutex_lock(&conn->lock);
+        if (!ok) conn->failed = 1;
+        pthread_cond_broadcast(&conn->changed);
+    }
+    pthread_mutex_unlock(&conn->lock);
+    free(sending);
+
+    server_t* s = conn->server;
+    pthread_mutex_lock(&s->lock);
+    if (conn->prev) conn->prev->next = conn->next;
+    else s->conns = conn->next;
+    if (conn->next) conn->next->prev = conn->prev;
+    s->conn_count--;
+    pthread_cond_broadcast(&s->conns_closed);
+    pthread_mutex_unlock(&s->lock);
+
+    close(conn->fd);
+    free(conn->out);
+    pthread_cond_destroy(&conn->changed);
+    pthread_mutex_destroy(&conn->lock);
+    free(conn);
+    return NULL;
+}
+
+// Queue a run, waiting while the ring is full; 0 once the server stops
+static int server_push(server_t* s, const server_job_t* job) {
+    pthread_mutex_lock(&s->lock);
+    while (s->count == SERVER_QUEUE_CAPACITY && !s->stopping) pthread_cond_wait(&s->not_full, &s->lock);
+    int ok = !s->stopping;
+    if (ok) {
+        s->jobs[(s->head + s->count) % SERVER_QUEUE_CAPACITY] = *job;
+        s->count++;
+        pthread_cond_signal(&s->not_empty);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return ok;
+}
+
+// Next queued run; 0 once the server stops and the ring is drained
+static int server_pop(server_t* s, server_job_t* job) {
+    pthread_mutex_lock(&s->lock);
+    while (s->count == 0 && !s->stopping) pthread_cond_wait(&s->not_empty, &s->lock);
+    int ok = (s->count > 0);
+    if (ok) {
+        *job = s->jobs[s->head];
+        s->head = (s->head + 1) % SERVER_QUEUE_CAPACITY;
+        s->count--;
+        pthread_cond_signal(&s->not_full);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return ok;
+}
+
+// Simulate a job (statistics only) and encode the reply body
+static int server_simulate(const server_job_t* job, unsigned char* body) {
+    sim_run_t run;
+    sim_run_init(&run, job->horizon);
+    sim_metrics_t metrics;
+    sim_metrics_init(&metrics);
+    run.trace_level = trace_none;
+    run.metrics = &metrics;
+    policy_run(job->choice, &job->params, &job->workload->queue, NULL, NULL, &run);
+
+    sim_metrics_summary_t s;
+    sim_metrics_summarize(&metrics, run.end_time, &s);
+    int error = metrics.error;
+    sim_metrics_free(&metrics);
+    if (error) return server_no_memory;
+
+    unsigned char* p = body;
+    *p++ = (unsigned char)run.status;
+    p = put_u64(p, (uint64_t)run.end_time);
+    p = put_u32(p, (uint32_t)run.finished);
+    p = put_u32(p, (uint32_t)run.total);
+    p = put_f64(p, s.mean_waiting);
+    p = put_f64(p, s.mean_turnaround);
+    p = put_f64(p, s.mean_response);
+    p = put_u64(p, (uint64_t)s.p99_waiting);
+    p = put_u64(p, (uint64_t)s.p99_turnaround);
+    p = put_u64(p, (uint64_t)s.p99_response);
+    p = put_u64(p, (uint64_t)s.max_turnaround);
+    p = put_u64(p, (uint64_t)s.makespan);
+    p = put_u64(p, (uint64_t)s.cpu_ticks);
+    p = put_u64(p, (uint64_t)s.io_ticks);
+    p = put_u64(p, (uint64_t)s.context_switches);
+    p = put_f64(p, s.throughput);
+    p = put_f64(p, s.utilization);
+    put_f64(p, s.io_utilization);
+    return server_ok;
+}
+
+static void* server_worker_main(void* arg) {
+    server_t* s = arg;
+    server_job_t job;
+    while (server_pop(s, &job)) {
+        unsigned char body[RUN_REPLY_SIZE];
+        int status = server_simulate(&job, body);
+        server_reply(job.conn, job.tag, SERVER_RUN, status, body, (status == server_ok) ? RUN_REPLY_SIZE : 0);
+        cache_release(&s->cache, job.workload);
+        conn_release(job.conn);
+
+        pthread_mutex_lock(&s->lock);
+        s->runs++;
+        pthread_mutex_unlock(&s->lock);
+    }
+    return NULL;
+}
+
+// Decode a run request into a job; returns a status
+static int server_parse_run(server_t* s, const unsigned char* body, size_t size, server_job_t* job) {
+    if (size != RUN_REQUEST_SIZE) return server_bad_request;
+    uint64_t id = get_u64(body);
+    int choice = body[8];
+    int32_t quantum = (int32_t)get_u32(body + 9);
+    uint64_t seed = get_u64(body + 13);
+    int32_t aging = (int32_t)get_u32(body + 21);
+    sim_time_t latency = (sim_time_t)get_u64(body + 25);
+    sim_time_t granularity = (sim_time_t)get_u64(body + 33);
+    sim_time_t mlfq_quantum = (sim_time_t)get_u64(body + 41);
+    sim_time_t boost = (sim_time_t)get_u64(body + 49);
+    sim_time_t horizon = (sim_time_t)get_u64(body + 57);
+    if (choice < 1 || choice > POLICY_COUNT || quantum < 0 || horizon < 0) return server_bad_request;
+    if (!policy_available(choice)) return server_unavailable;
+
+    job->choice = choice;
+    job->horizon = horizon;
+    memset(&job->params, 0, sizeof(job->params));
+    job->params.quantum = (quantum > 0) ? quantum : 2;
+    job->params.seed = (seed != 0) ? seed : 1;
+    job->params.aging.threshold = aging;
+    job->params.cfs.target_latency = latency;
+    job->params.cfs.min_granularity = granularity;
+    job->params.mlfq.quanta[0] = mlfq_quantum;
+    job->params.mlfq.boost_period = boost;
+    job->workload = cache_acquire(&s->cache, id);
+    return job->workload ? server_ok : server_unknown_workload;
+}
+
+typedef struct server_reader_t {
+    server_t* server;
+    server_conn_t* conn;
+} server_reader_t;
+
+// One thread per connection: reads requests, answers loads itself and queues runs
+static void* server_reader_main(void* arg) {
+    server_reader_t reader = *(server_reader_t*)arg;
+    free(arg);
+    server_t* s = reader.server;
+    server_conn_t* conn = reader.conn;
+
+    unsigned char header[4];
+    for (;;) {
+        // Stop reading while the client is not reading its replies
+        pthread_mutex_lock(&conn->lock);
+        while (conn->out_size > SERVER_CONN_BACKLOG && !conn->failed) {
+            pthread_cond_wait(&conn->changed, &conn->lock);
+        }
+        pthread_mutex_unlock(&conn->lock);
+
+        if (!read_full(conn->fd, header, sizeof(header))) break;
+        uint32_t length = get_u32(header);
+        if (length < 5 || length > SERVER_MAX_REQUEST) break;
+        unsigned char* request = malloc(length);
+        if (!request || !read_full(conn->fd, request, length)) {
+            free(request);
+            break;
+        }
+        uint32_t tag = get_u32(request);
+        int type = request[4];
+        const unsigned char* body = request + 5;
+        size_t size = length - 5;
+
+        if (type == SERVER_LOAD) {
+            uint64_t id = 0;
+            int processes = 0;
+            int status = cache_load(&s->cache, (const char*)body, size, &id, &processes);
+            unsigned char reply[12];
+            put_u32(put_u64(reply, id), (uint32_t)processes);
+            server_reply(conn, tag, type, status, reply, (status == server_ok) ? sizeof(reply) : 0);
+        } else if (type == SERVER_RUN) {
+            server_job_t job;
+            memset(&job, 0, sizeof(job));
+            int status = server_parse_run(s, body, size, &job);
+            if (status == server_ok) {
+                job.conn = conn;
+                job.tag = tag;
+                pthread_mutex_lock(&conn->lock);
+                conn->refs++;
+                pthread_mutex_unlock(&conn->lock);
+                if (!server_push(s, &job)) {
+                    server_reply(conn, tag, type, server_stopping, NULL, 0);
+                    cache_release(&s->cache, job.workload);
+                    conn_release(conn);
+                    free(request);
+                    break;
+                }
+            } else {
+                server_reply(conn, tag, type, status, NULL, 0);
+            }
+        } else if (type == SERVER_DROP) {
+            int status = (size != 8) ? server_bad_request
+                       : cache_drop(&s->cache, get_u64(body)) ? server_ok : server_unknown_workload;
+            server_reply(conn, tag, type, status, NULL, 0);
+        } else if (type == SERVER_INFO) {
+            unsigned char reply[INFO_REPLY_SIZE];
+            pthread_mutex_lock(&s->cache.lock);
+            int cached = s->cache.count;
+            pthread_mutex_unlock(&s->cache.lock);
+            pthread_mutex_lock(&s->lock);
+            int64_t runs = s->runs;
+            pthread_mutex_unlock(&s->lock);
+            unsigned char* p = put_u32(reply, SERVER_PROTOCOL_VERSION);
+            p = put_u32(p, (uint32_t)s->threads);
+            p = put_u32(p, (uint32_t)cached);
+            put_u64(p, (uint64_t)runs);
+            server_reply(conn, tag, type, server_ok, reply, sizeof(reply));
+        } else {
+            server_reply(conn, tag, type, server_bad_request, NULL, 0);
+        }
+        free(request);
+    }
+    conn_release(conn);
+    return NULL;
+}
+
+// Threads are started with SIGINT and SIGTERM blocked, so only the accept loop sees them
+static int spawn_thread(pthread_t* id, void* (*start)(void*), void* arg) {
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGINT);
+    sigaddset(&block, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &block, &old);
+    int ok = (pthread_create(id, NULL, start, arg) == 0);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    return ok;
+}
+
+int server_run(const server_options_t* opts) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(opts->path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Error: socket path '%s' is too long\n", opts->path);
+        return 1;
+    }
+    strcpy(addr.sun_path, opts->path);
+
+    struct stat st;
+    if (lstat(opts->path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "Error: '%s' exists and is not a socket\n", opts->path);
+            return 1;
+        }
+        unlink(opts->path);   // Left behind by a server that did not stop cleanly
+    }
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(listen_fd, 64) != 0) {
+        fprintf(stderr, "Error: cannot listen on '%s': %s\n", opts->path, strerror(errno));
+        if (listen_fd >= 0) close(listen_fd);
+        return 1;
+    }
+
+    server_t* s = calloc(1, sizeof(server_t));
+    int threads = (opts->threads > 0) ? opts->threads : sweep_online_cpus();
+    pthread_t* workers = calloc(threads, sizeof(pthread_t));
+    if (s) {
+        s->cache.capacity = (opts->cache_size > 0) ? opts->cache_size : SERVER_DEFAULT_CACHE;
+        s->cache.entries = calloc(s->cache.capacity, sizeof(cached_workload_t*));
+    }
+    if (!s || !workers || !s->cache.entries) {
+        fprintf(stderr, "Error: out of memory\n");
+        close(listen_fd);
+        unlink(opts->path);
+        return 1;
+    }
+    pthread_mutex_init(&s->cache.lock, NULL);
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->not_empty, NULL);
+    pthread_cond_init(&s->not_full, NULL);
+    pthread_cond_init(&s->conns_closed, NULL);
+
+    // A signal writes to a self-pipe, so a stop that lands just before poll() still
+    // wakes it. The listening socket is non-blocking: a client that is gone by the
+    // time accept() runs makes it fail instead of block
+    int wake[2];
+    if (pipe(wake) != 0) {
+        fprintf(stderr, "Error: cannot create a pipe: %s\n", strerror(errno));
+        close(listen_fd);
+        unlink(opts->path);
+        return 1;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(wake[i], F_SETFL, fcntl(wake[i], F_GETFL) | O_NONBLOCK);
+        fcntl(wake[i], F_SETFD, FD_CLOEXEC);
+    }
+    fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+    server_wake_fd = wake[1];
+
+    struct sigaction sa, old_int, old_term;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = server_on_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, &old_int);
+    sigaction(SIGTERM, &sa, &old_term);
+
+    for (int t = 0; t < threads; t++) {
+        if (!spawn_thread(&workers[t], server_worker_main, s)) {
+            threads = t;
+            break;
+        }
+    }
+    s->threads = threads;
+    if (threads == 0) {
+        fprintf(stderr, "Error: cannot start worker threads\n");
+        sigaction(SIGINT, &old_int, NULL);
+        sigaction(SIGTERM, &old_term, NULL);
+        close(wake[0]);
+        close(wake[1]);
+        close(listen_fd);
+        unlink(opts->path);
+        return 1;
+    }
+    printf("Serving on %s with %d worker threads\n", opts->path, threads);
+    fflush(stdout);
+
+    int status = 0;
+    int starved = 0;   // Warned about the current run of accept() failures
+    struct pollfd fds[2] = { { listen_fd, POLLIN, 0 }, { wake[0], POLLIN, 0 } };
+    while (!server_stop) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error: poll failed: %s\n", strerror(errno));
+            status = 1;
+            break;
+        }
+        if (fds[1].revents) break;   // SIGINT or SIGTERM
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK) {
+                continue;            // Interrupted, or a client that went away
+            }
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // Out of descriptors or memory: wait for connections to close instead
+                // of spinning on the pending one, still waking up for a stop
+                if (!starved) fprintf(stderr, "Warning: accept failed: %s\n", strerror(errno));
+                starved = 1;
+                poll(&fds[1], 1, SERVER_ACCEPT_BACKOFF_MS);
+                continue;
+            }
+            fprintf(stderr, "Error: accept failed: %s\n", strerror(errno));
+            status = 1;
+            break;
+        }
+        starved = 0;
+        server_conn_t* conn = calloc(1, sizeof(server_conn_t));
+        server_reader_t* reader = malloc(sizeof(server_reader_t));
+        pthread_t id;
+        if (!conn || !reader) {
+            free(conn);
+            free(reader);
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->refs = 1;
+        conn->server = s;
+        pthread_mutex_init(&conn->lock, NULL);
+        pthread_cond_init(&conn->changed, NULL);
+
+        // The writer owns the connection from here on and unlinks it when it closes
+        pthread_mutex_lock(&s->lock);
+        conn->next = s->conns;
+        if (s->conns) s->conns->prev = conn;
+        s->conns = conn;
+        s->conn_count++;
+        pthread_mutex_unlock(&s->lock);
+        if (!spawn_thread(&id, server_writer_main, conn)) {
+            pthread_mutex_lock(&s->lock);
+            s->conns = conn->next;
+            if (conn->next) conn->next->prev = NULL;
+            s->conn_count--;
+            pthread_mutex_unlock(&s->lock);
+            pthread_cond_destroy(&conn->changed);
+            pthread_mutex_destroy(&conn->lock);
+            free(conn);
+            free(reader);
+            close(fd);
+            continue;
+        }
+        pthread_detach(id);
+
+        reader->server = s;
+        reader->conn = conn;
+        if (!spawn_thread(&id, server_reader_main, reader)) {
+            free(reader);
+            conn_release(conn);
+            continue;
+        }
+        pthread_detach(id);
+    }
+    close(listen_fd);
+    unlink(opts->path);
+
+    // Finish every queued run; readers waiting for room in the ring answer their run
+    // with server_stopping
+    pthread_mutex_lock(&s->lock);
+    s->stopping = 1;
+    pthread_cond_broadcast(&s->not_empty);
+    pthread_cond_broadcast(&s->not_full);
+    pthread_mutex_unlock(&s->lock);
+    for (int t = 0; t < threads; t++) pthread_join(workers[t], NULL);
+
+    // Stop the readers, then give the writers a few seconds to deliver the replies
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += SERVER_DRAIN_SECONDS;
+    pthread_mutex_lock(&s->lock);
+    for (server_conn_t* conn = s->conns; conn; conn = conn->next) shutdown(conn->fd, SHUT_RD);
+    while (s->conn_count > 0) {
+        if (pthread_cond_timedwait(&s->conns_closed, &s->lock, &deadline) == ETIMEDOUT) break;
+    }
+    int unflushed = s->conn_count;
+    pthread_mutex_unlock(&s->lock);
+    if (unflushed > 0) fprintf(stderr, "Warning: %d clients did not take their replies\n", unflushed);
+    printf("Server stopped after %lld runs\n", (long long)s->runs);
+    free(workers);
+    sigaction(SIGINT, &old_int, NULL);
+    sigaction(SIGTERM, &old_term, NULL);
+    close(wake[0]);
+    close(wake[1]);
+    return status;
+}
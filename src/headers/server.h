@@ -0,0 +1,66 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "basic_sched.h"
+
+// Simulation daemon: clients upload workloads once and then send run requests over a
+// Unix domain socket. Workloads are parsed once and cached by a hash of their text.
+// Run requests go to a pool of worker threads that reply with the run's metrics.
+//
+// Protocol: every integer is little-endian, doubles are IEEE 754 bit patterns sent as
+// u64. A request is
+//     u32 length (of the rest), u32 tag, u8 type, body
+// and each reply is
+//     u32 length, u32 tag (the request's), u8 type (the request's), u8 status, body
+// Requests on a connection may be pipelined; runs reply as they finish, so replies
+// can come out of order and tags match them up. A client that leaves replies unread
+// stops being read from until it catches up. On shutdown every queued run is answered.
+//
+// Requests (body -> reply body when the status is server_ok):
+//   SERVER_LOAD  configuration file text -> u64 workload id, u32 processes
+//   SERVER_RUN   u64 workload id, u8 policy (menu number), i32 quantum, u64 seed,
+//                i32 aging threshold, i64 CFS target latency, i64 CFS minimum
+//                granularity, i64 MLFQ top-level quantum, i64 MLFQ boost period,
+//                i64 horizon (65 bytes; zeros select the defaults)
+//                -> u8 run status (completed, horizon reached, stalled), i64 end time,
+//                u32 finished, u32 total, f64 mean waiting, f64 mean turnaround,
+//                f64 mean response, i64 p99 waiting, i64 p99 turnaround,
+//                i64 p99 response, i64 max turnaround, i64 makespan, i64 CPU ticks,
+//                i64 I/O ticks, i64 context switches, f64 throughput,
+//                f64 CPU utilization, f64 I/O utilization (129 bytes)
+//   SERVER_DROP  u64 workload id -> empty
+//   SERVER_INFO  empty -> u32 protocol version, u32 worker threads,
+//                u32 cached workloads, u64 runs served
+
+#define SERVER_PROTOCOL_VERSION 1
+#define SERVER_MAX_REQUEST (16 << 20)   // Larger requests close the connection
+
+typedef enum server_msg_t {
+    SERVER_LOAD = 1,
+    SERVER_RUN = 2,
+    SERVER_DROP = 3,
+    SERVER_INFO = 4
+} server_msg_t;
+
+typedef enum server_status_t {
+    server_ok = 0,
+    server_unknown_workload = 1,   // Never loaded, dropped or evicted: load it again
+    server_bad_request = 2,        // Unknown type, wrong body size or bad parameter
+    server_unavailable = 3,        // Policy not compiled into this build
+    server_no_processes = 4,       // The workload text has no valid process line
+    server_no_memory = 5,
+    server_stopping = 6,           // The server is shutting down and queues no more runs
+    server_bad_workload = 7        // A process line has a priority outside SIM_PRIORITY_MIN..MAX
+} server_status_t;
+
+typedef struct server_options_t {
+    const char* path;          // Socket path (a stale socket there is replaced)
+    int threads;               // Worker threads (<= 0: one per online CPU)
+    int cache_size;            // Cached workloads before the least recently used goes (<= 0: 256)
+} server_options_t;
+
+// Serve until SIGINT or SIGTERM; 0 on a clean stop, 1 when the socket cannot be set up
+// or accepting connections fails for a reason other than running out of descriptors
+int server_run(const server_options_t* opts);
+
+#endif
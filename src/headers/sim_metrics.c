@@ -0,0 +1,157 @@
+#include "sim_metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+void sim_metrics_init(sim_metrics_t* metrics) {
+    name_table_init(&metrics->procs);
+    metrics->stats = NULL;
+    metrics->last_time = NULL;
+    metrics->last_code = NULL;
+    metrics->first_run = NULL;
+    metrics->capacity = 0;
+    metrics->records = 0;
+    metrics->cpu_ticks = 0;
+    metrics->io_ticks = 0;
+    metrics->last_cpu = -1;
+    metrics->context_switches = 0;
+    metrics->error = 0;
+}
+
+void sim_metrics_free(sim_metrics_t* metrics) {
+    name_table_free(&metrics->procs);
+    free(metrics->stats);
+    free(metrics->last_time);
+    free(metrics->last_code);
+    free(metrics->first_run);
+    sim_metrics_init(metrics);
+}
+
+int sim_metrics_reserve(sim_metrics_t* metrics, int proc) {
+    if (proc < metrics->capacity) return 1;
+    int capacity = metrics->capacity ? metrics->capacity * 2 : 64;
+    trace_proc_stats_t* stats = realloc(metrics->stats, capacity * sizeof(trace_proc_stats_t));
+    if (stats) metrics->stats = stats;
+    sim_time_t* last_time = realloc(metrics->last_time, capacity * sizeof(sim_time_t));
+    if (last_time) metrics->last_time = last_time;
+    unsigned char* last_code = realloc(metrics->last_code, capacity);
+    if (last_code) metrics->last_code = last_code;
+    sim_time_t* first_run = realloc(metrics->first_run, capacity * sizeof(sim_time_t));
+    if (first_run) metrics->first_run = first_run;
+    if (!stats || !last_time || !last_code || !first_run) return 0;
+    metrics->capacity = capacity;
+    return 1;
+}
+
+int sim_metrics_record(sim_metrics_t* metrics, const process_descriptor_t* record) {
+    metrics->records++;
+
+    int added = 0;
+    int proc = name_table_id(&metrics->procs, record->process_name, &added);
+    if (proc < 0 || !sim_metrics_reserve(metrics, proc)) {
+        metrics->error = 1;
+        return 1;
+    }
+
+    trace_proc_stats_t* st = &metrics->stats[proc];
+    sim_time_t t = record->date;
+    unsigned char code = (unsigned char)((record->state & 7) | ((record->operation & 3) << 3));
+    int transition;
+    if (added) {
+        st->start_time = st->end_time = t;
+        st->total_wait = 0;
+        st->total_run = 0;
+        metrics->first_run[proc] = -1;
+        transition = 1;
+    } else {
+        if (t > st->end_time) st->end_time = t;
+        if (t == metrics->last_time[proc]) transition = 0;   // Duplicate tick
+        else transition = (t != metrics->last_time[proc] + 1 || code != metrics->last_code[proc]);
+    }
+    if (record->state == running_p && record->operation == calc_p &&
+        (added || t != metrics->last_time[proc])) {
+        metrics->cpu_ticks++;
+        if (metrics->first_run[proc] < 0) metrics->first_run[proc] = t;
+        if (metrics->last_cpu >= 0 && metrics->last_cpu != proc) metrics->context_switches++;
+        metrics->last_cpu = proc;
+    }
+    if (record->state == running_p && record->operation == IO_p &&
+        (added || t != metrics->last_time[proc])) {
+        metrics->io_ticks++;
+    }
+    if (record->state == running_p) st->total_run++;
+    else if (record->state == waiting_p) st->total_wait++;
+
+    metrics->last_time[proc] = t;
+    metrics->last_code[proc] = code;
+    return transition;
+}
+
+void sim_metrics_summarize(const sim_metrics_t* metrics, sim_time_t end_time, sim_metrics_summary_t* summary) {
+    memset(summary, 0, sizeof(*summary));
+    int n = metrics->procs.count;
+    summary->processes = n;
+    if (n == 0) return;
+
+    sim_time_t* responses = malloc(n * sizeof(sim_time_t));
+    sim_time_t* values = malloc(n * sizeof(sim_time_t));
+    int responded = 0;
+    double turnaround = 0, waiting = 0;
+    for (int p = 0; p < n; p++) {
+        const trace_proc_stats_t* st = &metrics->stats[p];
+        if (responses && metrics->first_run[p] >= 0) {
+            responses[responded++] = metrics->first_run[p] - st->start_time;
+        }
+        if (values) values[p] = st->total_wait;
+        sim_time_t span = st->end_time - st->start_time;
+        turnaround += (double)span;
+        waiting += (double)st->total_wait;
+        if (span > summary->max_turnaround) summary->max_turnaround = span;
+        if (st->end_time > summary->makespan) summary->makespan = st->end_time;
+        if ((metrics->last_code[p] & 7) == terminated_p) summary->terminated++;
+    }
+    summary->mean_turnaround = turnaround / n;
+    summary->mean_waiting = waiting / n;
+    if (values) {
+        summary->p99_waiting = sim_percentile99(values, n);
+        for (int p = 0; p < n; p++) values[p] = metrics->stats[p].end_time - metrics->stats[p].start_time;
+        summary->p99_turnaround = sim_percentile99(values, n);
+    }
+    summary->cpu_ticks = metrics->cpu_ticks;
+    summary->io_ticks = metrics->io_ticks;
+    summary->context_switches = metrics->context_switches;
+    sim_summary_finish(summary, end_time, responses, responded);
+    free(responses);
+    free(values);
+}
+
+static int compare_time(const void* a, const void* b) {
+    sim_time_t x = *(const sim_time_t*)a, y = *(const sim_time_t*)b;
+    return (x > y) - (x < y);
+}
+
+sim_time_t sim_percentile99(sim_time_t* values, int count) {
+    if (count <= 0) return 0;
+    // Nearest rank: the smallest value with at least 99% of the values at or below it
+    qsort(values, count, sizeof(sim_time_t), compare_time);
+    int rank = (int)(((int64_t)count * 99 + 99) / 100);
+    return values[rank - 1];
+}
+
+void sim_summary_finish(sim_metrics_summary_t* summary, sim_time_t end_time, sim_time_t* responses, int count) {
+    summary->mean_response = 0;
+    if (count > 0) {
+        double total = 0;
+        for (int i = 0; i < count; i++) total += (double)responses[i];
+        summary->mean_response = total / count;
+    }
+    summary->p99_response = sim_percentile99(responses, count);
+    summary->throughput = 0;
+    summary->utilization = 0;
+    summary->io_utilization = 0;
+    sim_time_t span = (end_time > summary->makespan) ? end_time : summary->makespan;
+    if (span > 0) {
+        summary->throughput = (double)summary->terminated / (double)span;
+        summary->utilization = (double)summary->cpu_ticks / (double)span;
+        summary->io_utilization = (double)summary->io_ticks / (double)span;
+    }
+}
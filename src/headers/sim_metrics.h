@@ -0,0 +1,68 @@
+#ifndef SIM_METRICS_H
+#define SIM_METRICS_H
+
+#include "basic_sched.h"
+#include "name_table.h"
+#include "trace_index.h"
+
+// Per-process statistics accumulated while a run emits its records, so runs that
+// keep no trace (trace_none) still report start, end, waiting and running times.
+// Statistics match trace_index_stats() over the full trace, in the same order.
+typedef struct sim_metrics_t {
+    name_table_t procs;        // Process id -> name, in order of first appearance
+    trace_proc_stats_t* stats;
+    sim_time_t* last_time;     // Time of each process's previous record
+    unsigned char* last_code;  // State and operation of that record
+    sim_time_t* first_run;     // Time of each process's first CPU tick (-1 = none yet)
+    int capacity;
+    int64_t records;           // Records seen (whatever the trace level kept)
+    int64_t cpu_ticks;         // Ticks in which some process ran on the CPU
+    int64_t io_ticks;          // Ticks in which some process ran on the I/O device
+    int last_cpu;              // Process of the latest CPU tick (-1 = none yet)
+    int64_t context_switches;  // CPU ticks of a different process than the one before
+    int error;                 // Out of memory: statistics are incomplete
+} sim_metrics_t;
+
+// Totals over the processes of a run
+typedef struct sim_metrics_summary_t {
+    int processes;
+    int terminated;
+    double mean_turnaround;
+    double mean_waiting;
+    sim_time_t p99_waiting;
+    sim_time_t p99_turnaround;
+    sim_time_t max_turnaround;
+    sim_time_t makespan;       // Latest record time
+    double mean_response;      // First CPU tick - first record, over processes that ran
+    sim_time_t p99_response;
+    int64_t cpu_ticks;
+    int64_t io_ticks;
+    int64_t context_switches;
+    double throughput;         // Terminated processes per tick of the run
+    double utilization;        // Share of the run the CPU was busy
+    double io_utilization;     // Share of the run the I/O device was busy
+} sim_metrics_summary_t;
+
+void sim_metrics_init(sim_metrics_t* metrics);
+void sim_metrics_free(sim_metrics_t* metrics);
+
+// Room for process id proc (grows with the number of processes, never per record);
+// 0 when out of memory
+int sim_metrics_reserve(sim_metrics_t* metrics, int proc);
+
+// Account for one record; returns 1 when it starts a new state of its process
+// (a transition), 0 when it only extends the previous one
+int sim_metrics_record(sim_metrics_t* metrics, const process_descriptor_t* record);
+
+// Rates are taken over the later of the makespan and end_time (the run's end time, 0
+// when unknown): a run cut at the horizon ends after its last record
+void sim_metrics_summarize(const sim_metrics_t* metrics, sim_time_t end_time, sim_metrics_summary_t* summary);
+
+// 99th percentile (nearest rank) of count values, sorted in place; 0 when count is 0
+sim_time_t sim_percentile99(sim_time_t* values, int count);
+
+// Response, throughput and utilizations of a summary whose counts, makespan and
+// tick counts are set; responses (one per process that ran) are sorted in place
+void sim_summary_finish(sim_metrics_summary_t* summary, sim_time_t end_time, sim_time_t* responses, int count);
+
+#endif
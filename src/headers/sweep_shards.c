@@ -0,0 +1,188 @@
+#define _POSIX_C_SOURCE 200809L
+#include "sweep_shards.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define HEADER_SIZE 16
+#define RECORD_SIZE 64
+
+static unsigned char* put_u32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) *p++ = (unsigned char)(v >> (8 * i));
+    return p;
+}
+
+static unsigned char* put_u64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) *p++ = (unsigned char)(v >> (8 * i));
+    return p;
+}
+
+static unsigned char* put_f64(unsigned char* p, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return put_u64(p, bits);
+}
+
+static uint64_t get_bytes(const unsigned char* p, int n) {
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static double get_f64(const unsigned char* p) {
+    uint64_t bits = get_bytes(p, 8);
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+int sweep_results_write(FILE* out, const lane_result_t* results, int count) {
+    unsigned char header[HEADER_SIZE];
+    memcpy(header, SWEEP_RESULTS_MAGIC, 8);
+    put_u32(put_u32(header + 8, SWEEP_RESULTS_VERSION), (uint32_t)count);
+    if (fwrite(header, 1, HEADER_SIZE, out) != HEADER_SIZE) return 0;
+
+    for (int i = 0; i < count; i++) {
+        const lane_result_t* r = &results[i];
+        unsigned char record[RECORD_SIZE];
+        unsigned char* p = record;
+        p = put_u32(p, (uint32_t)r->status);
+        p = put_u32(p, (uint32_t)r->finished);
+        p = put_u32(p, (uint32_t)r->total);
+        p = put_u32(p, (uint32_t)r->summary.processes);
+        p = put_u32(p, (uint32_t)r->summary.terminated);
+        p = put_u32(p, 0);
+        p = put_u64(p, (uint64_t)r->end_time);
+        p = put_f64(p, r->summary.mean_turnaround);
+        p = put_f64(p, r->summary.mean_waiting);
+        p = put_u64(p, (uint64_t)r->summary.max_turnaround);
+        put_u64(p, (uint64_t)r->summary.makespan);
+        if (fwrite(record, 1, RECORD_SIZE, out) != RECORD_SIZE) return 0;
+    }
+    return fflush(out) == 0;
+}
+
+int sweep_results_read(FILE* in, lane_result_t** results, int* count) {
+    unsigned char header[HEADER_SIZE];
+    *results = NULL;
+    *count = 0;
+    if (fread(header, 1, HEADER_SIZE, in) != HEADER_SIZE) return 0;
+    if (memcmp(header, SWEEP_RESULTS_MAGIC, 8) != 0) return 0;
+    if (get_bytes(header + 8, 4) != SWEEP_RESULTS_VERSION) return 0;
+    uint32_t n = (uint32_t)get_bytes(header + 12, 4);
+    if (n > INT32_MAX / RECORD_SIZE) return 0;
+
+    lane_result_t* out = calloc(n > 0 ? n : 1, sizeof(lane_result_t));
+    if (!out) return 0;
+    for (uint32_t i = 0; i < n; i++) {
+        unsigned char record[RECORD_SIZE];
+        if (fread(record, 1, RECORD_SIZE, in) != RECORD_SIZE) {
+            free(out);
+            return 0;
+        }
+        lane_result_t* r = &out[i];
+        r->status = (sim_status_t)get_bytes(record, 4);
+        r->finished = (int)get_bytes(record + 4, 4);
+        r->total = (int)get_bytes(record + 8, 4);
+        r->summary.processes = (int)get_bytes(record + 12, 4);
+        r->summary.terminated = (int)get_bytes(record + 16, 4);
+        r->end_time = (sim_time_t)get_bytes(record + 24, 8);
+        r->summary.mean_turnaround = get_f64(record + 32);
+        r->summary.mean_waiting = get_f64(record + 40);
+        r->summary.max_turnaround = (sim_time_t)get_bytes(record + 48, 8);
+        r->summary.makespan = (sim_time_t)get_bytes(record + 56, 8);
+    }
+    *results = out;
+    *count = (int)n;
+    return 1;
+}
+
+// Append a shell-quoted word to a command line
+static int append_quoted(char** cmd, size_t* len, size_t* cap, const char* word) {
+    size_t need = *len + 4 * strlen(word) + 4;
+    if (need > *cap) {
+        size_t grown_cap = (*cap * 2 > need) ? *cap * 2 : need;
+        char* grown = realloc(*cmd, grown_cap);
+        if (!grown) return 0;
+        *cmd = grown;
+        *cap = grown_cap;
+    }
+    char* p = *cmd + *len;
+    *p++ = ' ';
+    *p++ = '\'';
+    for (const char* c = word; *c; c++) {
+        if (*c == '\'') {
+            memcpy(p, "'\\''", 4);
+            p += 4;
+        } else {
+            *p++ = *c;
+        }
+    }
+    *p++ = '\'';
+    *p = '\0';
+    *len = (size_t)(p - *cmd);
+    return 1;
+}
+
+pid_t sweep_worker_spawn(char* const* argv, const char* launcher, const char* input,
+                         const char* output) {
+    // Build the launcher command before forking, so the child only redirects and execs
+    char* cmd = NULL;
+    if (launcher) {
+        size_t len = strlen(launcher), cap = len + 256;
+        cmd = malloc(cap);
+        if (!cmd) return -1;
+        memcpy(cmd, launcher, len + 1);
+        for (int a = 1; argv[a] != NULL; a++) {
+            if (!append_quoted(&cmd, &len, &cap, argv[a])) {
+                free(cmd);
+                return -1;
+            }
+        }
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int in = open(input, O_RDONLY);
+        int out = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (in < 0 || out < 0 || dup2(in, STDIN_FILENO) < 0 || dup2(out, STDOUT_FILENO) < 0) {
+            _exit(127);
+        }
+        close(in);
+        close(out);
+        if (cmd) execl("/bin/sh", "sh", "-c", cmd, (char*)NULL);
+        else execv(argv[0], argv);
+        _exit(127);
+    }
+    free(cmd);
+    return pid;
+}
+
+int sweep_worker_wait(pid_t pid) {
+    int status;
+    if (waitpid(pid, &status, 0) != pid) return 0;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int sweep_online_cpus(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+void sweep_self_path(char* path, size_t size, const char* argv0) {
+    ssize_t n = readlink("/proc/self/exe", path, size - 1);
+    if (n > 0) {
+        path[n] = '\0';
+        return;
+    }
+    snprintf(path, size, "%s", argv0);
+}
+
+int sweep_temp_dir(char* path, size_t size) {
+    const char* tmp = getenv("TMPDIR");
+    if (!tmp || !*tmp) tmp = "/tmp";
+    if (snprintf(path, size, "%s/scheduler-sweep-XXXXXX", tmp) >= (int)size) return 0;
+    return mkdtemp(path) != NULL;
+}
@@ -0,0 +1,45 @@
+#ifndef SWEEP_SHARDS_H
+#define SWEEP_SHARDS_H
+
+#include <stdio.h>
+#include <sys/types.h>
+#include "batch_lanes.h"
+
+// Sweeps split across worker processes. Each worker is a `scheduler --sweep -
+// --results -` process that reads its shard's workload list on stdin and writes its
+// results to stdout, so it runs the same locally (fork/exec) or behind a launcher
+// command such as ssh. Workers share nothing but these two files.
+//
+// Result files (.res):
+//   header   "PSRESLT1", u32 version, u32 count
+//   records  count x 64 bytes: u32 status, finished, total, processes, terminated,
+//            reserved; i64 end_time; f64 mean_turnaround, mean_waiting;
+//            i64 max_turnaround, makespan
+// Integers and doubles are little-endian.
+
+#define SWEEP_RESULTS_MAGIC "PSRESLT1"
+#define SWEEP_RESULTS_VERSION 1
+#define SWEEP_MAX_LAUNCHERS 64
+
+int sweep_results_write(FILE* out, const lane_result_t* results, int count);   // 0 on write error
+
+// Read a whole result file; *results is malloc'd. 0 when it is not a valid result file.
+int sweep_results_read(FILE* in, lane_result_t** results, int* count);
+
+// Start a worker with stdin from input and stdout to output. argv[0] is the local
+// binary; with a launcher, `sh -c "launcher argv[1] ..."` runs instead (the launcher
+// names the remote binary, e.g. "ssh node1 /opt/bin/scheduler"). -1 on failure.
+pid_t sweep_worker_spawn(char* const* argv, const char* launcher, const char* input,
+                         const char* output);
+
+int sweep_worker_wait(pid_t pid);      // 1 when the worker exited with status 0
+
+int sweep_online_cpus(void);
+
+// Path of the running binary (argv0 when /proc/self/exe is unavailable)
+void sweep_self_path(char* path, size_t size, const char* argv0);
+
+// Fresh private directory for shard files under $TMPDIR or /tmp; 0 on failure
+int sweep_temp_dir(char* path, size_t size);
+
+#endif
@@ -0,0 +1,557 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trace_file.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BLOCK_HEADER_SIZE 32
+#define TRAILER_SIZE 16
+#define ID_GROUP 128           // Id deltas sharing one bit width
+// Worst case of an encoded block: two 10-byte varints, a 32-bit id and a 3-byte code run
+// per record, plus the width byte of every id group
+#define BLOCK_MAX_SIZE (BLOCK_HEADER_SIZE + TRACE_BLOCK_RECORDS * 27 + TRACE_BLOCK_RECORDS / ID_GROUP)
+
+// ---- Little-endian and variable-length integers ----
+
+static unsigned char* put_u32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) *p++ = (unsigned char)(v >> (8 * i));
+    return p;
+}
+
+static unsigned char* put_u64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) *p++ = (unsigned char)(v >> (8 * i));
+    return p;
+}
+
+static unsigned char* put_varint(unsigned char* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+// Bounds-checked input; error is sticky and reads past the end return 0
+typedef struct cursor_t {
+    const unsigned char* pos;
+    const unsigned char* end;
+    int error;
+} cursor_t;
+
+static uint64_t get_bytes(cursor_t* c, int n) {
+    if (c->error || c->end - c->pos < n) {
+        c->error = 1;
+        return 0;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++) v |= (uint64_t)c->pos[i] << (8 * i);
+    c->pos += n;
+    return v;
+}
+
+static uint64_t get_varint(cursor_t* c) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (c->error || c->pos >= c->end) break;
+        unsigned char b = *c->pos++;
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    c->error = 1;
+    return 0;
+}
+
+// ---- Bit packing (LSB first) ----
+
+static unsigned char* pack_bits(unsigned char* p, const uint32_t* values, int count, int width) {
+    uint64_t acc = 0;
+    int bits = 0;
+    for (int i = 0; i < count; i++) {
+        acc |= (uint64_t)values[i] << bits;
+        bits += width;
+        while (bits >= 8) {
+            *p++ = (unsigned char)acc;
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0) *p++ = (unsigned char)acc;
+    return p;
+}
+
+static void unpack_bits(const unsigned char* p, uint32_t* values, int count, int width) {
+    uint64_t acc = 0;
+    int bits = 0;
+    uint32_t mask = (width >= 32) ? 0xffffffffu : ((1u << width) - 1);
+    for (int i = 0; i < count; i++) {
+        while (bits < width) {
+            acc |= (uint64_t)*p++ << bits;
+            bits += 8;
+        }
+        values[i] = (uint32_t)acc & mask;
+        acc >>= width;
+        bits -= width;
+    }
+}
+
+static int bit_width(uint32_t v) {
+    int width = 0;
+    while (v) {
+        width++;
+        v >>= 1;
+    }
+    return width;
+}
+
+// ---- Writer ----
+
+static void emit(trace_writer_t* writer, const void* data, size_t len) {
+    writer_write(&writer->out, data, len);
+    writer->offset += len;
+}
+
+int trace_writer_open(trace_writer_t* writer, const char* path) {
+    memset(writer, 0, sizeof(*writer));
+    name_table_init(&writer->procs);
+    writer->ids = malloc(TRACE_BLOCK_RECORDS * sizeof(int32_t));
+    writer->times = malloc(TRACE_BLOCK_RECORDS * sizeof(sim_time_t));
+    writer->codes = malloc(TRACE_BLOCK_RECORDS);
+    writer->scratch = malloc(BLOCK_MAX_SIZE);
+
+    if (!writer->ids || !writer->times || !writer->codes || !writer->scratch ||
+        !writer_open(&writer->out, path, "wb")) {
+        free(writer->ids);
+        free(writer->times);
+        free(writer->codes);
+        free(writer->scratch);
+        return 0;
+    }
+
+    unsigned char header[16];
+    memcpy(header, TRACE_FILE_MAGIC, 8);
+    put_u32(put_u32(header + 8, TRACE_FILE_VERSION), 0);
+    emit(writer, header, sizeof(header));
+    return 1;
+}
+
+int trace_writer_open_temp(trace_writer_t* writer, char* path, size_t size) {
+    const char* dir = getenv("TMPDIR");
+    if (!dir || dir[0] == '\0') dir = "/tmp";
+    int n = snprintf(path, size, "%s/scheduler-trace-XXXXXX", dir);
+    if (n < 0 || (size_t)n >= size) return 0;
+    int fd = mkstemp(path);
+    if (fd < 0) return 0;
+    close(fd);
+    if (!trace_writer_open(writer, path)) {
+        unlink(path);
+        return 0;
+    }
+    return 1;
+}
+
+static void flush_block(trace_writer_t* writer) {
+    int n = writer->pending;
+    if (n == 0) return;
+
+    if (writer->block_count == writer->blocks_cap) {
+        int cap = writer->blocks_cap ? writer->blocks_cap * 2 : 64;
+        trace_block_info_t* grown = realloc(writer->blocks, cap * sizeof(trace_block_info_t));
+        if (!grown) {
+            writer->out.error = 1;
+            writer->pending = 0;
+            return;
+        }
+        writer->blocks = grown;
+        writer->blocks_cap = cap;
+    }
+
+    sim_time_t min_time = writer->times[0], max_time = writer->times[0];
+    for (int i = 1; i < n; i++) {
+        if (writer->times[i] < min_time) min_time = writer->times[i];
+        if (writer->times[i] > max_time) max_time = writer->times[i];
+    }
+
+    // Time column: runs of equal times (one run per tick in practice)
+    unsigned char* body = writer->scratch + BLOCK_HEADER_SIZE;
+    unsigned char* p = body;
+    sim_time_t prev = min_time;
+    for (int i = 0; i < n;) {
+        int j = i + 1;
+        while (j < n && writer->times[j] == writer->times[i]) j++;
+        p = put_varint(p, zigzag(writer->times[i] - prev));
+        p = put_varint(p, (uint64_t)(j - i));
+        prev = writer->times[i];
+        i = j;
+    }
+    uint32_t time_bytes = (uint32_t)(p - body);
+
+    // Id column: zigzag deltas from the previous record, bit-packed in groups of
+    // ID_GROUP at the width of the group's largest delta. The waiting records of
+    // a tick follow the same process order every tick, so most deltas are tiny.
+    uint32_t deltas[ID_GROUP];
+    int32_t prev_id = 0;
+    for (int g = 0; g < n; g += ID_GROUP) {
+        int count = (n - g < ID_GROUP) ? n - g : ID_GROUP;
+        uint32_t widest = 0;
+        for (int i = 0; i < count; i++) {
+            int32_t id = writer->ids[g + i];
+            deltas[i] = (uint32_t)zigzag((int64_t)id - prev_id);
+            widest |= deltas[i];
+            prev_id = id;
+        }
+        int width = bit_width(widest);
+        *p++ = (unsigned char)width;
+        p = pack_bits(p, deltas, count, width);
+    }
+    uint32_t id_bytes = (uint32_t)(p - body) - time_bytes;
+
+    // Code column: runs of (state | operation << 3), long runs of waiting records
+    for (int i = 0; i < n;) {
+        int j = i + 1;
+        while (j < n && writer->codes[j] == writer->codes[i]) j++;
+        *p++ = writer->codes[i];
+        p = put_varint(p, (uint64_t)(j - i));
+        i = j;
+    }
+    uint32_t payload_bytes = (uint32_t)(p - body);
+
+    unsigned char* h = writer->scratch;
+    h = put_u32(h, (uint32_t)n);
+    h = put_u64(h, (uint64_t)min_time);
+    h = put_u64(h, (uint64_t)max_time);
+    h = put_u32(h, time_bytes);
+    h = put_u32(h, id_bytes);
+    put_u32(h, payload_bytes);
+
+    trace_block_info_t* info = &writer->blocks[writer->block_count++];
+    info->offset = writer->offset;
+    info->count = (uint32_t)n;
+    info->min_time = min_time;
+    info->max_time = max_time;
+
+    emit(writer, writer->scratch, BLOCK_HEADER_SIZE + payload_bytes);
+    writer->pending = 0;
+}
+
+int trace_writer_sink(void* ctx, const process_descriptor_t* record) {
+    trace_writer_t* writer = ctx;
+    int added;
+    int id = name_table_id(&writer->procs, record->process_name, &added);
+    if (id < 0) writer->out.error = 1;
+    if (writer->out.error) return 0;
+
+    writer->ids[writer->pending] = id;
+    writer->times[writer->pending] = record->date;
+    writer->codes[writer->pending] = (uint8_t)((record->state & 7) | ((record->operation & 3) << 3));
+    if (++writer->pending == TRACE_BLOCK_RECORDS) flush_block(writer);
+    return !writer->out.error;
+}
+
+int trace_writer_close(trace_writer_t* writer, const sim_run_t* run) {
+    flush_block(writer);
+
+    uint64_t footer_offset = writer->offset;
+    unsigned char buf[48];
+    unsigned char* p = buf;
+    *p++ = run ? 1 : 0;
+    *p++ = run ? (unsigned char)run->trace_level : trace_full;
+    p = put_u32(p, run ? (uint32_t)run->status : 0);
+    p = put_u64(p, run ? (uint64_t)run->horizon : 0);
+    p = put_u64(p, run ? (uint64_t)run->end_time : 0);
+    p = put_u32(p, run ? (uint32_t)run->finished : 0);
+    p = put_u32(p, run ? (uint32_t)run->total : 0);
+    p = put_u32(p, (uint32_t)writer->procs.count);
+    emit(writer, buf, p - buf);
+
+    for (int i = 0; i < writer->procs.count; i++) {
+        const char* name = writer->procs.names[i];
+        size_t len = strlen(name);
+        p = put_varint(buf, len);
+        emit(writer, buf, p - buf);
+        emit(writer, name, len);
+    }
+
+    p = put_u32(buf, (uint32_t)writer->block_count);
+    emit(writer, buf, p - buf);
+    for (int b = 0; b < writer->block_count; b++) {
+        const trace_block_info_t* info = &writer->blocks[b];
+        p = put_u64(buf, info->offset);
+        p = put_u32(p, info->count);
+        p = put_u64(p, (uint64_t)info->min_time);
+        p = put_u64(p, (uint64_t)info->max_time);
+        emit(writer, buf, p - buf);
+    }
+
+    p = put_u64(buf, footer_offset);
+    memcpy(p, TRACE_FILE_MAGIC, 8);
+    emit(writer, buf, TRAILER_SIZE);
+
+    int ok = writer_close(&writer->out);
+    name_table_free(&writer->procs);
+    free(writer->ids);
+    free(writer->times);
+    free(writer->codes);
+    free(writer->scratch);
+    free(writer->blocks);
+    return ok;
+}
+
+// ---- Reader ----
+
+int trace_reader_open(trace_reader_t* reader, const char* path) {
+    memset(reader, 0, sizeof(*reader));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    // Map the whole file: pages are only read when a block is decoded
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 16 + TRAILER_SIZE) {
+        close(fd);
+        return 0;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+    reader->map = map;
+    reader->map_size = (size_t)st.st_size;
+
+    const unsigned char* trailer = reader->map + reader->map_size - TRAILER_SIZE;
+    cursor_t c = { reader->map + 8, reader->map + 16, 0 };
+    uint32_t version = (uint32_t)get_bytes(&c, 4);
+    c.pos = trailer;
+    c.end = trailer + 8;
+    uint64_t footer_offset = get_bytes(&c, 8);
+    if (memcmp(reader->map, TRACE_FILE_MAGIC, 8) != 0 ||
+        memcmp(trailer + 8, TRACE_FILE_MAGIC, 8) != 0 ||
+        version != TRACE_FILE_VERSION ||
+        footer_offset < 16 || footer_offset > reader->map_size - TRAILER_SIZE) {
+        trace_reader_close(reader);
+        return 0;
+    }
+
+    c.pos = reader->map + footer_offset;
+    c.end = trailer;
+    size_t footer_size = (size_t)(c.end - c.pos);
+    sim_run_init(&reader->run, 0);
+    get_bytes(&c, 1);   // Run outcome present (zeroes otherwise)
+    reader->run.trace_level = (sim_trace_level_t)get_bytes(&c, 1);
+    reader->run.status = (sim_status_t)get_bytes(&c, 4);
+    reader->run.horizon = (sim_time_t)get_bytes(&c, 8);
+    reader->run.end_time = (sim_time_t)get_bytes(&c, 8);
+    reader->run.finished = (int)get_bytes(&c, 4);
+    reader->run.total = (int)get_bytes(&c, 4);
+
+    uint32_t proc_count = (uint32_t)get_bytes(&c, 4);
+    if (!c.error && proc_count <= footer_size) {
+        reader->proc_names = calloc(proc_count ? proc_count : 1, sizeof(char*));
+        if (!reader->proc_names) c.error = 1;
+        for (uint32_t i = 0; i < proc_count && !c.error; i++) {
+            uint64_t len = get_varint(&c);
+            if (c.error || len > (uint64_t)(c.end - c.pos)) {
+                c.error = 1;
+                break;
+            }
+            char* name = malloc(len + 1);
+            if (!name) {
+                c.error = 1;
+                break;
+            }
+            memcpy(name, c.pos, len);
+            name[len] = '\0';
+            c.pos += len;
+            reader->proc_names[reader->proc_count++] = name;
+        }
+    } else {
+        c.error = 1;
+    }
+
+    uint32_t block_count = (uint32_t)get_bytes(&c, 4);
+    if (!c.error && block_count <= footer_size / 28) {
+        reader->blocks = malloc((block_count ? block_count : 1) * sizeof(trace_block_info_t));
+        reader->block_first = malloc((block_count + 1) * sizeof(int64_t));
+        if (!reader->blocks || !reader->block_first) c.error = 1;
+        for (uint32_t b = 0; b < block_count && !c.error; b++) {
+            trace_block_info_t* info = &reader->blocks[b];
+            info->offset = get_bytes(&c, 8);
+            info->count = (uint32_t)get_bytes(&c, 4);
+            info->min_time = (sim_time_t)get_bytes(&c, 8);
+            info->max_time = (sim_time_t)get_bytes(&c, 8);
+            if (info->count > TRACE_BLOCK_RECORDS ||
+                info->offset > footer_offset - BLOCK_HEADER_SIZE) c.error = 1;
+            reader->block_first[b] = reader->record_count;
+            reader->record_count += info->count;
+            reader->block_count++;
+        }
+        if (!c.error) reader->block_first[block_count] = reader->record_count;
+    } else {
+        c.error = 1;
+    }
+
+    for (int k = 0; k < TRACE_READER_CACHE && !c.error; k++) {
+        reader->cache[k].block = -1;
+        reader->cache[k].records = malloc(TRACE_BLOCK_RECORDS * sizeof(process_descriptor_t));
+        if (!reader->cache[k].records) c.error = 1;
+    }
+    if (c.error) {
+        trace_reader_close(reader);
+        return 0;
+    }
+    return 1;
+}
+
+void trace_reader_close(trace_reader_t* reader) {
+    if (reader->map) munmap((void*)reader->map, reader->map_size);
+    for (int i = 0; i < reader->proc_count; i++) free(reader->proc_names[i]);
+    free(reader->proc_names);
+    free(reader->blocks);
+    free(reader->block_first);
+    for (int k = 0; k < TRACE_READER_CACHE; k++) free(reader->cache[k].records);
+    memset(reader, 0, sizeof(*reader));
+}
+
+int trace_reader_seek(const trace_reader_t* reader, sim_time_t t) {
+    // Blocks are written in time order, so their max times are nondecreasing
+    int lo = 0, hi = reader->block_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (reader->blocks[mid].max_time < t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int trace_reader_block(const trace_reader_t* reader, int block, process_descriptor_t* out) {
+    if (block < 0 || block >= reader->block_count) return 0;
+    const trace_block_info_t* info = &reader->blocks[block];
+
+    const unsigned char* buf = reader->map + info->offset;
+    size_t room = reader->map_size - TRAILER_SIZE - info->offset - BLOCK_HEADER_SIZE;
+    cursor_t c = { buf, buf + BLOCK_HEADER_SIZE, 0 };
+    int n = (int)get_bytes(&c, 4);
+    sim_time_t min_time = (sim_time_t)get_bytes(&c, 8);
+    get_bytes(&c, 8);
+    uint32_t time_bytes = (uint32_t)get_bytes(&c, 4);
+    uint32_t id_bytes = (uint32_t)get_bytes(&c, 4);
+    uint32_t payload_bytes = (uint32_t)get_bytes(&c, 4);
+
+    if (n != (int)info->count || payload_bytes > room ||
+        (uint64_t)time_bytes + id_bytes > payload_bytes) {
+        return 0;
+    }
+    buf += BLOCK_HEADER_SIZE;
+
+    // Times
+    c.pos = buf;
+    c.end = buf + time_bytes;
+    sim_time_t t = min_time;
+    for (int i = 0; i < n;) {
+        t += unzigzag(get_varint(&c));
+        uint64_t run = get_varint(&c);
+        if (c.error || run == 0 || run > (uint64_t)(n - i)) return 0;
+        for (uint64_t k = 0; k < run; k++) out[i++].date = t;
+    }
+
+    // Ids
+    const unsigned char* p = buf + time_bytes;
+    const unsigned char* end = p + id_bytes;
+    uint32_t deltas[ID_GROUP];
+    int64_t id = 0;
+    for (int g = 0; g < n; g += ID_GROUP) {
+        int count = (n - g < ID_GROUP) ? n - g : ID_GROUP;
+        if (p >= end) return 0;
+        int width = *p++;
+        if (width > 32 || end - p < (ptrdiff_t)(((size_t)count * width + 7) / 8)) return 0;
+        unpack_bits(p, deltas, count, width);
+        p += ((size_t)count * width + 7) / 8;
+        for (int i = 0; i < count; i++) {
+            id += unzigzag(deltas[i]);
+            if (id < 0 || id >= reader->proc_count) return 0;
+            out[g + i].process_name = reader->proc_names[id];
+        }
+    }
+
+    // Codes
+    c.pos = end;
+    c.end = buf + payload_bytes;
+    for (int i = 0; i < n;) {
+        uint64_t code = get_bytes(&c, 1);
+        uint64_t run = get_varint(&c);
+        if (c.error || run == 0 || run > (uint64_t)(n - i)) return 0;
+        for (uint64_t k = 0; k < run; k++, i++) {
+            out[i].state = (process_state)(code & 7);
+            out[i].operation = (process_operation_t)(code >> 3);
+        }
+    }
+    return 1;
+}
+
+int trace_reader_read_all(trace_reader_t* reader, process_descriptor_t** descriptor, int* size) {
+    *descriptor = NULL;
+    *size = 0;
+    if (reader->record_count > INT32_MAX) return -1;
+
+    int total = (int)reader->record_count;
+    process_descriptor_t* records = malloc((total ? total : 1) * sizeof(process_descriptor_t));
+    if (!records) return -1;
+
+    int at = 0;
+    for (int b = 0; b < reader->block_count; b++) {
+        if (!trace_reader_block(reader, b, records + at)) {
+            free(records);
+            return -1;
+        }
+        at += reader->blocks[b].count;
+    }
+    *descriptor = records;
+    *size = total;
+    return total;
+}
+
+// Decoded block holding pos, from the cache (least recently used entry replaced)
+const process_descriptor_t* trace_reader_record(trace_reader_t* reader, int64_t pos) {
+    if (pos < 0 || pos >= reader->record_count) return NULL;
+
+    trace_block_cache_t* hit = &reader->cache[reader->last];
+    if (hit->block < 0 || pos < reader->block_first[hit->block] ||
+        pos >= reader->block_first[hit->block + 1]) {
+        int lo = 0, hi = reader->block_count - 1;
+        while (lo < hi) {
+            int mid = lo + (hi - lo + 1) / 2;
+            if (reader->block_first[mid] <= pos) lo = mid;
+            else hi = mid - 1;
+        }
+
+        int victim = 0;
+        hit = NULL;
+        for (int k = 0; k < TRACE_READER_CACHE; k++) {
+            if (reader->cache[k].block == lo) {
+                hit = &reader->cache[k];
+                break;
+            }
+            if (reader->cache[k].used < reader->cache[victim].used) victim = k;
+        }
+        if (!hit) {
+            hit = &reader->cache[victim];
+            hit->block = -1;
+            if (!trace_reader_block(reader, lo, hit->records)) return NULL;
+            hit->block = lo;
+        }
+        reader->last = (int)(hit - reader->cache);
+    }
+    hit->used = ++reader->clock;
+    return &hit->records[pos - reader->block_first[hit->block]];
+}
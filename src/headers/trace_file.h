@@ -0,0 +1,102 @@
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include "basic_sched.h"
+#include "buffered_writer.h"
+#include "name_table.h"
+
+// Compact binary trace files (.trace)
+//
+//   header   "PSTRACE1", u32 version, u32 reserved
+//   blocks   up to TRACE_BLOCK_RECORDS records each, stored column by column:
+//              times  runs of (zigzag varint delta, varint count), from the block's min time
+//              ids    zigzag deltas between consecutive process ids, bit-packed in
+//                     groups of 128 (one width byte per group)
+//              codes  runs of (state | operation << 3, varint count)
+//   footer   run outcome and trace level, process names (in id order), block directory
+//   trailer  u64 footer offset, "PSTRACE1"
+//
+// Integers are little-endian. Each block carries its min/max time, so a reader
+// finds the blocks covering a time window from the directory alone.
+
+#define TRACE_FILE_MAGIC "PSTRACE1"
+#define TRACE_FILE_VERSION 1
+#define TRACE_BLOCK_RECORDS 4096
+
+// Directory entry of one block
+typedef struct trace_block_info_t {
+    uint64_t offset;           // File offset of the block header
+    uint32_t count;            // Records in the block
+    sim_time_t min_time;
+    sim_time_t max_time;
+} trace_block_info_t;
+
+// Streaming writer, usable as a sim_sink_t: holds one block of records at a time
+typedef struct trace_writer_t {
+    buffered_writer_t out;
+    uint64_t offset;           // Bytes written so far
+    name_table_t procs;
+    int32_t* ids;              // Pending block, column by column
+    sim_time_t* times;
+    uint8_t* codes;
+    int pending;
+    unsigned char* scratch;    // Encoded block
+    trace_block_info_t* blocks;
+    int block_count;
+    int blocks_cap;
+} trace_writer_t;
+
+int trace_writer_open(trace_writer_t* writer, const char* path);
+
+// Same into a new file in $TMPDIR (default /tmp), whose name goes to path (size bytes);
+// the caller removes the file, which readers can do as soon as they have mapped it
+int trace_writer_open_temp(trace_writer_t* writer, char* path, size_t size);
+
+// Writes the last block and the footer (run may be NULL); 0 when any write failed
+int trace_writer_close(trace_writer_t* writer, const sim_run_t* run);
+
+// sim_sink_t adapter (ctx = trace_writer_t); returns 0 once the output failed
+int trace_writer_sink(void* ctx, const process_descriptor_t* record);
+
+#define TRACE_READER_CACHE 8   // Decoded blocks kept by trace_reader_record()
+
+typedef struct trace_block_cache_t {
+    int block;                 // -1 = empty
+    uint64_t used;             // Last use (LRU)
+    process_descriptor_t* records;
+} trace_block_cache_t;
+
+// Reader: maps the file, decodes blocks on request
+typedef struct trace_reader_t {
+    const unsigned char* map;
+    size_t map_size;
+    sim_run_t run;             // Outcome and trace level recorded by the writer
+    int proc_count;
+    char** proc_names;
+    trace_block_info_t* blocks;
+    int block_count;
+    int64_t* block_first;      // Trace position of the first record of every block (+ total)
+    int64_t record_count;
+    trace_block_cache_t cache[TRACE_READER_CACHE];
+    int last;                  // Cache entry of the previous lookup
+    uint64_t clock;
+} trace_reader_t;
+
+int trace_reader_open(trace_reader_t* reader, const char* path);   // 0 when not a valid trace
+void trace_reader_close(trace_reader_t* reader);
+
+// First block whose max time is >= t (block_count when none)
+int trace_reader_seek(const trace_reader_t* reader, sim_time_t t);
+
+// Decode one block into out (blocks[block].count records). Names point into the
+// reader, which must stay open while they are used. Returns 0 on a corrupt block.
+int trace_reader_block(const trace_reader_t* reader, int block, process_descriptor_t* out);
+
+// Record at a trace position, decoding its block into the cache when needed.
+// Valid until TRACE_READER_CACHE other blocks are accessed; NULL on error.
+const process_descriptor_t* trace_reader_record(trace_reader_t* reader, int64_t pos);
+
+// Decode the whole trace into a descriptor array; returns the record count, -1 on error
+int trace_reader_read_all(trace_reader_t* reader, process_descriptor_t** descriptor, int* size);
+
+#endif
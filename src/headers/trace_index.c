@@ -0,0 +1,381 @@
+#include "trace_index.h"
+#include <string.h>
+
+trace_cell_t trace_cell_of(const process_descriptor_t* record) {
+    switch (record->state) {
+        case running_p: return (record->operation == calc_p) ? cell_calc : cell_io;
+        case waiting_p: return cell_wait;
+        case terminated_p: return cell_term;
+        default: return cell_empty;
+    }
+}
+
+void trace_source_array(trace_source_t* source, const process_descriptor_t* descriptor, int size) {
+    source->descriptor = descriptor;
+    source->packed = NULL;
+    source->reader = NULL;
+    source->size = size;
+    source->transitions = 0;
+}
+
+void trace_source_packed(trace_source_t* source, const packed_trace_t* trace) {
+    source->descriptor = NULL;
+    source->packed = trace;
+    source->reader = NULL;
+    source->size = trace->size;
+    source->transitions = 0;
+}
+
+int trace_source_file(trace_source_t* source, trace_reader_t* reader) {
+    if (reader->record_count > INT32_MAX) return 0;
+    source->descriptor = NULL;
+    source->packed = NULL;
+    source->reader = reader;
+    source->size = (int)reader->record_count;
+    source->transitions = (reader->run.trace_level == trace_transitions);
+    return 1;
+}
+
+int trace_source_get(const trace_source_t* source, int pos, process_descriptor_t* out) {
+    if (source->descriptor) {
+        *out = source->descriptor[pos];
+        return 1;
+    }
+    if (source->packed) {
+        packed_trace_get(source->packed, pos, out);
+        return 1;
+    }
+    const process_descriptor_t* record = trace_reader_record(source->reader, pos);
+    if (!record) return 0;
+    *out = *record;
+    return 1;
+}
+
+static unsigned hash_name(const char* name) {
+    unsigned h = 2166136261u;   // FNV-1a
+    for (; *name; name++) {
+        h ^= (unsigned char)*name;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+int trace_index_find(const trace_index_t* index, const char* name) {
+    if (index->hash_cap == 0) return -1;
+    unsigned mask = (unsigned)index->hash_cap - 1;
+    for (unsigned slot = hash_name(name) & mask;; slot = (slot + 1) & mask) {
+        int p = index->hash_slots[slot];
+        if (p < 0) return -1;
+        if (index->proc_names[p] == name || strcmp(index->proc_names[p], name) == 0) return p;
+    }
+}
+
+static void hash_insert(trace_index_t* index, int proc) {
+    unsigned mask = (unsigned)index->hash_cap - 1;
+    unsigned slot = hash_name(index->proc_names[proc]) & mask;
+    while (index->hash_slots[slot] >= 0) slot = (slot + 1) & mask;
+    index->hash_slots[slot] = proc;
+}
+
+// Add a process, growing the name table and the hash table (load factor <= 1/2);
+// -1 when out of memory
+static int add_process(trace_index_t* index, const char* name, int* names_cap) {
+    if (index->proc_count == *names_cap) {
+        int cap = *names_cap ? *names_cap * 2 : 64;
+        const char** names = realloc(index->proc_names, cap * sizeof(char*));
+        if (!names) return -1;
+        index->proc_names = names;
+        *names_cap = cap;
+    }
+    int proc = index->proc_count++;
+    index->proc_names[proc] = name;
+
+    if (index->proc_count * 2 > index->hash_cap) {
+        int cap = index->hash_cap ? index->hash_cap * 2 : 128;
+        int* slots = malloc(cap * sizeof(int));
+        if (!slots) return -1;
+        free(index->hash_slots);
+        index->hash_slots = slots;
+        index->hash_cap = cap;
+        for (int i = 0; i < index->hash_cap; i++) index->hash_slots[i] = -1;
+        for (int p = 0; p < index->proc_count; p++) hash_insert(index, p);
+    } else {
+        hash_insert(index, proc);
+    }
+    return proc;
+}
+
+static int compare_span(const void* a, const void* b) {
+    sim_time_t ta = ((const trace_span_t*)a)->start;
+    sim_time_t tb = ((const trace_span_t*)b)->start;
+    return (ta > tb) - (ta < tb);
+}
+
+// Release a partly built index and the build's scratch arrays
+static int build_failed(trace_index_t* index, void* last_time, void* last_cell, void* unsorted,
+                        void* fill) {
+    free(last_time);
+    free(last_cell);
+    free(unsorted);
+    free(fill);
+    trace_index_free(index);
+    return -1;
+}
+
+int trace_index_build(trace_index_t* index, const trace_source_t* source) {
+    int size = source->size;
+    memset(index, 0, sizeof(*index));
+    index->record_count = size;
+    index->record_proc = malloc((size > 0 ? size : 1) * sizeof(int));
+    index->record_cell = malloc(size > 0 ? size : 1);
+    if (!index->record_proc || !index->record_cell) return build_failed(index, NULL, NULL, NULL, NULL);
+
+    // Pass 1: map records to processes (consecutive records often share a name)
+    int names_cap = 0;
+    const char* last_name = NULL;
+    int last_proc = -1;
+    for (int i = 0; i < size; i++) {
+        process_descriptor_t d;
+        if (!trace_source_get(source, i, &d)) {
+            size = index->record_count = i;   // Corrupt trace file: index what was read
+            break;
+        }
+        int proc;
+        if (source->packed) {
+            // Packed ids are already dense in order of first appearance
+            proc = trace_record_proc(source->packed->records[i]);
+            if (proc == index->proc_count && add_process(index, d.process_name, &names_cap) < 0) {
+                return build_failed(index, NULL, NULL, NULL, NULL);
+            }
+        } else {
+            proc = (d.process_name == last_name) ? last_proc : trace_index_find(index, d.process_name);
+            if (proc < 0) proc = add_process(index, d.process_name, &names_cap);
+            if (proc < 0) return build_failed(index, NULL, NULL, NULL, NULL);
+            last_name = d.process_name;
+            last_proc = proc;
+        }
+        index->record_proc[i] = proc;
+        index->record_cell[i] = (unsigned char)trace_cell_of(&d);
+        if (d.date > index->max_time) index->max_time = d.date;
+    }
+
+    // Pass 2: count spans per process (records of a process are in time order)
+    int n = index->proc_count;
+    sim_time_t* last_time = malloc((n > 0 ? n : 1) * sizeof(sim_time_t));
+    trace_cell_t* last_cell = malloc((n > 0 ? n : 1) * sizeof(trace_cell_t));
+    int* unsorted = calloc(n > 0 ? n : 1, sizeof(int));
+    int* fill = malloc((n > 0 ? n : 1) * sizeof(int));
+    index->span_offset = calloc(n + 1, sizeof(int));
+    if (!last_time || !last_cell || !unsorted || !fill || !index->span_offset) {
+        return build_failed(index, last_time, last_cell, unsorted, fill);
+    }
+    for (int p = 0; p < n; p++) {
+        last_time[p] = -2;
+        last_cell[p] = cell_empty;
+    }
+    for (int i = 0; i < size; i++) {
+        int p = index->record_proc[i];
+        process_descriptor_t d;
+        trace_source_get(source, i, &d);
+        sim_time_t t = d.date;
+        trace_cell_t cell = trace_cell_of(&d);
+        if (t == last_time[p]) continue;   // Duplicate tick: first record wins
+        if (t < last_time[p]) unsorted[p] = 1;
+        if (t != last_time[p] + 1 || cell != last_cell[p] || source->transitions) index->span_offset[p + 1]++;
+        last_time[p] = t;
+        last_cell[p] = cell;
+    }
+    for (int p = 0; p < n; p++) index->span_offset[p + 1] += index->span_offset[p];
+
+    // Pass 3: fill spans
+    int total = index->span_offset[n];
+    index->spans = malloc((total > 0 ? total : 1) * sizeof(trace_span_t));
+    if (!index->spans) return build_failed(index, last_time, last_cell, unsorted, fill);
+    for (int p = 0; p < n; p++) {
+        fill[p] = index->span_offset[p] - 1;
+        last_time[p] = -2;
+        last_cell[p] = cell_empty;
+    }
+    for (int i = 0; i < size; i++) {
+        int p = index->record_proc[i];
+        process_descriptor_t d;
+        trace_source_get(source, i, &d);
+        sim_time_t t = d.date;
+        trace_cell_t cell = trace_cell_of(&d);
+        if (t == last_time[p]) continue;
+        if (source->transitions && fill[p] >= index->span_offset[p]) {
+            index->spans[fill[p]].end = t;   // The previous state lasted until now
+        }
+        if (t != last_time[p] + 1 || cell != last_cell[p] || source->transitions) {
+            trace_span_t* span = &index->spans[++fill[p]];
+            span->start = t;
+            span->cell = cell;
+        }
+        index->spans[fill[p]].end = t + 1;
+        last_time[p] = t;
+        last_cell[p] = cell;
+    }
+
+    // Trace positions of every process (counting sort on record_proc)
+    index->record_offset = calloc(n + 1, sizeof(int));
+    index->records = malloc((size > 0 ? size : 1) * sizeof(int));
+    if (!index->record_offset || !index->records) {
+        return build_failed(index, last_time, last_cell, unsorted, fill);
+    }
+    for (int i = 0; i < size; i++) index->record_offset[index->record_proc[i] + 1]++;
+    for (int p = 0; p < n; p++) {
+        index->record_offset[p + 1] += index->record_offset[p];
+        fill[p] = index->record_offset[p];
+    }
+    for (int i = 0; i < size; i++) index->records[fill[index->record_proc[i]]++] = i;
+
+    // Cell counts before every block, in trace order and in grouped order
+    int blocks = (size + TRACE_INDEX_BLOCK - 1) / TRACE_INDEX_BLOCK;
+    index->block_count = blocks;
+    index->cell_counts = calloc((size_t)(blocks + 1) * cell_count, sizeof(int));
+    index->grouped_counts = calloc((size_t)(blocks + 1) * cell_count, sizeof(int));
+    if (!index->cell_counts || !index->grouped_counts) {
+        return build_failed(index, last_time, last_cell, unsorted, fill);
+    }
+    for (int b = 0; b < blocks; b++) {
+        int* next = &index->cell_counts[(b + 1) * cell_count];
+        int* grouped_next = &index->grouped_counts[(b + 1) * cell_count];
+        memcpy(next, next - cell_count, cell_count * sizeof(int));
+        memcpy(grouped_next, grouped_next - cell_count, cell_count * sizeof(int));
+        int end = (b + 1) * TRACE_INDEX_BLOCK < size ? (b + 1) * TRACE_INDEX_BLOCK : size;
+        for (int i = b * TRACE_INDEX_BLOCK; i < end; i++) {
+            next[index->record_cell[i]]++;
+            grouped_next[index->record_cell[index->records[i]]]++;
+        }
+    }
+
+    // Out-of-order processes (not produced by the schedulers) get their spans sorted
+    for (int p = 0; p < n; p++) {
+        if (unsorted[p]) {
+            qsort(&index->spans[index->span_offset[p]],
+                  index->span_offset[p + 1] - index->span_offset[p],
+                  sizeof(trace_span_t), compare_span);
+        }
+    }
+
+    free(last_time);
+    free(last_cell);
+    free(unsorted);
+    free(fill);
+    return n;
+}
+
+void trace_index_free(trace_index_t* index) {
+    free(index->proc_names);
+    free(index->span_offset);
+    free(index->spans);
+    free(index->record_proc);
+    free(index->record_offset);
+    free(index->records);
+    free(index->record_cell);
+    free(index->cell_counts);
+    free(index->grouped_counts);
+    free(index->hash_slots);
+    memset(index, 0, sizeof(*index));
+}
+
+trace_proc_stats_t* trace_index_stats(const trace_index_t* index, const trace_source_t* source) {
+    trace_proc_stats_t* stats = calloc(index->proc_count > 0 ? index->proc_count : 1, sizeof(trace_proc_stats_t));
+    if (!stats) return NULL;
+
+    for (int p = 0; p < index->proc_count; p++) {
+        stats[p].start_time = -1;
+    }
+
+    // A transitions trace has one record per state change: measure the spans instead
+    if (source->transitions) {
+        for (int p = 0; p < index->proc_count; p++) {
+            trace_proc_stats_t* st = &stats[p];
+            for (int s = index->span_offset[p]; s < index->span_offset[p + 1]; s++) {
+                const trace_span_t* span = &index->spans[s];
+                if (st->start_time < 0) st->start_time = span->start;
+                if (span->end - 1 > st->end_time) st->end_time = span->end - 1;
+                if (span->cell == cell_calc || span->cell == cell_io) st->total_run += span->end - span->start;
+                else if (span->cell == cell_wait) st->total_wait += span->end - span->start;
+            }
+        }
+        return stats;
+    }
+
+    for (int i = 0; i < index->record_count; i++) {
+        trace_proc_stats_t* st = &stats[index->record_proc[i]];
+        process_descriptor_t d;
+        if (!trace_source_get(source, i, &d)) break;
+        sim_time_t t = d.date;
+        if (st->start_time < 0) st->start_time = st->end_time = t;
+        if (t > st->end_time) st->end_time = t;
+        if (d.state == running_p) st->total_run++;
+        else if (d.state == waiting_p) st->total_wait++;
+    }
+    return stats;
+}
+
+int trace_index_seek(const trace_index_t* index, int proc, sim_time_t t) {
+    int lo = index->span_offset[proc];
+    int hi = index->span_offset[proc + 1];
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (index->spans[mid].end <= t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+trace_cell_t trace_index_cell(const trace_index_t* index, int proc, sim_time_t t) {
+    if (proc < 0 || proc >= index->proc_count) return cell_empty;
+    int s = trace_index_seek(index, proc, t);
+    if (s < index->span_offset[proc + 1] && index->spans[s].start <= t) return index->spans[s].cell;
+    return cell_empty;
+}
+
+void trace_index_row(const trace_index_t* index, int proc, sim_time_t from, int count,
+                     trace_cell_t* cells) {
+    for (int c = 0; c < count; c++) cells[c] = cell_empty;
+    if (proc < 0 || proc >= index->proc_count) return;
+
+    int end = index->span_offset[proc + 1];
+    for (int s = trace_index_seek(index, proc, from); s < end; s++) {
+        const trace_span_t* span = &index->spans[s];
+        if (span->start >= from + count) break;
+        sim_time_t a = (span->start > from) ? span->start : from;
+        sim_time_t b = (span->end < from + count) ? span->end : from + count;
+        for (sim_time_t t = a; t < b; t++) cells[t - from] = span->cell;
+    }
+}
+
+static int entry_cell(const trace_index_t* index, int grouped, int entry) {
+    return index->record_cell[grouped ? index->records[entry] : entry];
+}
+
+int trace_index_cell_rank(const trace_index_t* index, int grouped, trace_cell_t cell, int pos) {
+    if (pos <= 0) return 0;
+    if (pos > index->record_count) pos = index->record_count;
+    const int* counts = grouped ? index->grouped_counts : index->cell_counts;
+    int b = pos / TRACE_INDEX_BLOCK;
+    int rank = counts[b * cell_count + cell];
+    for (int i = b * TRACE_INDEX_BLOCK; i < pos; i++) rank += (entry_cell(index, grouped, i) == (int)cell);
+    return rank;
+}
+
+int trace_index_cell_select(const trace_index_t* index, int grouped, trace_cell_t cell, int k) {
+    const int* counts = grouped ? index->grouped_counts : index->cell_counts;
+    if (k < 0 || k >= counts[index->block_count * cell_count + cell]) return -1;
+
+    // Last block with fewer than k + 1 such records before it
+    int lo = 0, hi = index->block_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (counts[mid * cell_count + cell] <= k) lo = mid;
+        else hi = mid - 1;
+    }
+    int left = k - counts[lo * cell_count + cell];
+    for (int i = lo * TRACE_INDEX_BLOCK; i < index->record_count; i++) {
+        if (entry_cell(index, grouped, i) == (int)cell && left-- == 0) return i;
+    }
+    return -1;
+}
@@ -0,0 +1,105 @@
+#ifndef TRACE_INDEX_H
+#define TRACE_INDEX_H
+
+#include "basic_sched.h"
+#include "trace_file.h"
+#include "packed_trace.h"
+
+// What a process is doing at one tick, as drawn by the Gantt views
+typedef enum trace_cell_t {
+    cell_empty = 0,   // Not arrived yet / already gone
+    cell_calc,
+    cell_io,
+    cell_wait,
+    cell_term,
+    cell_count
+} trace_cell_t;
+
+#define TRACE_INDEX_BLOCK 64   // Entries per block of the cell counts
+
+// A trace to read: the descriptor array of a run, the packed in-memory trace, or a
+// trace file whose blocks are decoded on demand (replays never materialize the trace)
+typedef struct trace_source_t {
+    const process_descriptor_t* descriptor;
+    const packed_trace_t* packed;
+    trace_reader_t* reader;    // Used when both others are NULL
+    int size;
+    int transitions;           // Records are state changes only (trace_transitions)
+} trace_source_t;
+
+void trace_source_array(trace_source_t* source, const process_descriptor_t* descriptor, int size);
+void trace_source_packed(trace_source_t* source, const packed_trace_t* trace);
+int trace_source_file(trace_source_t* source, trace_reader_t* reader);   // 0 when too large
+
+// Copy of the record at a trace position; 0 on error (corrupt trace file)
+int trace_source_get(const trace_source_t* source, int pos, process_descriptor_t* out);
+
+// Consecutive ticks of one process in the same cell: [start, end)
+typedef struct trace_span_t {
+    sim_time_t start;
+    sim_time_t end;
+    trace_cell_t cell;
+} trace_span_t;
+
+// Built once after a run: per-process sorted span lists (CSR layout) and a
+// name -> process hash table, so renderers query cells in O(log spans).
+// In a transitions trace every record's span lasts until the process's next record.
+// Cell counts per block of TRACE_INDEX_BLOCK entries, over the trace and over the
+// records grouped by process, let a state filter rank and find rows in O(log n).
+typedef struct trace_index_t {
+    int proc_count;
+    const char** proc_names;   // Processes in order of first appearance
+    int* span_offset;          // Spans of process p: spans[span_offset[p] .. span_offset[p+1])
+    trace_span_t* spans;
+    int* record_proc;          // Process of every trace record
+    int record_count;
+    int* record_offset;        // Records of process p: records[record_offset[p] .. record_offset[p+1])
+    int* records;              // Trace positions grouped by process, in trace order
+    unsigned char* record_cell;    // Cell of every trace record
+    int* cell_counts;          // [b * cell_count + c]: records of cell c in trace blocks before b
+    int* grouped_counts;       // The same over records[] (grouped by process)
+    int block_count;
+    sim_time_t max_time;
+    int* hash_slots;           // Open addressing, -1 = free
+    int hash_cap;
+} trace_index_t;
+
+// Per-process summary of a trace, in index process order
+typedef struct trace_proc_stats_t {
+    sim_time_t start_time;     // First record
+    sim_time_t end_time;       // Last record
+    sim_time_t total_wait;     // Ticks spent waiting
+    sim_time_t total_run;      // Ticks on the CPU or the I/O device
+} trace_proc_stats_t;
+
+trace_cell_t trace_cell_of(const process_descriptor_t* record);
+
+// Index a trace; the number of processes, or -1 when out of memory (the index is then
+// left empty, and trace_index_free() on it is harmless)
+int trace_index_build(trace_index_t* index, const trace_source_t* source);
+void trace_index_free(trace_index_t* index);
+
+// Statistics of every indexed process (caller frees), NULL when out of memory
+trace_proc_stats_t* trace_index_stats(const trace_index_t* index, const trace_source_t* source);
+
+// Process number of a name, -1 if it never appears in the trace
+int trace_index_find(const trace_index_t* index, const char* name);
+
+// First span of process proc ending after tick t (binary search)
+int trace_index_seek(const trace_index_t* index, int proc, sim_time_t t);
+
+// Cell of process proc at tick t
+trace_cell_t trace_index_cell(const trace_index_t* index, int proc, sim_time_t t);
+
+// Cells of process proc for ticks [from, from + count) in one binary search
+void trace_index_row(const trace_index_t* index, int proc, sim_time_t from, int count,
+                     trace_cell_t* cells);
+
+// Records of a cell among the first pos entries of a sequence: the trace, or with
+// grouped set index->records (a process's records are a slice of it)
+int trace_index_cell_rank(const trace_index_t* index, int grouped, trace_cell_t cell, int pos);
+
+// Entry of the k-th record (from 0) of a cell in that sequence, -1 when there are fewer
+int trace_index_cell_select(const trace_index_t* index, int grouped, trace_cell_t cell, int k);
+
+#endif
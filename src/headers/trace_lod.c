@@ -0,0 +1,135 @@
+#include "trace_lod.h"
+#include <string.h>
+
+sim_time_t trace_lod_columns(const trace_lod_t* lod, int level) {
+    return (lod->index->max_time >> level) + 1;
+}
+
+static void lod_add(trace_lod_cell_t* cell, trace_cell_t what, uint32_t ticks) {
+    switch (what) {
+        case cell_calc: cell->calc += ticks; break;
+        case cell_io: cell->io += ticks; break;
+        case cell_wait: cell->wait += ticks; break;
+        case cell_term: cell->term += ticks; break;
+        default: break;
+    }
+}
+
+// Sum the spans of proc into columns [from, from + count) of a level
+static void lod_from_spans(const trace_index_t* index, int proc, int level, sim_time_t from,
+                           int count, trace_lod_cell_t* out) {
+    sim_time_t t_from = from << level;
+    sim_time_t t_to = (from + count) << level;
+    int end = index->span_offset[proc + 1];
+
+    for (int s = trace_index_seek(index, proc, t_from); s < end; s++) {
+        const trace_span_t* span = &index->spans[s];
+        if (span->start >= t_to) break;
+        sim_time_t a = (span->start > t_from) ? span->start : t_from;
+        sim_time_t b = (span->end < t_to) ? span->end : t_to;
+        while (a < b) {
+            sim_time_t col = a >> level;
+            sim_time_t col_end = (col + 1) << level;
+            if (col_end > b) col_end = b;
+            lod_add(&out[col - from], span->cell, (uint32_t)(col_end - a));
+            a = col_end;
+        }
+    }
+}
+
+int trace_lod_build(trace_lod_t* lod, const trace_index_t* index, size_t budget_bytes) {
+    memset(lod, 0, sizeof(*lod));
+    lod->index = index;
+    while ((index->max_time >> lod->top_level) > 0) lod->top_level++;
+
+    // Finest level whose pyramid (levels base..top) fits the budget
+    int n = index->proc_count;
+    size_t total = 0;
+    lod->base_level = lod->top_level + 1;
+    for (int k = lod->top_level; k >= 0; k--) {
+        size_t cells = (size_t)n * (size_t)trace_lod_columns(lod, k);
+        if ((total + cells) * sizeof(trace_lod_cell_t) > budget_bytes) break;
+        total += cells;
+        lod->base_level = k;
+    }
+    if (lod->base_level > lod->top_level || n == 0) {
+        lod->base_level = lod->top_level + 1;
+        return 0;
+    }
+
+    int levels = lod->top_level - lod->base_level + 1;
+    lod->level_offset = malloc(levels * sizeof(size_t));
+    lod->cells = calloc(total, sizeof(trace_lod_cell_t));
+    if (!lod->level_offset || !lod->cells) {
+        free(lod->level_offset);
+        free(lod->cells);
+        lod->level_offset = NULL;
+        lod->cells = NULL;
+        lod->base_level = lod->top_level + 1;
+        return 0;
+    }
+
+    size_t offset = 0;
+    for (int k = lod->base_level; k <= lod->top_level; k++) {
+        lod->level_offset[k - lod->base_level] = offset;
+        offset += (size_t)n * (size_t)trace_lod_columns(lod, k);
+    }
+
+    // Base level from the spans, every coarser level by summing column pairs
+    sim_time_t base_cols = trace_lod_columns(lod, lod->base_level);
+    for (int p = 0; p < n; p++) {
+        lod_from_spans(index, p, lod->base_level, 0, (int)base_cols,
+                       &lod->cells[(size_t)p * base_cols]);
+    }
+    for (int k = lod->base_level + 1; k <= lod->top_level; k++) {
+        sim_time_t cols = trace_lod_columns(lod, k);
+        sim_time_t fine_cols = trace_lod_columns(lod, k - 1);
+        for (int p = 0; p < n; p++) {
+            trace_lod_cell_t* dst = &lod->cells[lod->level_offset[k - lod->base_level] + (size_t)p * cols];
+            const trace_lod_cell_t* src = &lod->cells[lod->level_offset[k - 1 - lod->base_level] + (size_t)p * fine_cols];
+            for (sim_time_t c = 0; c < cols; c++) {
+                dst[c] = src[2 * c];
+                if (2 * c + 1 < fine_cols) {
+                    dst[c].calc += src[2 * c + 1].calc;
+                    dst[c].io += src[2 * c + 1].io;
+                    dst[c].wait += src[2 * c + 1].wait;
+                    dst[c].term += src[2 * c + 1].term;
+                }
+            }
+        }
+    }
+    return levels;
+}
+
+void trace_lod_free(trace_lod_t* lod) {
+    free(lod->level_offset);
+    free(lod->cells);
+    memset(lod, 0, sizeof(*lod));
+}
+
+void trace_lod_row(const trace_lod_t* lod, int proc, int level, sim_time_t from, int count,
+                   trace_lod_cell_t* out) {
+    memset(out, 0, count * sizeof(trace_lod_cell_t));
+    if (proc < 0 || proc >= lod->index->proc_count || from < 0) return;
+
+    if (level < lod->base_level) {
+        lod_from_spans(lod->index, proc, level, from, count, out);
+        return;
+    }
+
+    sim_time_t cols = trace_lod_columns(lod, level);
+    if (from >= cols) return;
+    if (from + count > cols) count = (int)(cols - from);
+    memcpy(out, &lod->cells[lod->level_offset[level - lod->base_level] + (size_t)proc * cols + from],
+           count * sizeof(trace_lod_cell_t));
+}
+
+trace_cell_t trace_lod_dominant(const trace_lod_cell_t* cell) {
+    trace_cell_t best = cell_empty;
+    uint32_t most = 0;
+    if (cell->calc > most) { best = cell_calc; most = cell->calc; }
+    if (cell->io > most) { best = cell_io; most = cell->io; }
+    if (cell->wait > most) { best = cell_wait; most = cell->wait; }
+    if (cell->term > most) { best = cell_term; most = cell->term; }
+    return best;
+}
@@ -0,0 +1,39 @@
+#ifndef TRACE_LOD_H
+#define TRACE_LOD_H
+
+#include <stddef.h>
+#include "trace_index.h"
+
+// Ticks spent in each cell over a group of 2^level ticks
+typedef struct trace_lod_cell_t {
+    uint32_t calc;
+    uint32_t io;
+    uint32_t wait;
+    uint32_t term;
+} trace_lod_cell_t;
+
+// Mip-map pyramid over a trace index: level k summarizes 2^k ticks per column.
+// Levels [base_level, top_level] are precomputed; finer levels (too large for the
+// memory budget) are summed from the index spans on demand.
+typedef struct trace_lod_t {
+    const trace_index_t* index;
+    int base_level;            // First stored level (top_level + 1 when none fits)
+    int top_level;             // Level where the whole trace is one column
+    size_t* level_offset;      // Start of each stored level in cells
+    trace_lod_cell_t* cells;   // Level k, process p: cells[level_offset[k - base] + p * columns]
+} trace_lod_t;
+
+int trace_lod_build(trace_lod_t* lod, const trace_index_t* index, size_t budget_bytes);
+void trace_lod_free(trace_lod_t* lod);
+
+// Number of columns of a level
+sim_time_t trace_lod_columns(const trace_lod_t* lod, int level);
+
+// Summaries of process proc for columns [from, from + count) of a level
+void trace_lod_row(const trace_lod_t* lod, int proc, int level, sim_time_t from, int count,
+                   trace_lod_cell_t* out);
+
+// Cell holding most ticks of a summary (cell_empty when nothing happened)
+trace_cell_t trace_lod_dominant(const trace_lod_cell_t* cell);
+
+#endif
@@ -0,0 +1,258 @@
+#include "tuner.h"
+#include <pthread.h>
+#include <string.h>
+
+#define TUNE_POINTS_1D 9   // Grid points of a round for a single parameter
+#define TUNE_POINTS_2D 5   // Grid points per parameter for two (25 candidates)
+
+void tune_space_default(tune_target_t target, tune_space_t* space) {
+    memset(space, 0, sizeof(*space));
+    if (target == tune_mlfq) {
+        space->dims = 2;
+        space->lo[0] = 1;
+        space->hi[0] = 32;
+        space->lo[1] = 8;
+        space->hi[1] = 512;
+    } else {
+        space->dims = 1;
+        space->lo[0] = 1;
+        space->hi[0] = 64;
+    }
+}
+
+const char* tune_param_name(tune_target_t target, int param) {
+    switch (target) {
+        case tune_round_robin: return "quantum";
+        case tune_aging: return "aging threshold";
+        case tune_mlfq: return (param == 0) ? "top quantum" : "boost period";
+        default: return "parameter";
+    }
+}
+
+// Objective of one candidate on one workload; *incomplete is set when the run did not finish
+static double tune_evaluate(tune_target_t target, const int* params, tune_objective_t objective,
+                            process_queue* queue, sim_time_t horizon, int* incomplete) {
+    sim_run_t run;
+    sim_run_init(&run, horizon);
+    sim_metrics_t metrics;
+    sim_metrics_init(&metrics);
+    run.trace_level = trace_none;
+    run.metrics = &metrics;
+
+    switch (target) {
+        case tune_round_robin:
+            round_robin_sched(queue, NULL, NULL, params[0], &run);
+            break;
+        case tune_aging: {
+            aging_params_t aging = {params[0]};
+            multilevel_rr_aging_sched(queue, NULL, NULL, &aging, &run);
+            break;
+        }
+        case tune_mlfq: {
+            mlfq_params_t mlfq;
+            memset(&mlfq, 0, sizeof(mlfq));
+            mlfq.quanta[0] = params[0];         // Lower levels double it
+            mlfq.boost_period = params[1];
+            mlfq_sched(queue, NULL, NULL, &mlfq, &run);
+            break;
+        }
+    }
+
+    sim_metrics_summary_t summary;
+    sim_metrics_summarize(&metrics, run.end_time, &summary);
+    *incomplete = (run.status != sim_completed || metrics.error);
+    sim_metrics_free(&metrics);
+    switch (objective) {
+        case objective_p99_response: return (double)summary.p99_response;
+        case objective_switches: return (double)summary.context_switches;
+        default: return summary.mean_waiting;
+    }
+}
+
+// Runs of one round: value [c * count + w] is candidate c on workload w
+typedef struct tune_round_t {
+    tune_target_t target;
+    tune_objective_t objective;
+    process_queue* const* workloads;
+    int count;
+    sim_time_t horizon;
+    const tune_candidate_t* candidates;
+    int candidate_count;
+    double* values;
+    int* incomplete;
+} tune_round_t;
+
+typedef struct tune_worker_t {
+    const tune_round_t* round;
+    int index;
+    int threads;
+} tune_worker_t;
+
+static void* tune_worker_main(void* arg) {
+    tune_worker_t* w = arg;
+    const tune_round_t* r = w->round;
+    int64_t items = (int64_t)r->candidate_count * r->count;
+    for (int64_t item = w->index; item < items; item += w->threads) {
+        const tune_candidate_t* c = &r->candidates[item / r->count];
+        r->values[item] = tune_evaluate(r->target, c->params, r->objective,
+                                        r->workloads[item % r->count], r->horizon,
+                                        &r->incomplete[item]);
+    }
+    return NULL;
+}
+
+// Evaluate candidates[0..n) over every workload and fill their scores
+static int tune_round(tune_round_t* r, tune_candidate_t* candidates, int n, int threads) {
+    size_t items = (size_t)n * (size_t)r->count;
+    r->candidates = candidates;
+    r->candidate_count = n;
+    r->values = malloc(items * sizeof(double));
+    r->incomplete = malloc(items * sizeof(int));
+    tune_worker_t* workers = calloc(threads, sizeof(tune_worker_t));
+    pthread_t* ids = calloc(threads, sizeof(pthread_t));
+    int* started = calloc(threads, sizeof(int));
+    int ok = (r->values && r->incomplete && workers && ids && started);
+
+    if (ok) {
+        for (int t = 0; t < threads; t++) {
+            workers[t].round = r;
+            workers[t].index = t;
+            workers[t].threads = threads;
+        }
+        for (int t = 1; t < threads; t++) {
+            started[t] = (pthread_create(&ids[t], NULL, tune_worker_main, &workers[t]) == 0);
+            if (!started[t]) tune_worker_main(&workers[t]);   // Run its share here instead
+        }
+        tune_worker_main(&workers[0]);
+        for (int t = 1; t < threads; t++) {
+            if (started[t]) pthread_join(ids[t], NULL);
+        }
+
+        // Sum in workload order, so scores do not depend on the thread count
+        for (int c = 0; c < n; c++) {
+            double total = 0;
+            int incomplete = 0;
+            for (int w = 0; w < r->count; w++) {
+                total += r->values[(size_t)c * r->count + w];
+                incomplete += r->incomplete[(size_t)c * r->count + w];
+            }
+            candidates[c].score = (r->count > 0) ? total / r->count : 0;
+            candidates[c].incomplete = incomplete;
+        }
+    }
+    free(r->values);
+    free(r->incomplete);
+    free(workers);
+    free(ids);
+    free(started);
+    return ok;
+}
+
+// Fewer incomplete runs first, then lower score, then smaller parameters
+static int compare_candidates(const void* a, const void* b) {
+    const tune_candidate_t* x = a;
+    const tune_candidate_t* y = b;
+    if (x->incomplete != y->incomplete) return (x->incomplete < y->incomplete) ? -1 : 1;
+    if (x->score != y->score) return (x->score < y->score) ? -1 : 1;
+    for (int d = 0; d < TUNE_MAX_PARAMS; d++) {
+        if (x->params[d] != y->params[d]) return (x->params[d] < y->params[d]) ? -1 : 1;
+    }
+    return 0;
+}
+
+static int tune_seen(const tune_result_t* result, const int* params) {
+    for (int i = 0; i < result->count; i++) {
+        if (memcmp(result->candidates[i].params, params, sizeof(result->candidates[i].params)) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int tune_run(tune_target_t target, const tune_space_t* space, tune_objective_t objective,
+             process_queue* const* workloads, int count, sim_time_t horizon, int threads,
+             tune_result_t* result) {
+    memset(result, 0, sizeof(*result));
+    if (threads < 1) threads = 1;
+    int dims = space->dims;
+    int points = (dims == 1) ? TUNE_POINTS_1D : TUNE_POINTS_2D;
+    int lo[TUNE_MAX_PARAMS] = {0}, hi[TUNE_MAX_PARAMS] = {0};
+    for (int d = 0; d < dims; d++) {
+        lo[d] = space->lo[d];
+        hi[d] = space->hi[d];
+    }
+
+    tune_round_t round;
+    memset(&round, 0, sizeof(round));
+    round.target = target;
+    round.objective = objective;
+    round.workloads = workloads;
+    round.count = count;
+    round.horizon = horizon;
+
+    int capacity = 0;
+    for (;;) {
+        // Grid of this round: lo, lo + step, ... and hi for every parameter
+        int step[TUNE_MAX_PARAMS] = {1, 1};
+        int grid[TUNE_MAX_PARAMS][TUNE_POINTS_1D];
+        int grid_size[TUNE_MAX_PARAMS] = {1, 1};
+        int fine = 1;
+        for (int d = 0; d < dims; d++) {
+            step[d] = (hi[d] - lo[d] + points - 2) / (points - 1);
+            if (step[d] < 1) step[d] = 1;
+            if (step[d] > 1) fine = 0;
+            grid_size[d] = 0;
+            for (int v = lo[d]; v < hi[d]; v += step[d]) grid[d][grid_size[d]++] = v;
+            grid[d][grid_size[d]++] = hi[d];
+        }
+
+        // New candidates only: earlier rounds' scores are kept
+        int first = result->count;
+        int needed = first + grid_size[0] * grid_size[1];
+        if (needed > capacity) {
+            capacity = needed * 2;
+            tune_candidate_t* grown = realloc(result->candidates, capacity * sizeof(tune_candidate_t));
+            if (!grown) {
+                tune_result_free(result);
+                return 0;
+            }
+            result->candidates = grown;
+        }
+        for (int i = 0; i < grid_size[0]; i++) {
+            for (int j = 0; j < grid_size[1]; j++) {
+                tune_candidate_t c;
+                memset(&c, 0, sizeof(c));
+                c.params[0] = grid[0][i];
+                if (dims > 1) c.params[1] = grid[1][j];
+                if (!tune_seen(result, c.params)) result->candidates[result->count++] = c;
+            }
+        }
+        if (!tune_round(&round, result->candidates + first, result->count - first, threads)) {
+            tune_result_free(result);
+            return 0;
+        }
+        result->rounds++;
+
+        const tune_candidate_t* best = &result->candidates[0];
+        for (int i = 1; i < result->count; i++) {
+            if (compare_candidates(&result->candidates[i], best) < 0) best = &result->candidates[i];
+        }
+        if (fine) break;
+
+        // Next round: one coarse step either side of the best candidate
+        for (int d = 0; d < dims; d++) {
+            lo[d] = best->params[d] - step[d];
+            hi[d] = best->params[d] + step[d];
+            if (lo[d] < space->lo[d]) lo[d] = space->lo[d];
+            if (hi[d] > space->hi[d]) hi[d] = space->hi[d];
+        }
+    }
+
+    qsort(result->candidates, result->count, sizeof(tune_candidate_t), compare_candidates);
+    return 1;
+}
+
+void tune_result_free(tune_result_t* result) {
+    free(result->candidates);
+    memset(result, 0, sizeof(*result));
+}
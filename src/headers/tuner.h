@@ -0,0 +1,54 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "basic_sched.h"
+#include "sim_metrics.h"
+
+// Parameter search for the tunable policies: a coarse grid over the parameter
+// ranges, then finer grids around the best candidate until the step is one tick.
+// Every candidate runs over the same workloads (statistics only), and the
+// candidate x workload runs of a round are spread over threads.
+
+typedef enum tune_target_t {
+    tune_round_robin,          // quantum
+    tune_aging,                // aging threshold of Multi-level + Aging
+    tune_mlfq                  // top-level quantum, boost period
+} tune_target_t;
+
+typedef enum tune_objective_t {
+    objective_waiting,         // Mean waiting time
+    objective_p99_response,    // 99th percentile response time
+    objective_switches         // Context switches
+} tune_objective_t;
+
+#define TUNE_MAX_PARAMS 2
+
+// Inclusive range of each parameter
+typedef struct tune_space_t {
+    int dims;
+    int lo[TUNE_MAX_PARAMS];
+    int hi[TUNE_MAX_PARAMS];
+} tune_space_t;
+
+typedef struct tune_candidate_t {
+    int params[TUNE_MAX_PARAMS];
+    double score;              // Objective averaged over the workloads (lower is better)
+    int incomplete;            // Runs that stalled or reached the horizon
+} tune_candidate_t;
+
+typedef struct tune_result_t {
+    tune_candidate_t* candidates;  // Every evaluated candidate, best first (malloc'd)
+    int count;
+    int rounds;
+} tune_result_t;
+
+void tune_space_default(tune_target_t target, tune_space_t* space);
+const char* tune_param_name(tune_target_t target, int param);
+
+// Search space for target; 0 when out of memory. Deterministic for any thread count.
+int tune_run(tune_target_t target, const tune_space_t* space, tune_objective_t objective,
+             process_queue* const* workloads, int count, sim_time_t horizon, int threads,
+             tune_result_t* result);
+void tune_result_free(tune_result_t* result);
+
+#endif
@@ -1,13 +1,962 @@
 #include "headers/basic_sched.h"
 #include "headers/config_parser.h"
 #include "headers/ncurses_display.h"
+#include "headers/event_ring.h"
+#include "headers/chrome_trace.h"
+#include "headers/trace_file.h"
+#include "headers/packed_trace.h"
+#include "headers/display.h"
+#include "headers/batch_lanes.h"
+#include "headers/sweep_shards.h"
+#include "headers/experiment.h"
+#include "headers/tuner.h"
+#include "headers/compare.h"
+#include "headers/policy.h"
+#include "headers/server.h"
+#include "headers/checkpoint.h"
 #include <string.h>
+#include <pthread.h>
+
+#define LIVE_RING_CAPACITY 4096   // Trace records buffered between simulation and animation
+
+// A policy choice with the parameters collected from the user
+typedef struct sim_job_t {
+    int choice;
+    process_queue* queue;
+    policy_params_t params;
+} sim_job_t;
+
+static void run_policy(const sim_job_t* job, process_descriptor_t** descriptor, int* size, sim_run_t* run) {
+    policy_run(job->choice, &job->params, job->queue, descriptor, size, run);
+}
+
+// Non-interactive options (--algo and friends)
+typedef struct batch_options_t {
+    int choice;                // Policy number as in the menu, 0 = interactive
+    int quantum;
+    uint64_t seed;
+    sim_time_t horizon;
+    const char* chrome_path;   // --export-chrome
+    const char* trace_path;    // --export-trace
+    sim_trace_level_t trace_level;   // --trace, for --export-trace
+    const char* sweep_path;    // --sweep: file listing one workload per line
+    int no_lanes;              // --no-lanes: sweep one workload at a time
+    const char* results_path;  // --results: write sweep results in binary ("-" = stdout)
+    int fanout;                // --workers given: shard the sweep across processes
+    int workers;               // Worker processes (0 = one per online CPU)
+    const char* launchers[SWEEP_MAX_LAUNCHERS];   // --launcher: remote worker commands
+    int launcher_count;
+    const char* experiment_path;   // --experiment: workload distribution spec
+    int64_t runs;              // --runs: workloads per experiment
+    int threads;               // --threads (0 = one per online CPU)
+    int algos[POLICY_COUNT];   // --algos: policies of an experiment (none = all available)
+    int algo_count;
+    int aging_threshold;       // --aging-threshold, for --algo 5 (0 = default)
+    int mlfq_quantum;          // --mlfq-quantum: top-level quantum of --algo 10 (0 = default)
+    sim_time_t mlfq_boost;     // --mlfq-boost: boost period of --algo 10 (0 = default)
+    int tune_choice;           // --tune: policy whose parameters are searched
+    tune_objective_t objective;    // --objective
+    int tune_lo, tune_hi;      // --tune-range of the first parameter (0 = default)
+    int compare;               // --compare: every policy on the configuration file
+    const char* serve_path;    // --serve: run the simulation daemon on this socket
+    int cache_size;            // --cache: workloads the daemon keeps parsed (0 = default)
+    const char* checkpoint_path;   // --checkpoint: snapshot written when the run stops early
+    const char* resume_path;   // --resume: continue the run saved in this snapshot
+} batch_options_t;
+
+// Job for a non-interactive run of a policy, with the parameters of the command line
+static void batch_job(const batch_options_t* opts, int choice, process_queue* queue, sim_job_t* job) {
+    memset(job, 0, sizeof(*job));
+    job->choice = choice;
+    job->queue = queue;
+    job->params.quantum = (opts->quantum > 0) ? opts->quantum : 2;
+    job->params.seed = (opts->seed != 0) ? opts->seed : 1;
+    job->params.aging.threshold = opts->aging_threshold;
+    job->params.mlfq.quanta[0] = opts->mlfq_quantum;
+    job->params.mlfq.boost_period = opts->mlfq_boost;
+}
+
+static int parse_trace_level(const char* name, sim_trace_level_t* level) {
+    if (strcmp(name, "full") == 0) *level = trace_full;
+    else if (strcmp(name, "transitions") == 0) *level = trace_transitions;
+    else if (strcmp(name, "none") == 0) *level = trace_none;
+    else return 0;
+    return 1;
+}
+
+static const char* status_name(sim_status_t status) {
+    switch (status) {
+        case sim_completed: return "completed";
+        case sim_horizon_reached: return "horizon reached";
+        case sim_stalled: return "stalled";
+        case sim_cancelled: return "cancelled";
+        case sim_resume_rejected: return "not resumed";
+        default: return "unknown";
+    }
+}
+
+// Run one policy without the menu: stream the trace to the exporters, or print statistics
+static int run_batch(process_queue* queue, const batch_options_t* opts) {
+    if (!policy_available(opts->choice)) {
+        fprintf(stderr, "Error: policy %d is not available in this build\n", opts->choice);
+        return 1;
+    }
+
+    if ((opts->checkpoint_path || opts->resume_path) && opts->choice > checkpoint_aging) {
+        fprintf(stderr, "Error: policy %d does not support checkpoints (policies 1-%d do)\n",
+                opts->choice, checkpoint_aging);
+        return 1;
+    }
+
+    sim_job_t job;
+    batch_job(opts, opts->choice, queue, &job);
+
+    sim_run_t run;
+    sim_run_init(&run, opts->horizon);
+
+    // The snapshot read is only consulted; the one written is separate, so a run may
+    // resume from and checkpoint to the same file
+    sim_checkpoint_t resume, checkpoint;
+    checkpoint_init(&resume);
+    checkpoint_init(&checkpoint);
+    if (opts->resume_path) {
+        if (!checkpoint_read(&resume, opts->resume_path) ||
+            !checkpoint_compatible(&resume, opts->choice, queue)) {
+            checkpoint_free(&resume);
+            return 1;
+        }
+        run.resume = &resume;
+    }
+    if (opts->checkpoint_path) run.checkpoint = &checkpoint;
+
+    // Snapshots carry the statistics so far, so split runs report the whole run
+    sim_metrics_t metrics;
+    sim_metrics_init(&metrics);
+    if (run.resume || run.checkpoint) run.metrics = &metrics;
+    // Deadline misses need the termination time of every process
+    for (node_t* cur = queue->head; cur && !run.metrics; cur = cur->next) {
+        if (cur->proc.deadline > 0) run.metrics = &metrics;
+    }
+    int rc = 0;
+
+    if (opts->chrome_path) {
+        chrome_trace_t trace;
+        if (!chrome_trace_open(&trace, opts->chrome_path)) {
+            fprintf(stderr, "Error: cannot open %s\n", opts->chrome_path);
+            checkpoint_free(&resume);
+            return 1;
+        }
+        run.sink = chrome_trace_sink;
+        run.sink_ctx = &trace;
+        run_policy(&job, NULL, NULL, &run);
+        if (!chrome_trace_close(&trace)) {
+            fprintf(stderr, "Error: failed to write %s\n", opts->chrome_path);
+            rc = 1;
+        }
+    } else if (opts->trace_path) {
+        // Transition detection needs each process's previous state
+        run.trace_level = opts->trace_level;
+        if (run.trace_level == trace_transitions) run.metrics = &metrics;
+
+        trace_writer_t writer;
+        if (!trace_writer_open(&writer, opts->trace_path)) {
+            fprintf(stderr, "Error: cannot open %s\n", opts->trace_path);
+            checkpoint_free(&resume);
+            return 1;
+        }
+        run.sink = trace_writer_sink;
+        run.sink_ctx = &writer;
+        run_policy(&job, NULL, NULL, &run);
+        if (!trace_writer_close(&writer, &run)) {
+            fprintf(stderr, "Error: failed to write %s\n", opts->trace_path);
+            rc = 1;
+        }
+    } else {
+        // Statistics only: no trace is kept at all
+        run.trace_level = trace_none;
+        run.metrics = &metrics;
+        run_policy(&job, NULL, NULL, &run);
+        print_metrics(&metrics);
+    }
+    if (rc == 0 && run.status == sim_resume_rejected) {
+        fprintf(stderr, "Error: %s does not fit policy %d and this workload\n",
+                opts->resume_path, opts->choice);
+        rc = 1;
+    }
+    if (rc == 0 && run.metrics) {
+        deadline_report_t deadlines;
+        if (compute_deadline_report_metrics(queue, &metrics, run.end_time, &deadlines) > 0) {
+            print_deadline_report(&deadlines);
+        }
+        free_deadline_report(&deadlines);
+    }
+    sim_metrics_free(&metrics);
+    checkpoint_free(&resume);
+
+    if (rc == 0 && opts->checkpoint_path) {
+        if (run.status != sim_horizon_reached && run.status != sim_cancelled) {
+            printf("Run %s: no checkpoint needed\n", status_name(run.status));
+        } else if (checkpoint.policy == 0) {
+            fprintf(stderr, "Error: out of memory while taking the checkpoint\n");
+            rc = 1;
+        } else if (!checkpoint_write(&checkpoint, opts->checkpoint_path)) {
+            fprintf(stderr, "Error: failed to write %s\n", opts->checkpoint_path);
+            rc = 1;
+        } else {
+            printf("Checkpoint written to %s\n", opts->checkpoint_path);
+        }
+    }
+    checkpoint_free(&checkpoint);
+    if (rc != 0) return rc;
+
+    printf("Run %s at time %lld: %d / %d processes finished\n",
+           status_name(run.status), (long long)run.end_time, run.finished, run.total);
+    return 0;
+}
+
+static void free_paths(char** paths, int count) {
+    for (int i = 0; i < count; i++) free(paths[i]);
+    free(paths);
+}
+
+// Workload paths of a sweep list, one per line ('#' starts a comment); "-" reads stdin.
+// NULL on error (an empty list gives a non-NULL array and *count = 0).
+static char** load_sweep_list(const char* path, int* count) {
+    FILE* list = (strcmp(path, "-") == 0) ? stdin : fopen(path, "r");
+    if (!list) {
+        fprintf(stderr, "Error: cannot open %s\n", path);
+        return NULL;
+    }
+    char** paths = malloc(64 * sizeof(char*));
+    int cap = 64;
+    *count = 0;
+    char line[1024];
+    while (paths && fgets(line, sizeof(line), list)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+        if (*count == cap) {
+            cap *= 2;
+            char** grown = realloc(paths, cap * sizeof(char*));
+            if (!grown) {
+                free_paths(paths, *count);
+                paths = NULL;
+                break;
+            }
+            paths = grown;
+        }
+        paths[*count] = malloc(strlen(line) + 1);
+        if (!paths[*count]) {
+            free_paths(paths, *count);
+            paths = NULL;
+            break;
+        }
+        strcpy(paths[*count], line);
+        (*count)++;
+    }
+    if (list != stdin) fclose(list);
+    if (!paths) fprintf(stderr, "Error: out of memory\n");
+    return paths;
+}
+
+// One line of totals per workload, then the sweep as a whole
+static void print_sweep(char* const* paths, const lane_result_t* results, int count) {
+    int completed = 0;
+    double waiting = 0, turnaround = 0;
+    sim_time_t makespan = 0;
+    for (int i = 0; i < count; i++) {
+        const lane_result_t* r = &results[i];
+        printf("%s: %s at %lld, %d / %d finished, avg turnaround %.2f, avg waiting %.2f, makespan %lld\n",
+               paths[i], status_name(r->status), (long long)r->end_time, r->finished, r->total,
+               r->summary.mean_turnaround, r->summary.mean_waiting, (long long)r->summary.makespan);
+        if (r->status == sim_completed) completed++;
+        waiting += r->summary.mean_waiting;
+        turnaround += r->summary.mean_turnaround;
+        if (r->summary.makespan > makespan) makespan = r->summary.makespan;
+    }
+    if (count > 0) {
+        printf("Swept %d workloads: %d completed, mean avg turnaround %.2f, mean avg waiting %.2f, max makespan %lld\n",
+               count, completed, turnaround / count, waiting / count, (long long)makespan);
+    }
+}
+
+// Run one policy over every workload listed in a file and print one line of totals
+// per workload (or write them as a result file for a coordinator). FIFO and round
+// robin advance BATCH_LANES workloads in lockstep.
+static int run_sweep(const batch_options_t* opts) {
+    if (!policy_available(opts->choice)) {
+        fprintf(stderr, "Error: policy %d is not available in this build\n", opts->choice);
+        return 1;
+    }
+    int count = 0, rc = 0;
+    char** paths = load_sweep_list(opts->sweep_path, &count);
+    if (!paths) return 1;
+
+    // Load every workload up front
+    process_queue* queues = calloc(count > 0 ? count : 1, sizeof(process_queue));
+    lane_result_t* results = calloc(count > 0 ? count : 1, sizeof(lane_result_t));
+    int loaded = 0;
+    if (!queues || !results) {
+        fprintf(stderr, "Error: out of memory\n");
+        rc = 1;
+    }
+    for (; rc == 0 && loaded < count; loaded++) {
+        if (parse_config_file_quiet(paths[loaded], &queues[loaded]) <= 0) {
+            fprintf(stderr, "Error: failed to load %s\n", paths[loaded]);
+            workload_free(&queues[loaded]);
+            rc = 1;
+        }
+    }
+
+    if (rc == 0) {
+        int lanes = !opts->no_lanes && (opts->choice == 1 || opts->choice == 2);
+        if (lanes) {
+            process_queue** workloads = malloc(count * sizeof(process_queue*));
+            if (workloads) {
+                for (int i = 0; i < count; i++) workloads[i] = &queues[i];
+                int quantum = (opts->quantum > 0) ? opts->quantum : 2;
+                lanes = batch_lanes_run(workloads, count,
+                                        (opts->choice == 1) ? lane_fifo : lane_round_robin,
+                                        quantum, opts->horizon, results);
+                free(workloads);
+            } else {
+                lanes = 0;
+            }
+        }
+        if (!lanes) {
+            // Other policies (or --no-lanes): one statistics-only run per workload
+            sim_job_t job;
+            batch_job(opts, opts->choice, NULL, &job);
+            for (int i = 0; i < count; i++) {
+                sim_run_t run;
+                sim_run_init(&run, opts->horizon);
+                sim_metrics_t metrics;
+                sim_metrics_init(&metrics);
+                run.trace_level = trace_none;
+                run.metrics = &metrics;
+                job.queue = &queues[i];
+                run_policy(&job, NULL, NULL, &run);
+                results[i].status = run.status;
+                results[i].end_time = run.end_time;
+                results[i].finished = run.finished;
+                results[i].total = run.total;
+                sim_metrics_summarize(&metrics, run.end_time, &results[i].summary);
+                sim_metrics_free(&metrics);
+            }
+        }
+
+        if (opts->results_path) {
+            FILE* out = (strcmp(opts->results_path, "-") == 0) ? stdout : fopen(opts->results_path, "wb");
+            if (!out || !sweep_results_write(out, results, count)) {
+                fprintf(stderr, "Error: failed to write %s\n", opts->results_path);
+                rc = 1;
+            }
+            if (out && out != stdout && fclose(out) != 0) rc = 1;
+        } else {
+            print_sweep(paths, results, count);
+        }
+    }
+
+    for (int i = 0; i < loaded; i++) workload_free(&queues[i]);
+    free_paths(paths, count);
+    free(queues);
+    free(results);
+    return rc;
+}
+
+// Split a sweep into shards (workload i goes to shard i % shards), run one worker
+// process per shard and merge their result files in list order
+static int run_fanout(const batch_options_t* opts, const char* argv0) {
+    int count = 0;
+    char** paths = load_sweep_list(opts->sweep_path, &count);
+    if (!paths) return 1;
+    int shards = (opts->workers > 0) ? opts->workers : sweep_online_cpus();
+    if (shards > count) shards = count;
+    if (shards == 0) {
+        free_paths(paths, count);
+        return 0;
+    }
+
+    char dir[512];
+    if (!sweep_temp_dir(dir, sizeof(dir))) {
+        fprintf(stderr, "Error: cannot create a directory for the shard files\n");
+        free_paths(paths, count);
+        return 1;
+    }
+
+    // Worker command line: the same run, reading its list on stdin, results on stdout
+    char self[1024], algo[16], quantum[16], seed[32], horizon[32];
+    char aging[16], mlfq_quantum[16], mlfq_boost[32];
+    sweep_self_path(self, sizeof(self), argv0);
+    snprintf(algo, sizeof(algo), "%d", opts->choice);
+    snprintf(quantum, sizeof(quantum), "%d", opts->quantum);
+    snprintf(seed, sizeof(seed), "%llu", (unsigned long long)opts->seed);
+    snprintf(horizon, sizeof(horizon), "%lld", (long long)opts->horizon);
+    snprintf(aging, sizeof(aging), "%d", opts->aging_threshold);
+    snprintf(mlfq_quantum, sizeof(mlfq_quantum), "%d", opts->mlfq_quantum);
+    snprintf(mlfq_boost, sizeof(mlfq_boost), "%lld", (long long)opts->mlfq_boost);
+    char* args[24];
+    int a = 0;
+    args[a++] = self;
+    args[a++] = "--algo";
+    args[a++] = algo;
+    if (opts->quantum > 0) { args[a++] = "--quantum"; args[a++] = quantum; }
+    if (opts->seed != 0) { args[a++] = "--seed"; args[a++] = seed; }
+    if (opts->horizon > 0) { args[a++] = "--horizon"; args[a++] = horizon; }
+    if (opts->aging_threshold > 0) { args[a++] = "--aging-threshold"; args[a++] = aging; }
+    if (opts->mlfq_quantum > 0) { args[a++] = "--mlfq-quantum"; args[a++] = mlfq_quantum; }
+    if (opts->mlfq_boost != 0) { args[a++] = "--mlfq-boost"; args[a++] = mlfq_boost; }
+    if (opts->no_lanes) args[a++] = "--no-lanes";
+    args[a++] = "--sweep";
+    args[a++] = "-";
+    args[a++] = "--results";
+    args[a++] = "-";
+    args[a] = NULL;
+
+    lane_result_t* results = calloc(count, sizeof(lane_result_t));
+    pid_t* pids = calloc(shards, sizeof(pid_t));
+    char (*inputs)[600] = calloc(shards, sizeof(*inputs));
+    char (*outputs)[600] = calloc(shards, sizeof(*outputs));
+    int rc = 0;
+    if (!results || !pids || !inputs || !outputs) {
+        fprintf(stderr, "Error: out of memory\n");
+        rc = 1;
+    }
+
+    fflush(stdout);
+    int started = 0;
+    for (int s = 0; rc == 0 && s < shards; s++) {
+        snprintf(inputs[s], sizeof(inputs[s]), "%s/shard%d.list", dir, s);
+        snprintf(outputs[s], sizeof(outputs[s]), "%s/shard%d.res", dir, s);
+        FILE* list = fopen(inputs[s], "w");
+        if (!list) {
+            fprintf(stderr, "Error: cannot write %s\n", inputs[s]);
+            rc = 1;
+            break;
+        }
+        for (int i = s; i < count; i += shards) fprintf(list, "%s\n", paths[i]);
+        if (fclose(list) != 0) {
+            fprintf(stderr, "Error: cannot write %s\n", inputs[s]);
+            rc = 1;
+            break;
+        }
+        const char* launcher = (opts->launcher_count > 0) ? opts->launchers[s % opts->launcher_count] : NULL;
+        pids[s] = sweep_worker_spawn(args, launcher, inputs[s], outputs[s]);
+        if (pids[s] < 0) {
+            fprintf(stderr, "Error: cannot start worker %d\n", s);
+            rc = 1;
+            break;
+        }
+        started++;
+    }
+
+    // Collect every worker, then merge what they wrote
+    for (int s = 0; s < started; s++) {
+        if (!sweep_worker_wait(pids[s])) {
+            fprintf(stderr, "Error: worker %d failed\n", s);
+            rc = 1;
+        }
+    }
+    for (int s = 0; rc == 0 && s < shards; s++) {
+        FILE* in = fopen(outputs[s], "rb");
+        lane_result_t* part = NULL;
+        int part_count = 0;
+        int expected = (count - s + shards - 1) / shards;
+        if (!in || !sweep_results_read(in, &part, &part_count) || part_count != expected) {
+            fprintf(stderr, "Error: worker %d returned an invalid result file\n", s);
+            rc = 1;
+        } else {
+            for (int j = 0; j < part_count; j++) results[s + j * shards] = part[j];
+        }
+        if (in) fclose(in);
+        free(part);
+    }
+    if (rc == 0) print_sweep(paths, results, count);
+
+    for (int s = 0; s < shards && inputs && outputs; s++) {
+        if (inputs[s][0]) remove(inputs[s]);
+        if (outputs[s][0]) remove(outputs[s]);
+    }
+    remove(dir);
+    free(inputs);
+    free(outputs);
+    free(pids);
+    free(results);
+    free_paths(paths, count);
+    return rc;
+}
+
+// experiment_policy_fn over run_policy(); randomized policies use the workload's seed
+static void experiment_policy(void* ctx, int choice, process_queue* queue, uint64_t seed,
+                              sim_run_t* run) {
+    const batch_options_t* opts = ctx;
+    sim_job_t job;
+    batch_job(opts, choice, queue, &job);
+    job.params.seed = seed;
+    run_policy(&job, NULL, NULL, run);
+}
+
+// Comma-separated policy numbers ("1,2,5")
+static int parse_algos(const char* text, batch_options_t* opts) {
+    opts->algo_count = 0;
+    while (*text) {
+        char* end;
+        long choice = strtol(text, &end, 10);
+        if (end == text || choice < 1 || choice > POLICY_COUNT || opts->algo_count == POLICY_COUNT) return 0;
+        opts->algos[opts->algo_count++] = (int)choice;
+        text = end;
+        if (*text == ',') text++;
+        else if (*text) return 0;
+    }
+    return opts->algo_count > 0;
+}
+
+// Policies of --algos, or every available one; -1 (with a message) when one is missing
+static int selected_policies(const batch_options_t* opts, int* choices) {
+    int count = 0;
+    if (opts->algo_count > 0) {
+        for (int i = 0; i < opts->algo_count; i++) {
+            if (!policy_available(opts->algos[i])) {
+                fprintf(stderr, "Error: policy %d is not available in this build\n", opts->algos[i]);
+                return -1;
+            }
+            choices[count++] = opts->algos[i];
+        }
+    } else {
+        for (int c = 1; c <= POLICY_COUNT; c++) {
+            if (policy_available(c)) choices[count++] = c;
+        }
+    }
+    return count;
+}
+
+// Run random workloads drawn from a spec under several policies and report each
+// metric's mean with a 95% confidence interval
+static int run_experiment(const batch_options_t* opts) {
+    workload_spec_t spec;
+    if (!workload_spec_load(opts->experiment_path, &spec)) return 1;
+
+    int choices[POLICY_COUNT];
+    int count = selected_policies(opts, choices);
+    if (count < 0) return 1;
+
+    int64_t runs = (opts->runs > 0) ? opts->runs : 1000;
+    uint64_t seed = (opts->seed != 0) ? opts->seed : 1;
+    int threads = (opts->threads > 0) ? opts->threads : sweep_online_cpus();
+    experiment_result_t results[POLICY_COUNT];
+    if (!experiment_run(&spec, runs, seed, opts->horizon, threads, choices, count,
+                        experiment_policy, (void*)opts, results)) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    printf("Experiment: %lld workloads from %s, seed %llu (mean +/- 95%% confidence interval)\n\n",
+           (long long)runs, opts->experiment_path, (unsigned long long)seed);
+    printf("%-22s %-20s %-20s %-22s %s\n", "Policy", "Avg waiting", "P99 response",
+           "Throughput /1k ticks", "CPU utilization %");
+    for (int c = 0; c < count; c++) {
+        const stat_acc_t* m = results[c].metrics;
+        char cells[EXPERIMENT_METRICS][32];
+        double scale[EXPERIMENT_METRICS] = {1, 1, 1000, 100};
+        for (int k = 0; k < EXPERIMENT_METRICS; k++) {
+            snprintf(cells[k], sizeof(cells[k]), "%.2f +/- %.2f", m[k].mean * scale[k],
+                     stat_acc_ci95(&m[k]) * scale[k]);
+        }
+        printf("%-22s %-20s %-20s %-22s %s\n", policy_name(choices[c]), cells[metric_waiting],
+               cells[metric_p99_response], cells[metric_throughput], cells[metric_utilization]);
+    }
+    for (int c = 0; c < count; c++) {
+        if (results[c].incomplete > 0) {
+            printf("%s: %lld runs did not complete\n", policy_name(choices[c]),
+                   (long long)results[c].incomplete);
+        }
+    }
+    return 0;
+}
+
+// Run the selected policies concurrently on one workload, without traces; the
+// number of rows, or -1 on error
+static int compare_policies(process_queue* queue, const batch_options_t* opts, compare_row_t* rows) {
+    int choices[POLICY_COUNT];
+    int count = selected_policies(opts, choices);
+    if (count < 0) return -1;
+    uint64_t seed = (opts->seed != 0) ? opts->seed : 1;
+    if (!compare_run(queue, choices, count, opts->horizon, seed, experiment_policy, (void*)opts, rows)) {
+        fprintf(stderr, "Error: out of memory\n");
+        return -1;
+    }
+    for (int i = 0; i < count; i++) rows[i].name = policy_name(rows[i].choice);
+    return count;
+}
+
+static const char* objective_name(tune_objective_t objective) {
+    switch (objective) {
+        case objective_p99_response: return "p99 response time";
+        case objective_switches: return "context switches";
+        default: return "mean waiting time";
+    }
+}
+
+// Search the parameters of Round-Robin, Multi-level + Aging or MLFQ over a set of
+// workloads: the configuration file, every workload of --sweep, or --runs workloads
+// drawn from --experiment. Prints the best candidates and the options that apply them.
+static int run_tune(const batch_options_t* opts, const char* config_file) {
+    tune_target_t target;
+    switch (opts->tune_choice) {
+        case 2: target = tune_round_robin; break;
+        case 5: target = tune_aging; break;
+        case 10: target = tune_mlfq; break;
+        default:
+            fprintf(stderr, "Error: --tune expects 2 (Round-Robin), 5 (Multi-level + Aging) or 10 (MLFQ)\n");
+            return 1;
+    }
+    if (!policy_available(opts->tune_choice)) {
+        fprintf(stderr, "Error: policy %d is not available in this build\n", opts->tune_choice);
+        return 1;
+    }
+    tune_space_t space;
+    tune_space_default(target, &space);
+    if (opts->tune_lo > 0) {
+        space.lo[0] = opts->tune_lo;
+        space.hi[0] = opts->tune_hi;
+    }
+
+    int count = 0;
+    char** paths = NULL;
+    const char* source = config_file;
+    workload_spec_t spec;
+    uint64_t seed = (opts->seed != 0) ? opts->seed : 1;
+    if (opts->sweep_path) {
+        paths = load_sweep_list(opts->sweep_path, &count);
+        if (!paths) return 1;
+        source = opts->sweep_path;
+    } else if (opts->experiment_path) {
+        if (!workload_spec_load(opts->experiment_path, &spec)) return 1;
+        count = (opts->runs > 0) ? (int)opts->runs : 1000;
+        source = opts->experiment_path;
+    } else if (config_file) {
+        count = 1;
+    } else {
+        fprintf(stderr, "Error: --tune needs a configuration file, --sweep or --experiment\n");
+        return 1;
+    }
+
+    process_queue* queues = calloc(count > 0 ? count : 1, sizeof(process_queue));
+    process_queue** workloads = calloc(count > 0 ? count : 1, sizeof(process_queue*));
+    int loaded = 0, rc = 0;
+    if (!queues || !workloads) {
+        fprintf(stderr, "Error: out of memory\n");
+        rc = 1;
+    }
+    for (; rc == 0 && loaded < count; loaded++) {
+        int ok;
+        if (paths) ok = parse_config_file_quiet(paths[loaded], &queues[loaded]) > 0;
+        else if (opts->experiment_path) ok = workload_generate(&spec, experiment_workload_seed(seed, loaded), &queues[loaded]);
+        else ok = parse_config_file_quiet(config_file, &queues[loaded]) > 0;
+        if (!ok) {
+            fprintf(stderr, "Error: failed to load %s\n", paths ? paths[loaded] : source);
+            workload_free(&queues[loaded]);
+            rc = 1;
+        }
+        workloads[loaded] = &queues[loaded];
+    }
+
+    tune_result_t result;
+    int threads = (opts->threads > 0) ? opts->threads : sweep_online_cpus();
+    if (rc == 0 && !tune_run(target, &space, opts->objective, workloads, count, opts->horizon,
+                             threads, &result)) {
+        fprintf(stderr, "Error: out of memory\n");
+        rc = 1;
+    }
+
+    if (rc == 0) {
+        printf("Tuning %s for %s over %d workload%s from %s\n", policy_name(opts->tune_choice),
+               objective_name(opts->objective), count, (count == 1) ? "" : "s", source);
+        for (int d = 0; d < space.dims; d++) {
+            printf("  %s: %d..%d\n", tune_param_name(target, d), space.lo[d], space.hi[d]);
+        }
+        printf("%d candidates evaluated in %d rounds\n\n", result.count, result.rounds);
+
+        printf("%-6s", "Rank");
+        for (int d = 0; d < space.dims; d++) printf("%-16s", tune_param_name(target, d));
+        printf("%-16s%s\n", "Score", "Incomplete runs");
+        for (int i = 0; i < result.count && i < 5; i++) {
+            const tune_candidate_t* c = &result.candidates[i];
+            printf("%-6d", i + 1);
+            for (int d = 0; d < space.dims; d++) printf("%-16d", c->params[d]);
+            printf("%-16.2f%d\n", c->score, c->incomplete);
+        }
+
+        const tune_candidate_t* best = &result.candidates[0];
+        printf("\nBest: --algo %d", opts->tune_choice);
+        switch (target) {
+            case tune_round_robin: printf(" --quantum %d\n", best->params[0]); break;
+            case tune_aging: printf(" --aging-threshold %d\n", best->params[0]); break;
+            case tune_mlfq:
+                printf(" --mlfq-quantum %d --mlfq-boost %d\n", best->params[0], best->params[1]);
+                break;
+        }
+        if (best->incomplete > 0) {
+            printf("Warning: %d runs of the best candidate did not complete\n", best->incomplete);
+        }
+        tune_result_free(&result);
+    }
+
+    for (int i = 0; i < loaded; i++) workload_free(&queues[i]);
+    if (paths) free_paths(paths, count);
+    free(queues);
+    free(workloads);
+    return rc;
+}
+
+// Show a saved trace in the Gantt, results and statistics screens without simulating;
+// with the workload it was recorded from, also the deadline screen
+static int run_replay(const char* path, const char* config_file) {
+    trace_reader_t reader;
+    if (!trace_reader_open(&reader, path)) {
+        fprintf(stderr, "Error: %s is not a readable trace file\n", path);
+        return 1;
+    }
+    trace_source_t trace;
+    if (!trace_source_file(&trace, &reader)) {
+        fprintf(stderr, "Error: %s has too many records to display\n", path);
+        trace_reader_close(&reader);
+        return 1;
+    }
+
+    // Trace files hold no deadlines: match the termination records to the workload
+    // by name. A trace kept at level none has no terminations to match.
+    process_queue workload;
+    workload.head = NULL;
+    workload.tail = NULL;
+    workload.size = 0;
+    if (config_file && reader.run.trace_level != trace_none &&
+        parse_config_file(config_file, &workload) <= 0) {
+        fprintf(stderr, "Error: Failed to load processes from configuration file\n");
+        trace_reader_close(&reader);
+        return 1;
+    }
+    trace_index_t index;
+    if (trace_index_build(&index, &trace) < 0) {
+        fprintf(stderr, "Error: out of memory indexing %s\n", path);
+        workload_free(&workload);
+        trace_reader_close(&reader);
+        return 1;
+    }
+
+    init_ncurses_display();
+    if (reader.run.total > 0 && reader.run.status != sim_completed) {
+        display_run_report(&reader.run);
+    }
+    display_gantt_chart(&trace, &index);
+    display_simulation_results(&trace, &index);
+    display_statistics(&trace, &index);
+    if (workload.size > 0) {
+        deadline_report_t deadlines;
+        if (compute_deadline_report(&workload, &trace, reader.run.end_time, &deadlines) > 0) {
+            display_deadline_report(&deadlines);
+        }
+        free_deadline_report(&deadlines);
+    }
+    cleanup_ncurses_display();
+
+    trace_index_free(&index);
+    workload_free(&workload);
+    trace_reader_close(&reader);
+    return 0;
+}
+
+// Simulation thread of the live animation: keeps the trace for the other views and
+// streams it into the ring
+typedef struct live_worker_t {
+    const sim_job_t* job;
+    event_ring_t* ring;
+    sim_sink_t keep;           // Where the trace is kept (trace file or packed trace)
+    void* keep_ctx;
+    int live;                  // The animation still takes records
+    sim_run_t* run;
+} live_worker_t;
+
+static int live_worker_sink(void* ctx, const process_descriptor_t* record) {
+    live_worker_t* worker = ctx;
+    if (!worker->keep(worker->keep_ctx, record)) return 0;
+    // Once the animation is skipped, the run goes on for the other views only
+    if (worker->live && !event_ring_push(worker->ring, record)) worker->live = 0;
+    return 1;
+}
+
+static void* live_worker_main(void* arg) {
+    live_worker_t* worker = arg;
+    run_policy(worker->job, NULL, NULL, worker->run);
+    event_ring_close(worker->ring);
+    return NULL;
+}
 
 int main(int argc, char** argv) {
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <config_file>\n", argv[0]);
+    const char* config_file = NULL;
+    const char* replay_path = NULL;
+    sim_time_t horizon = 0;
+    batch_options_t batch;
+    memset(&batch, 0, sizeof(batch));
+
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--horizon") == 0 && a + 1 < argc) {
+            horizon = strtoll(argv[++a], NULL, 10);
+            if (horizon < 0) horizon = 0;
+        } else if (strcmp(argv[a], "--algo") == 0 && a + 1 < argc) {
+            batch.choice = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--quantum") == 0 && a + 1 < argc) {
+            batch.quantum = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--seed") == 0 && a + 1 < argc) {
+            batch.seed = strtoull(argv[++a], NULL, 10);
+        } else if (strcmp(argv[a], "--export-chrome") == 0 && a + 1 < argc) {
+            batch.chrome_path = argv[++a];
+        } else if (strcmp(argv[a], "--export-trace") == 0 && a + 1 < argc) {
+            batch.trace_path = argv[++a];
+        } else if (strcmp(argv[a], "--trace") == 0 && a + 1 < argc) {
+            if (!parse_trace_level(argv[++a], &batch.trace_level)) {
+                fprintf(stderr, "Error: --trace expects full, transitions or none\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--sweep") == 0 && a + 1 < argc) {
+            batch.sweep_path = argv[++a];
+        } else if (strcmp(argv[a], "--no-lanes") == 0) {
+            batch.no_lanes = 1;
+        } else if (strcmp(argv[a], "--results") == 0 && a + 1 < argc) {
+            batch.results_path = argv[++a];
+        } else if (strcmp(argv[a], "--workers") == 0 && a + 1 < argc) {
+            batch.fanout = 1;
+            batch.workers = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--launcher") == 0 && a + 1 < argc) {
+            if (batch.launcher_count == SWEEP_MAX_LAUNCHERS) {
+                fprintf(stderr, "Error: at most %d launchers\n", SWEEP_MAX_LAUNCHERS);
+                return 1;
+            }
+            batch.fanout = 1;
+            batch.launchers[batch.launcher_count++] = argv[++a];
+        } else if (strcmp(argv[a], "--experiment") == 0 && a + 1 < argc) {
+            batch.experiment_path = argv[++a];
+        } else if (strcmp(argv[a], "--runs") == 0 && a + 1 < argc) {
+            batch.runs = strtoll(argv[++a], NULL, 10);
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            batch.threads = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--algos") == 0 && a + 1 < argc) {
+            if (!parse_algos(argv[++a], &batch)) {
+                fprintf(stderr, "Error: --algos expects policy numbers such as 1,2,5\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--aging-threshold") == 0 && a + 1 < argc) {
+            batch.aging_threshold = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--mlfq-quantum") == 0 && a + 1 < argc) {
+            batch.mlfq_quantum = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--mlfq-boost") == 0 && a + 1 < argc) {
+            batch.mlfq_boost = strtoll(argv[++a], NULL, 10);
+        } else if (strcmp(argv[a], "--tune") == 0 && a + 1 < argc) {
+            batch.tune_choice = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--objective") == 0 && a + 1 < argc) {
+            const char* name = argv[++a];
+            if (strcmp(name, "waiting") == 0) batch.objective = objective_waiting;
+            else if (strcmp(name, "p99") == 0) batch.objective = objective_p99_response;
+            else if (strcmp(name, "switches") == 0) batch.objective = objective_switches;
+            else {
+                fprintf(stderr, "Error: --objective expects waiting, p99 or switches\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--tune-range") == 0 && a + 1 < argc) {
+            if (sscanf(argv[++a], "%d..%d", &batch.tune_lo, &batch.tune_hi) != 2 ||
+                batch.tune_lo < 1 || batch.tune_hi < batch.tune_lo) {
+                fprintf(stderr, "Error: --tune-range expects LO..HI with 1 <= LO <= HI\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--compare") == 0) {
+            batch.compare = 1;
+        } else if (strcmp(argv[a], "--serve") == 0 && a + 1 < argc) {
+            batch.serve_path = argv[++a];
+        } else if (strcmp(argv[a], "--cache") == 0 && a + 1 < argc) {
+            batch.cache_size = atoi(argv[++a]);
+        } else if (strcmp(argv[a], "--checkpoint") == 0 && a + 1 < argc) {
+            batch.checkpoint_path = argv[++a];
+        } else if (strcmp(argv[a], "--resume") == 0 && a + 1 < argc) {
+            batch.resume_path = argv[++a];
+        } else if (strcmp(argv[a], "--replay") == 0 && a + 1 < argc) {
+            replay_path = argv[++a];
+        } else {
+            config_file = argv[a];
+        }
+    }
+
+    if (replay_path != NULL) {
+        return run_replay(replay_path, config_file);
+    }
+
+    if (batch.serve_path != NULL) {
+        server_options_t server;
+        server.path = batch.serve_path;
+        server.threads = batch.threads;
+        server.cache_size = batch.cache_size;
+        return server_run(&server);
+    }
+
+    if (batch.tune_choice != 0) {
+        batch.horizon = horizon;
+        return run_tune(&batch, config_file);
+    }
+
+    if (batch.experiment_path != NULL) {
+        batch.horizon = horizon;
+        return run_experiment(&batch);
+    }
+
+    if (batch.sweep_path != NULL) {
+        if (batch.choice == 0) {
+            fprintf(stderr, "Error: --sweep needs --algo\n");
+            return 1;
+        }
+        batch.horizon = horizon;
+        if (batch.fanout && !batch.results_path) return run_fanout(&batch, argv[0]);
+        return run_sweep(&batch);
+    }
+
+    if (config_file == NULL) {
+        fprintf(stderr, "Usage: %s [options] <config_file>\n", argv[0]);
+        fprintf(stderr, "       %s --replay <trace_file> [<config_file>]\n", argv[0]);
+        fprintf(stderr, "       %s --algo N --sweep <workload_list>\n", argv[0]);
+        fprintf(stderr, "       %s --experiment <workload_spec> [--runs N] [--algos LIST]\n", argv[0]);
+        fprintf(stderr, "       %s --tune N [--objective O] (<config_file> | --sweep LIST | --experiment SPEC)\n", argv[0]);
+        fprintf(stderr, "       %s --serve <socket> [--threads T] [--cache N]\n", argv[0]);
+        fprintf(stderr, "       %s --algo N --horizon T --checkpoint <file> [--resume <file>] <config_file>\n", argv[0]);
         fprintf(stderr, "\nExample:\n");
         fprintf(stderr, "  %s processes.txt\n\n", argv[0]);
+        fprintf(stderr, "Options:\n");
+        fprintf(stderr, "  --horizon TICKS       Stop every simulation at this time (default: unbounded)\n");
+        fprintf(stderr, "  --algo N              Run policy N (menu number) without the interactive menu\n");
+        fprintf(stderr, "  --compare             Run every policy (or --algos) on the workload and print one table\n");
+        fprintf(stderr, "  --quantum Q           Time quantum for --algo 2, 7 and 8 (default: 2)\n");
+        fprintf(stderr, "  --seed S              Lottery seed for --algo 7 (default: 1)\n");
+        fprintf(stderr, "  --aging-threshold N   Waiting ticks before a promotion for --algo 5 (default: 5)\n");
+        fprintf(stderr, "  --mlfq-quantum Q      Top-level quantum for --algo 10, doubled per level (default: 2)\n");
+        fprintf(stderr, "  --mlfq-boost B        Priority boost period for --algo 10 (default: 50)\n");
+        fprintf(stderr, "  --export-chrome FILE  With --algo: stream the trace as Chrome/Perfetto JSON\n");
+        fprintf(stderr, "  --export-trace FILE   With --algo: save the trace in the binary .trace format\n");
+        fprintf(stderr, "  --trace LEVEL         Records kept by --export-trace: full, transitions or none\n");
+        fprintf(stderr, "  --checkpoint FILE     With --algo 1-5: snapshot the scheduler when it stops at the horizon\n");
+        fprintf(stderr, "  --resume FILE         With --algo 1-5: continue from a snapshot instead of time 0\n");
+        fprintf(stderr, "  --replay FILE         Show a saved .trace file without simulating (with the config\n");
+        fprintf(stderr, "                        file it was recorded from, also its deadline misses)\n");
+        fprintf(stderr, "  --sweep LIST          With --algo: run every workload listed in LIST (one path per line)\n");
+        fprintf(stderr, "  --no-lanes            With --sweep: run workloads one at a time instead of in lanes\n");
+        fprintf(stderr, "  --workers N           With --sweep: shard it across N processes (0 = one per CPU)\n");
+        fprintf(stderr, "  --launcher CMD        Start sweep workers through CMD (e.g. \"ssh host /path/scheduler\");\n");
+        fprintf(stderr, "                        repeat to spread the shards over several machines\n");
+        fprintf(stderr, "  --results FILE        With --sweep: write binary results instead of text (- = stdout)\n");
+        fprintf(stderr, "  --experiment SPEC     Run random workloads drawn from SPEC and report confidence intervals\n");
+        fprintf(stderr, "  --runs N              Workloads per experiment (default: 1000)\n");
+        fprintf(stderr, "  --algos LIST          Policies of an experiment, e.g. 1,2,5 (default: all available)\n");
+        fprintf(stderr, "  --threads T           Experiment, tuning and server threads (default: one per CPU)\n");
+        fprintf(stderr, "  --tune N              Search the parameters of policy 2, 5 or 10\n");
+        fprintf(stderr, "  --objective O         Tuning objective: waiting, p99 or switches (default: waiting)\n");
+        fprintf(stderr, "  --tune-range LO..HI   Range of the quantum or aging threshold (default: 1..64)\n");
+        fprintf(stderr, "  --serve SOCKET        Run as a daemon answering run requests on a Unix socket\n");
+        fprintf(stderr, "  --cache N             Workloads the daemon keeps parsed (default: 256)\n\n");
         fprintf(stderr, "Configuration file format:\n");
         fprintf(stderr, "  # Comments start with #\n");
         fprintf(stderr, "  ProcessName ArrivalTime Priority Operation1:Duration Operation2:Duration ...\n");
@@ -22,11 +971,30 @@ int main(int argc, char** argv) {
     pqueue.tail = NULL;
     pqueue.size = 0;
 
-    if (parse_config_file(argv[1], &pqueue) <= 0) {
+    if (parse_config_file(config_file, &pqueue) <= 0) {
         fprintf(stderr, "Error: Failed to load processes from configuration file\n");
         return 1;
     }
 
+    batch.horizon = horizon;
+    if (batch.compare) {
+        compare_row_t rows[POLICY_COUNT];
+        int count = compare_policies(&pqueue, &batch, rows);
+        if (count >= 0) print_comparison(rows, count);
+        workload_free(&pqueue);
+        return (count >= 0) ? 0 : 1;
+    }
+
+    if (batch.choice != 0) {
+        int rc = run_batch(&pqueue, &batch);
+        while (pqueue.size > 0) {
+            free(pqueue.head->proc.process_name);
+            free(pqueue.head->proc.descriptor_p);
+            remove_head(&pqueue);
+        }
+        return rc;
+    }
+
     // Initialize ncurses
     init_ncurses_display();
 
@@ -41,30 +1009,16 @@ int main(int argc, char** argv) {
             continue;
         }
 
-        // Check if selected algorithm is available
-        available_algorithms_t avail = check_available_algorithms();
-        int algorithm_unavailable = 0;
-        
-        switch (choice) {
-            case 1:
-                if (!avail.fifo_available) algorithm_unavailable = 1;
-                break;
-            case 2:
-                if (!avail.round_robin_available) algorithm_unavailable = 1;
-                break;
-            case 3:
-                if (!avail.priority_available) algorithm_unavailable = 1;
-                break;
-            case 4:
-                if (!avail.multilevel_available) algorithm_unavailable = 1;
-                break;
-            case 5:
-                if (!avail.multilevel_aging_available) algorithm_unavailable = 1;
-                break;
-            default:
-                algorithm_unavailable = 1;
-                break;
+        if (choice == MENU_COMPARE_ALL) {
+            // Parameters come from the command line (defaults otherwise)
+            compare_row_t rows[POLICY_COUNT];
+            int count = compare_policies(&pqueue, &batch, rows);
+            if (count > 0) display_comparison(rows, count);
+            continue;
         }
+
+        // Check if selected algorithm is available
+        int algorithm_unavailable = !policy_available(choice);
         
         if (algorithm_unavailable) {
             clear();
@@ -77,8 +1031,8 @@ int main(int argc, char** argv) {
             continue;
         }
 
-        process_descriptor_t* descriptor = NULL;
-        int desc_size = 0;
+        sim_run_t run;
+        sim_run_init(&run, horizon);
 
         // Create a copy of the process queue for simulation
         process_queue sim_queue;
@@ -87,58 +1041,125 @@ int main(int argc, char** argv) {
         sim_queue.size = 0;
 
         for (node_t* cur = pqueue.head; cur != NULL; cur = cur->next) {
-            process_t proc_copy;
+            process_t proc_copy = cur->proc;
             proc_copy.process_name = malloc(strlen(cur->proc.process_name) + 1);
             strcpy(proc_copy.process_name, cur->proc.process_name);
-            proc_copy.arrival_time_p = cur->proc.arrival_time_p;
-            proc_copy.begining_date = cur->proc.begining_date;
-            proc_copy.priority_p = cur->proc.priority_p;
-            proc_copy.operations_count = cur->proc.operations_count;
             proc_copy.descriptor_p = malloc(cur->proc.operations_count * sizeof(operation_t));
             memcpy(proc_copy.descriptor_p, cur->proc.descriptor_p, 
                    cur->proc.operations_count * sizeof(operation_t));
             add_tail(&sim_queue, proc_copy);
         }
 
+        // Collect the policy parameters before anything runs
+        sim_job_t job;
+        memset(&job, 0, sizeof(job));
+        job.choice = choice;
+        job.queue = &sim_queue;
         switch (choice) {
-            case 1:
-                fifo_sched(&sim_queue, &descriptor, &desc_size);
+            case 2:
+            case 8:
+                job.params.quantum = get_quantum();
                 break;
-            case 2: {
-                int quantum = get_quantum();
-                round_robin_sched(&sim_queue, &descriptor, &desc_size, quantum);
+            case 6:
+                job.params.cfs = get_cfs_params();
                 break;
-            }
-            case 3:
-                priority_sched(&sim_queue, &descriptor, &desc_size);
+            case 7:
+                job.params.quantum = get_quantum();
+                job.params.seed = get_seed();
                 break;
-            case 4:
-                multilevel_rr_sched(&sim_queue, &descriptor, &desc_size);
+            case 10:
+                job.params.mlfq = get_mlfq_params();
                 break;
-            case 5:
-                multilevel_rr_aging_sched(&sim_queue, &descriptor, &desc_size);
-                break;
-            default:
-                while (sim_queue.size > 0) {
-                    free(sim_queue.head->proc.process_name);
-                    free(sim_queue.head->proc.descriptor_p);
-                    remove_head(&sim_queue);
-                }
-                continue;
-        }
-
-        if (descriptor != NULL) {
-            // Show real-time tick-by-tick animation (200ms per tick)
-            display_realtime_gantt(descriptor, desc_size, 200);
-            
+        }
+
+        // Real-time animation (200ms per tick) starts right away: a worker thread
+        // simulates into a bounded ring and blocks whenever the animation lags behind.
+        // The other views need the whole trace, which the same run streams to a
+        // temporary trace file, so the run holds only the ring and the block being
+        // encoded. Without a temporary file the trace is kept as packed 8-byte records.
+        char trace_path[4096];
+        trace_writer_t writer;
+        int streamed = trace_writer_open_temp(&writer, trace_path, sizeof(trace_path));
+        packed_trace_t packed;
+        packed_trace_init(&packed);
+        sim_sink_t keep = streamed ? trace_writer_sink : packed_trace_sink;
+        void* keep_ctx = streamed ? (void*)&writer : (void*)&packed;
+        event_ring_t ring;
+        int simulated = 0;
+        if (event_ring_init(&ring, LIVE_RING_CAPACITY)) {
+            live_worker_t worker;
+            worker.job = &job;
+            worker.ring = &ring;
+            worker.keep = keep;
+            worker.keep_ctx = keep_ctx;
+            worker.live = 1;
+            worker.run = &run;
+            run.sink = live_worker_sink;
+            run.sink_ctx = &worker;
+
+            pthread_t thread;
+            if (pthread_create(&thread, NULL, live_worker_main, &worker) == 0) {
+                display_realtime_gantt(&ring, 200);
+                pthread_join(thread, NULL);
+                simulated = 1;
+            }
+            event_ring_free(&ring);
+        }
+        if (!simulated) {
+            run.sink = keep;
+            run.sink_ctx = keep_ctx;
+            run_policy(&job, NULL, NULL, &run);
+        }
+
+        // Tell the user up front when the run did not complete
+        if (run.status != sim_completed) {
+            display_run_report(&run);
+        }
+
+        // The views read the trace file block by block, as a replay does; the file
+        // is removed once it is mapped
+        trace_source_t trace;
+        trace_reader_t reader;
+        int readable = 0;
+        if (streamed) {
+            if (trace_writer_close(&writer, &run) && trace_reader_open(&reader, trace_path)) {
+                readable = trace_source_file(&trace, &reader);
+                if (!readable) trace_reader_close(&reader);
+            }
+            remove(trace_path);
+        } else {
+            trace_source_packed(&trace, &packed);
+            readable = 1;
+        }
+
+        // One index of the trace serves the chart, results and statistics screens
+        trace_index_t index;
+        if (readable && trace.size > 0 && trace_index_build(&index, &trace) < 0) {
+            clear();
+            attron(COLOR_PAIR(3) | A_BOLD);
+            mvprintw(10, 10, "Not enough memory to index the trace.");
+            mvprintw(11, 10, "Press any key to continue...");
+            attroff(COLOR_PAIR(3) | A_BOLD);
+            refresh();
+            getch();
+        } else if (readable && trace.size > 0) {
             // Show scrollable Gantt chart
-            display_gantt_chart(descriptor, desc_size);
+            display_gantt_chart(&trace, &index);
             
             // Show simulation results and statistics
-            display_simulation_results(descriptor, desc_size);
-            display_statistics(descriptor, desc_size);
-            free(descriptor);
+            display_simulation_results(&trace, &index);
+            display_statistics(&trace, &index);
+
+            // Deadline misses for workloads that declare deadlines
+            deadline_report_t deadlines;
+            if (compute_deadline_report(&sim_queue, &trace, run.end_time, &deadlines) > 0) {
+                display_deadline_report(&deadlines);
+            }
+            free_deadline_report(&deadlines);
+            trace_index_free(&index);
         }
+        if (streamed && readable) trace_reader_close(&reader);
+        packed_trace_free(&packed);
 
         // Clean up simulation queue
         while (sim_queue.size > 0) {